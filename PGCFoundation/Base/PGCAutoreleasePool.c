@@ -28,23 +28,60 @@
 #include <PGCFoundation/PGCObject.h>
 
 #include <pthread.h>
+#include <time.h>
 
 #pragma mark Private Global Variables
 
 /*!
- @abstract Indicates whether the key for storing thread-specific autorelease pool stacks has been initialized.
- @discussion This variable is set to true the first time PGCAutoreleasePoolCreate is called, provided that the thread key
-     could be successfully created. It is never set to false.
+ @abstract Ensures that PGCAutoreleasePoolInitializeThreadKey is only called once.
+ */
+static pthread_once_t PGCAutoreleasePoolThreadKeyOnce = PTHREAD_ONCE_INIT;
+
+/*!
+ @abstract Indicates whether the key for cleaning up thread-specific autorelease pool stacks was successfully created.
+ @discussion This variable is set by PGCAutoreleasePoolInitializeThreadKey and never modified afterwards.
  */
 static bool PGCAutoreleasePoolThreadKeyInitialized = false;
 
 /*!
- @abstract The thread key used to store thread-specific autorelease stacks. 
- @discussion This variable is initialized the first time PGCAutoreleasePoolCreate is called, provided that the thread key
-     could be successfully created. It is never destroyed.
+ @abstract The thread key used to clean up autorelease pool stacks when their threads terminate.
+ @discussion The key's value is only used to ensure that PGCAutoreleasePoolThreadWasDestroyed is invoked for threads
+     that have created an autorelease pool. The stack itself is stored in PGCAutoreleasePoolCurrentPool. The key is
+     never destroyed.
  */
 static pthread_key_t PGCAutoreleasePoolThreadKey;
 
+/*!
+ @abstract The top of the calling thread's autorelease pool stack; NULL if the thread has no pools.
+ @discussion Storing the stack in thread-local storage means adding an object to the current pool requires no
+     function call to look the pool up.
+ */
+static __thread PGCAutoreleasePool *PGCAutoreleasePoolCurrentPool = NULL;
+
+/*!
+ @abstract The object most recently autoreleased on the calling thread, if it has not yet been added to the current pool.
+ @discussion An autoreleased object waits here until the next autorelease, pool creation, or pool destruction adds it to
+     the top of the pool stack. Until then, PGCAutoreleasePoolClaimObject can take it back without touching the pool.
+ */
+static __thread PGCType PGCAutoreleasePoolPendingObject = NULL;
+
+/*!
+ @abstract The number of objects currently held by all of the calling thread's autorelease pools.
+ */
+static __thread uint64_t PGCAutoreleasePoolThreadObjectCount = 0;
+
+/*!
+ @abstract The calling thread's autorelease pool statistics.
+ */
+static __thread PGCAutoreleasePoolStatistics PGCAutoreleasePoolThreadStatistics;
+
+/*!
+ @abstract Whether the calling thread records how long its pools take to drain.
+ @discussion Timing a drain reads the clock twice, which is a noticeable part of the cost of draining a small pool, so
+     it is off by default.
+ */
+static __thread bool PGCAutoreleasePoolThreadTimesDrains = false;
+
 
 #pragma mark Private Types and Data Structures
 
@@ -69,6 +106,8 @@ struct _PGCAutoreleasePoolEntry {
      if the pool contains no objects.
  @field entriesHead A pointer to the last autorelease pool entry in the pool’s objects to eventually release; NULL
      if the pool contains no objects.
+ @field objectCount The number of entries in the pool.
+ @field statistics The pool's usage statistics.
  @discussion The previous and next pointers are only modified by PGCAutoreleasePoolCreate and PGCAutoreleasePoolDestroy.
      The entriesHead and entriesTail pointers are modified by PGCAutoreleasePoolAddObject. 
  */
@@ -77,42 +116,97 @@ struct _PGCAutoreleasePool {
     PGCAutoreleasePool *next;
     PGCAutoreleasePoolEntry *entriesHead;
     PGCAutoreleasePoolEntry *entriesTail;
+    uint64_t objectCount;
+    PGCAutoreleasePoolStatistics statistics;
 };
 
 
 #pragma mark Private Function Interfaces
 
+/*!
+ @abstract Creates the thread key used to clean up autorelease pool stacks.
+ @discussion This function is called exactly once via pthread_once.
+ */
+void PGCAutoreleasePoolInitializeThreadKey(void);
+
 /*!
  @abstract Cleans up the autorelease pool stack when a thread terminates.
- @param threadVariable The terminating thread’s value for PGCAutoreleasePoolThreadKey, which is of type PGCAutoreleasePool.
- @discussion If threadVariable is non-NULL, this function simply iterates over each of the pools in the specified stack
-     and essentially destroys them in the order they were placed on the autorelease pool stack.
+ @param threadVariable The terminating thread’s value for PGCAutoreleasePoolThreadKey. It is not used.
+ @discussion This function destroys the bottom-most pool on the terminating thread's stack, which in turn destroys
+     every pool above it.
  */
 void PGCAutoreleasePoolThreadWasDestroyed(void *threadVariable);
 
+/*!
+ @abstract Appends the specified object to the specified pool's entries.
+ @param pool The pool to add the object to. May not be NULL.
+ @param instance The object to add. May not be NULL.
+ */
+void PGCAutoreleasePoolAppendObject(PGCAutoreleasePool *pool, PGCType instance);
+
+/*!
+ @abstract Moves the calling thread's pending object, if any, into the top-most pool.
+ */
+void PGCAutoreleasePoolFlushPendingObject(void);
+
+/*!
+ @abstract Releases each of the objects in the specified pool and, if the calling thread times drains, records how long it took.
+ @param pool The pool to empty. Must be at the top of the calling thread's stack of pools.
+ */
+void PGCAutoreleasePoolReleaseObjects(PGCAutoreleasePool *pool);
+
+/*!
+ @abstract Releases each of the objects in the specified pool, removes it from the calling thread's stack, and frees it.
+ @param pool The pool to pop. Must be at the top of the calling thread's stack of pools.
+ */
+void PGCAutoreleasePoolPop(PGCAutoreleasePool *pool);
+
+/*!
+ @abstract Destroys each of the pools above the specified pool, starting at the top of the stack.
+ @param pool The pool whose successors should be destroyed.
+ @discussion Pools are destroyed in a loop rather than recursively so that deep pool stacks can't overflow the call stack.
+ */
+void PGCAutoreleasePoolDestroyPoolsAbovePool(PGCAutoreleasePool *pool);
+
+/*!
+ @abstract Returns the current time of a monotonic clock in nanoseconds.
+ */
+uint64_t PGCAutoreleasePoolGetNanoseconds(void);
+
 
 // FIXME: Add logging
 #pragma mark -
 
+void PGCAutoreleasePoolInitializeThreadKey(void)
+{
+    PGCAutoreleasePoolThreadKeyInitialized = pthread_key_create(&PGCAutoreleasePoolThreadKey, PGCAutoreleasePoolThreadWasDestroyed) == 0;
+}
+
+
 PGCAutoreleasePool *PGCAutoreleasePoolCreate(void)
 {
-    // Attempt to create the thread-specific key if it's not already set
-    if (!PGCAutoreleasePoolThreadKeyInitialized && pthread_key_create(&PGCAutoreleasePoolThreadKey, PGCAutoreleasePoolThreadWasDestroyed) != 0) return NULL;
-    PGCAutoreleasePoolThreadKeyInitialized = true;
+    // Create the thread key if no other thread has done so yet
+    pthread_once(&PGCAutoreleasePoolThreadKeyOnce, PGCAutoreleasePoolInitializeThreadKey);
+    if (!PGCAutoreleasePoolThreadKeyInitialized) return NULL;
     
     // Allocate a new pool
     PGCAutoreleasePool *pool = calloc(1, sizeof(PGCAutoreleasePool));
     if (!pool) return NULL;
     
-    // Put the new pool at the top of the stack
-    PGCAutoreleasePool *currentThreadPool = pthread_getspecific(PGCAutoreleasePoolThreadKey);
+    // The pending object belongs to the pool that was on top when it was autoreleased
+    PGCAutoreleasePoolFlushPendingObject();
+    
+    // Put the new pool at the top of the stack. If this is the thread's first pool, give the thread key a non-NULL
+    // value so that the stack gets cleaned up when the thread terminates
+    PGCAutoreleasePool *currentThreadPool = PGCAutoreleasePoolCurrentPool;
     if (currentThreadPool) {
         pool->next = currentThreadPool;
         currentThreadPool->previous = pool;
+    } else if (!pthread_getspecific(PGCAutoreleasePoolThreadKey)) {
+        pthread_setspecific(PGCAutoreleasePoolThreadKey, pool);
     }
     
-    // Set our thread-specific pool to point to this one
-    pthread_setspecific(PGCAutoreleasePoolThreadKey, pool);
+    PGCAutoreleasePoolCurrentPool = pool;
     return pool;
 }
 
@@ -120,15 +214,89 @@ PGCAutoreleasePool *PGCAutoreleasePoolCreate(void)
 void PGCAutoreleasePoolAddObject(PGCType instance)
 {
     // If we haven't set up a pool or the instance was NULL, return
-    if (!PGCAutoreleasePoolThreadKeyInitialized || !instance) return;
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCurrentPool;
+    if (!pool || !instance) return;
+    
+    // Hold on to instance in case the caller claims it, and add the previously pending object to the pool
+    PGCType pendingObject = PGCAutoreleasePoolPendingObject;
+    PGCAutoreleasePoolPendingObject = instance;
+    if (pendingObject) PGCAutoreleasePoolAppendObject(pool, pendingObject);
+}
+
+
+bool PGCAutoreleasePoolClaimObject(PGCType instance)
+{
+    if (!instance || PGCAutoreleasePoolPendingObject != instance) return false;
+    PGCAutoreleasePoolPendingObject = NULL;
+    return true;
+}
+
+
+void PGCAutoreleasePoolDestroy(PGCAutoreleasePool *pool)
+{
+    // If the specified pool is NULL, return
+    if (!pool) return;
+    
+    PGCAutoreleasePoolDestroyPoolsAbovePool(pool);
+    PGCAutoreleasePoolPop(pool);
+}
+
 
-    // Get the thread-specific pool
-    PGCAutoreleasePool *pool = pthread_getspecific(PGCAutoreleasePoolThreadKey);
+void PGCAutoreleasePoolDrain(PGCAutoreleasePool *pool)
+{
     if (!pool) return;
     
+    PGCAutoreleasePoolDestroyPoolsAbovePool(pool);
+    PGCAutoreleasePoolReleaseObjects(pool);
+}
+
+
+PGCAutoreleasePoolStatistics PGCAutoreleasePoolGetStatistics(PGCAutoreleasePool *pool)
+{
+    if (!pool) return (PGCAutoreleasePoolStatistics){ 0, 0, 0, 0 };
+    
+    // Count the pending object if it belongs to this pool
+    if (!pool->previous) PGCAutoreleasePoolFlushPendingObject();
+    return pool->statistics;
+}
+
+
+PGCAutoreleasePoolStatistics PGCAutoreleasePoolGetThreadStatistics(void)
+{
+    PGCAutoreleasePoolFlushPendingObject();
+    return PGCAutoreleasePoolThreadStatistics;
+}
+
+
+bool PGCAutoreleasePoolGetTimesDrains(void)
+{
+    return PGCAutoreleasePoolThreadTimesDrains;
+}
+
+
+void PGCAutoreleasePoolSetTimesDrains(bool timesDrains)
+{
+    PGCAutoreleasePoolThreadTimesDrains = timesDrains;
+}
+
+
+void PGCAutoreleasePoolThreadWasDestroyed(void *threadVariable)
+{
+    // Find the bottom of the stack and destroy it, which destroys all the pools above it. Since the stack no longer
+    // lives in the thread key, this doesn't need to call pthread_setspecific during the key's destructor
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCurrentPool;
+    if (!pool) return;
+    while (pool->next) pool = pool->next;
+    PGCAutoreleasePoolDestroy(pool);
+}
+
+
+void PGCAutoreleasePoolAppendObject(PGCAutoreleasePool *pool, PGCType instance)
+{
     // Allocate a new entry and set its object to instance
-    PGCAutoreleasePoolEntry *entry = calloc(1, sizeof(PGCAutoreleasePoolEntry));
+    PGCAutoreleasePoolEntry *entry = malloc(sizeof(PGCAutoreleasePoolEntry));
     if (!entry) return;
+    entry->next = NULL;
     entry->object = instance;
     
     // Add our object to the pool's entry list
@@ -142,54 +310,93 @@ void PGCAutoreleasePoolAddObject(PGCType instance)
     
     // Make our new entry the end of the entry list
     pool->entriesTail = entry;
+    
+    // Update the pool's and thread's statistics
+    pool->statistics.autoreleasedObjectCount++;
+    if (++pool->objectCount > pool->statistics.peakObjectCount) pool->statistics.peakObjectCount = pool->objectCount;
+    
+    PGCAutoreleasePoolThreadStatistics.autoreleasedObjectCount++;
+    if (++PGCAutoreleasePoolThreadObjectCount > PGCAutoreleasePoolThreadStatistics.peakObjectCount) {
+        PGCAutoreleasePoolThreadStatistics.peakObjectCount = PGCAutoreleasePoolThreadObjectCount;
+    }
 }
 
 
-void PGCAutoreleasePoolDestroy(PGCAutoreleasePool *pool)
+void PGCAutoreleasePoolFlushPendingObject(void)
 {
-    // If we haven't set up a pool or the specified pool is NULL, return
-    if (!PGCAutoreleasePoolThreadKeyInitialized || !pool) return;
+    PGCType pendingObject = PGCAutoreleasePoolPendingObject;
+    if (!pendingObject) return;
     
-    // As long we're not the top of the pool stack, recursively destroy all the pools above us
-    if (pool->previous) PGCAutoreleasePoolDestroy(pool->previous);
+    PGCAutoreleasePoolPendingObject = NULL;
+    if (PGCAutoreleasePoolCurrentPool) PGCAutoreleasePoolAppendObject(PGCAutoreleasePoolCurrentPool, pendingObject);
+}
 
-    // Release each entry's object 
-    PGCAutoreleasePoolEntry *entry = pool->entriesHead;
-    while (entry) {
-        PGCRelease(entry->object);
-        PGCAutoreleasePoolEntry *nextEntry = entry->next;
-        free(entry);
-        entry = nextEntry;
+
+void PGCAutoreleasePoolReleaseObjects(PGCAutoreleasePool *pool)
+{
+    uint64_t start = PGCAutoreleasePoolThreadTimesDrains ? PGCAutoreleasePoolGetNanoseconds() : 0;
+    
+    // Release each entry's object. Releasing an object may autorelease others, so the pending object is moved into our
+    // pool before each entry is removed. Deallocation is deferred until every entry has been released, so that the
+    // thread's deallocation time slice applies to the pool as a whole. The deferred deallocations may autorelease more
+    // objects into our pool, so keep going until it stays empty.
+    PGCAutoreleasePoolFlushPendingObject();
+    while (pool->entriesHead) {
+        PGCObjectBeginDeferringDeallocation();
+        PGCAutoreleasePoolEntry *entry = NULL;
+        while ((entry = pool->entriesHead)) {
+            pool->entriesHead = entry->next;
+            if (!pool->entriesHead) pool->entriesTail = NULL;
+            pool->objectCount--;
+            PGCAutoreleasePoolThreadObjectCount--;
+            
+            PGCType object = entry->object;
+            free(entry);
+            PGCRelease(object);
+            PGCAutoreleasePoolFlushPendingObject();
+        }
+        PGCObjectEndDeferringDeallocation();
+        PGCAutoreleasePoolFlushPendingObject();
+    }
+    
+    if (PGCAutoreleasePoolThreadTimesDrains) {
+        uint64_t elapsed = PGCAutoreleasePoolGetNanoseconds() - start;
+        pool->statistics.drainNanoseconds += elapsed;
+        PGCAutoreleasePoolThreadStatistics.drainNanoseconds += elapsed;
     }
     
+    pool->statistics.drainCount++;
+    PGCAutoreleasePoolThreadStatistics.drainCount++;
+}
+
+
+void PGCAutoreleasePoolPop(PGCAutoreleasePool *pool)
+{
+    PGCAutoreleasePoolReleaseObjects(pool);
+    
     // Pop our pool off the stack and free up our memory
     if (pool->next) pool->next->previous = NULL;
-    pthread_setspecific(PGCAutoreleasePoolThreadKey, pool->next);
+    PGCAutoreleasePoolCurrentPool = pool->next;
     free(pool);
 }
 
 
-void PGCAutoreleasePoolThreadWasDestroyed(void *threadVariable)
+void PGCAutoreleasePoolDestroyPoolsAbovePool(PGCAutoreleasePool *pool)
 {
-    PGCAutoreleasePool *pool = threadVariable;
-    while (pool) {
-        PGCAutoreleasePool *nextPool = pool->next;
-
-        // Below is effectively most of the body of PGCAutoreleasePoolDestroy without the call to pthread_setspecific, 
-        // as calling pthread_setspecific in the middle of a thread-specific destructor “may result in lost storage or
-        // infinite loops,” neither of which is desirable.
-        
-        // Release each entry's object 
-        PGCAutoreleasePoolEntry *entry = pool->entriesHead;
-        while (entry) {
-            PGCRelease(entry->object);
-            PGCAutoreleasePoolEntry *nextEntry = entry->next;
-            free(entry);
-            entry = nextEntry;
-        }
-        
-        // Free the pool itself
-        free(pool);
-        pool = nextPool;
+    PGCAutoreleasePool *topPool = pool;
+    while (topPool->previous) topPool = topPool->previous;
+    
+    while (topPool != pool) {
+        PGCAutoreleasePool *nextPool = topPool->next;
+        PGCAutoreleasePoolPop(topPool);
+        topPool = nextPool;
     }
-}
\ No newline at end of file
+}
+
+
+uint64_t PGCAutoreleasePoolGetNanoseconds(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000 + time.tv_nsec;
+}
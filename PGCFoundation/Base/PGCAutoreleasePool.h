@@ -72,6 +72,26 @@
  */
 typedef struct _PGCAutoreleasePool PGCAutoreleasePool;
 
+/*!
+ @abstract Usage statistics for an autorelease pool or for all of a thread’s autorelease pools.
+ @field autoreleasedObjectCount The number of objects that have been added to the pool. Objects claimed with
+     @link PGCRetainAutoreleasedReturnValue @/link are not counted.
+ @field peakObjectCount The largest number of objects the pool has held at once. For a thread, this is the largest number
+     held by all of the thread’s pools at once.
+ @field drainCount The number of times the pool has been emptied, either by @link PGCAutoreleasePoolDrain @/link or by being
+     destroyed. Since a destroyed pool’s statistics can no longer be read, a pool’s count only reflects its drains, while a
+     thread’s count also includes every pool it has destroyed.
+ @field drainNanoseconds The total time spent releasing objects while emptying the pool. Only drains made while
+     @link PGCAutoreleasePoolSetTimesDrains @/link is enabled are timed.
+ @discussion These statistics are intended to help decide where pools should be created and drained in long-running loops.
+ */
+typedef struct _PGCAutoreleasePoolStatistics {
+    uint64_t autoreleasedObjectCount;
+    uint64_t peakObjectCount;
+    uint64_t drainCount;
+    uint64_t drainNanoseconds;
+} PGCAutoreleasePoolStatistics;
+
 /*!
  @abstract Creates a new autorelease pool and adds it to the calling thread’s stack of pools.
  @result The pool that was created, or NULL if creation failed.
@@ -88,6 +108,15 @@ PGCAutoreleasePool *PGCAutoreleasePoolCreate(void);
  */
 void PGCAutoreleasePoolAddObject(PGCType instance);
 
+/*!
+ @abstract Takes back the calling thread’s most recent autorelease of the specified object, if nothing has been autoreleased since.
+ @param instance The object to claim.
+ @result Whether the object was claimed. If true, the object will not be released when its pool is destroyed, and the caller
+     assumes responsibility for releasing it.
+ @discussion This is the pool half of @link PGCRetainAutoreleasedReturnValue @/link, which should generally be used instead.
+ */
+bool PGCAutoreleasePoolClaimObject(PGCType instance);
+
 /*!
  @abstract Releases each of the objects in the specified pool and removes it from the calling thread’s stack of pools.
  @param pool The pool to destroy.
@@ -96,4 +125,39 @@ void PGCAutoreleasePoolAddObject(PGCType instance);
  */
 void PGCAutoreleasePoolDestroy(PGCAutoreleasePool *pool);
 
+/*!
+ @abstract Releases each of the objects in the specified pool, but leaves it on the calling thread’s stack of pools.
+ @param pool The pool to drain.
+ @discussion As with @link PGCAutoreleasePoolDestroy @/link, any pools above the specified pool are destroyed first. Draining
+     a pool on each iteration of a loop is cheaper than creating and destroying a new pool on each iteration.
+ */
+void PGCAutoreleasePoolDrain(PGCAutoreleasePool *pool);
+
+/*!
+ @abstract Returns the usage statistics for the specified pool.
+ @param pool The pool whose statistics should be returned.
+ @result The pool’s statistics; all fields are 0 if pool is NULL.
+ */
+PGCAutoreleasePoolStatistics PGCAutoreleasePoolGetStatistics(PGCAutoreleasePool *pool);
+
+/*!
+ @abstract Returns the usage statistics for all the autorelease pools the calling thread has created.
+ @result The calling thread’s statistics, including those of pools that have since been destroyed.
+ */
+PGCAutoreleasePoolStatistics PGCAutoreleasePoolGetThreadStatistics(void);
+
+/*!
+ @abstract Returns whether the calling thread records how long its pools take to drain.
+ @result Whether drains on the calling thread are timed.
+ */
+bool PGCAutoreleasePoolGetTimesDrains(void);
+
+/*!
+ @abstract Sets whether the calling thread records how long its pools take to drain.
+ @param timesDrains Whether drains on the calling thread should be timed. The default is false.
+ @discussion Timing a drain reads the clock before and after releasing the pool’s objects. While timing is off, the
+     drainNanoseconds statistic is left unchanged, but every other statistic is still kept.
+ */
+void PGCAutoreleasePoolSetTimesDrains(bool timesDrains);
+
 #endif
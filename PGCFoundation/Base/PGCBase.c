@@ -45,6 +45,40 @@ PGCRange PGCMakeRange(uint64_t location, uint64_t length)
     return range;
 }
 
+
+#pragma mark Hash functions
+
+uint64_t PGCHashMix(uint64_t hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+
+uint64_t PGCHashBytes(const void *bytes, uint64_t length)
+{
+    const uint8_t *byteIterator = bytes;
+    uint64_t hash = 14695981039346656037ULL;
+    for (uint64_t i = 0; i < length; i++) {
+        hash ^= byteIterator[i];
+        hash *= 1099511628211ULL;
+    }
+    
+    return PGCHashMix(hash);
+}
+
+
+uint64_t PGCHashCombine(uint64_t seed, uint64_t hash)
+{
+    // Multiplying the seed by a large odd constant before mixing in the new hash makes the result depend on the order in which
+    // hashes are combined
+    return (seed * 0x9e3779b97f4a7c15ULL) ^ PGCHashMix(hash);
+}
+
 #pragma mark Polymorphic Functions
 
 PGCType PGCCopy(PGCType instance)
@@ -109,6 +143,12 @@ PGCType PGCAutorelease(PGCType instance)
 }
 
 
+PGCType PGCRetainAutoreleasedReturnValue(PGCType instance)
+{
+    return PGCAutoreleasePoolClaimObject(instance) ? instance : PGCRetain(instance);
+}
+
+
 #pragma mark Polymorphic Superclass Functions
 
 PGCType PGCSuperclassCopy(PGCType instance)
@@ -60,6 +60,14 @@ typedef void *PGCType;
  */
 typedef struct _PGCString PGCString;
 
+/*!
+ @abstract The types for the PGCArchiver and PGCUnarchiver classes.
+ @discussion Except when subclassing, users should always use pointers to PGCArchivers and PGCUnarchivers. These types are defined 
+     here instead of in @link PGCArchiver.h @/link because they are needed for Encode and Decode functions.
+ */
+typedef struct _PGCArchiver PGCArchiver;
+typedef struct _PGCUnarchiver PGCUnarchiver;
+
 /*!
  @abstract A special value to denote that some object or value could not be found. 
  @discussion PGCNotFound is typically returned by a function, e.g., @link PGCArrayGetIndexOfObject @/link, when a search failed to find
@@ -135,12 +143,65 @@ typedef void PGCReleaseFunction(PGCType instance);
  */
 typedef PGCType PGCRetainFunction(PGCType instance);
 
+/*!
+ @abstract A pointer to an Encode class function.
+ @param instance The object to encode.
+ @param archiver The archiver to which the object’s contents should be written.
+ @result Whether the object was encoded; returns false if instance is NULL or any of its contents could not be encoded.
+ @discussion See @link PGCClassFunctions @/link for more info on class functions.
+ */
+typedef bool PGCEncodeFunction(PGCType instance, PGCArchiver *archiver);
+
+/*!
+ @abstract A pointer to a Decode class function.
+ @param class The class of the object being decoded, which may be a subclass of the class that implements the function.
+ @param unarchiver The unarchiver from which the object’s contents should be read.
+ @result A newly decoded instance of class with a retain count of 1; returns NULL if the object could not be decoded.
+ @discussion See @link PGCClassFunctions @/link for more info on class functions.
+ */
+struct _PGCClass;
+typedef PGCType PGCDecodeFunction(struct _PGCClass *class, PGCUnarchiver *unarchiver);
+
 
 #pragma mark Range functions
 
 extern PGCRange PGCMakeRange(uint64_t location, uint64_t length);
 
 
+#pragma mark Hash functions
+
+/*!
+ @abstract Scrambles the bits of the specified hash value.
+ @param hash The hash value to scramble.
+ @result A well-distributed hash value derived from the specified one.
+ @discussion Many Hash functions, e.g., those of PGCInteger and PGCCharacter, return values with very little entropy in their
+     high-order bits. This function spreads the bits of such values across the entire 64-bit result so that they may be safely
+     combined with other hash values. It uses the finalizer from MurmurHash3.
+ */
+extern uint64_t PGCHashMix(uint64_t hash);
+
+/*!
+ @abstract Returns a hash value for the specified bytes.
+ @param bytes The bytes to hash; may only be NULL if length is 0.
+ @param length The number of bytes to hash.
+ @result A well-distributed hash value for the bytes.
+ @discussion The bytes are hashed using FNV-1a, and the result is scrambled with @link PGCHashMix @/link so that both its low- and
+     high-order bits are suitable for choosing hash table slots.
+ */
+extern uint64_t PGCHashBytes(const void *bytes, uint64_t length);
+
+/*!
+ @abstract Combines a running hash value with the hash value of another object in an order-sensitive way.
+ @param seed The running hash value, e.g., the combined hash of all objects before the current one in a sequence.
+ @param hash The hash value to combine with the running hash value.
+ @result The combined hash value.
+ @discussion Combining the same hash values in a different order generally produces a different result. This makes the function
+     suitable for hashing sequences like arrays and lists. Collections whose hashes should not depend on ordering, e.g., 
+     dictionaries, should instead add the result of @link PGCHashMix @/link for each of their elements.
+ */
+extern uint64_t PGCHashCombine(uint64_t seed, uint64_t hash);
+
+
 #pragma mark Polymorphic Functions
 
 /*!
@@ -226,6 +287,18 @@ extern void PGCRelease(PGCType instance);
  */
 extern PGCType PGCAutorelease(PGCType instance);
 
+/*!
+ @abstract Retains an object that was just returned autoreleased by a function.
+ @param instance The object to retain.
+ @result The object that was retained; returns NULL if instance is NULL.
+ @discussion If instance was the last object autoreleased on the current thread, its pending release is cancelled instead of
+     retaining it again, so the object never occupies an autorelease pool entry. Otherwise, this function is equivalent to
+     @link PGCRetain @/link. Either way, the caller must eventually release the object. This should be called immediately on the 
+     result of a function like @link PGCUnarchiverDecodeObject @/link; any intervening autorelease makes the optimization 
+     ineffective, though never incorrect.
+ */
+extern PGCType PGCRetainAutoreleasedReturnValue(PGCType instance);
+
 
 #pragma mark Polymorphic Superclass Functions
 
@@ -284,5 +357,38 @@ typedef uint64_t PGCEnumerationOptions;
 
 typedef void (^PGCIndexedEnumerationBlock)(PGCType object, uint64_t index, bool *stop);
 
+typedef bool (^PGCIndexedTestBlock)(PGCType object, uint64_t index, bool *stop);
+
+
+#pragma mark Sorting
+
+enum {
+    PGCOrderedAscending = -1,
+    PGCOrderedSame = 0,
+    PGCOrderedDescending = 1
+};
+
+typedef int64_t PGCComparisonResult;
+
+typedef PGCComparisonResult (^PGCComparator)(PGCType object1, PGCType object2);
+
+enum {
+    PGCSortConcurrent = 1UL << 0,
+    PGCSortStable = 1UL << 4
+};
+
+typedef uint64_t PGCSortOptions;
+
+enum {
+    PGCSortDescriptorNumericAscending,
+    PGCSortDescriptorNumericDescending,
+    PGCSortDescriptorStringAscending,
+    PGCSortDescriptorStringDescending,
+    PGCSortDescriptorCaseInsensitiveStringAscending,
+    PGCSortDescriptorCaseInsensitiveStringDescending
+};
+
+typedef uint64_t PGCSortDescriptor;
+
 
 #endif
@@ -27,6 +27,7 @@
 #include <PGCFoundation/PGCClass.h>
 
 #include <assert.h>
+#include <pthread.h>
 #include <string.h>
 
 #pragma mark Private Data Structures
@@ -38,20 +39,48 @@
  @field superclass A pointer to the class’s superclass data structure.
  @field functions The class functions for the class.
  @field instanceSize The size of a class instance.
+ @field nextRegisteredClass The next class in the class registry.
  */
 struct _PGCClass {
     const char *name;
     PGCClass *superclass;
     PGCClassFunctions functions;
     uint64_t instanceSize;
+    PGCClass *nextRegisteredClass;
 };
 
 
+// Every class that is created is recorded in the registry so that it can be looked up by name. The registry is a list linked
+// through the classes themselves, so registering a class never allocates memory and can't fail.
+static PGCClass *PGCClassRegistryHead = NULL;
+static pthread_mutex_t PGCClassRegistryMutex = PTHREAD_MUTEX_INITIALIZER;
+
+
 #pragma mark Private Functions
 
 bool PGCClassFunctionsNoneNull(PGCClassFunctions functions)
 {
-    return functions.copy && functions.dealloc && functions.description && functions.equals && functions.hash && functions.release && functions.retain;
+    return functions.copy && functions.dealloc && functions.description && functions.equals && functions.hash && functions.release &&
+        functions.retain && functions.encode && functions.decode;
+}
+
+
+static void PGCClassRegistryAddClass(PGCClass *class)
+{
+    pthread_mutex_lock(&PGCClassRegistryMutex);
+    class->nextRegisteredClass = PGCClassRegistryHead;
+    PGCClassRegistryHead = class;
+    pthread_mutex_unlock(&PGCClassRegistryMutex);
+}
+
+
+static void PGCClassRegistryRemoveClass(PGCClass *class)
+{
+    pthread_mutex_lock(&PGCClassRegistryMutex);
+    PGCClass **link = &PGCClassRegistryHead;
+    while (*link && *link != class) link = &(*link)->nextRegisteredClass;
+    if (*link) *link = class->nextRegisteredClass;
+    pthread_mutex_unlock(&PGCClassRegistryMutex);
 }
 
 
@@ -78,8 +107,16 @@ PGCClass *PGCClassCreate(const char *name, PGCClass *superclass, PGCClassFunctio
         if (!class->functions.hash) class->functions.hash = classIterator->functions.hash;
         if (!class->functions.release) class->functions.release = classIterator->functions.release;
         if (!class->functions.retain) class->functions.retain = classIterator->functions.retain;
+        if (!class->functions.encode) class->functions.encode = classIterator->functions.encode;
+        if (!class->functions.decode) class->functions.decode = classIterator->functions.decode;
     }
     
+    if (!class->name) {
+        free(class);
+        return NULL;
+    }
+    
+    PGCClassRegistryAddClass(class);
     return class;
 }
 
@@ -87,6 +124,7 @@ PGCClass *PGCClassCreate(const char *name, PGCClass *superclass, PGCClassFunctio
 void PGCClassDestroy(PGCClass *class)
 {
     if (!class) return;
+    PGCClassRegistryRemoveClass(class);
     free((void *)class->name);
     class->superclass = NULL;
     free(class);
@@ -107,6 +145,21 @@ PGCClass *PGCClassGetSuperclass(PGCClass *class)
 }
 
 
+PGCClass *PGCClassGetClassWithName(const char *name)
+{
+    if (!name) return NULL;
+    
+    PGCClass *class = NULL;
+    pthread_mutex_lock(&PGCClassRegistryMutex);
+    for (PGCClass *registeredClass = PGCClassRegistryHead; registeredClass && !class; registeredClass = registeredClass->nextRegisteredClass) {
+        if (strcmp(registeredClass->name, name) == 0) class = registeredClass;
+    }
+    pthread_mutex_unlock(&PGCClassRegistryMutex);
+    
+    return class;
+}
+
+
 PGCClassFunctions PGCClassGetClassFunctions(PGCClass *class)
 {
     return class ? class->functions : (PGCClassFunctions){ NULL, NULL, NULL, NULL, NULL, NULL, NULL };
@@ -180,3 +233,14 @@ PGCRetainFunction *PGCClassGetRetainFunction(PGCClass *class)
     return class ? class->functions.retain : NULL;
 }
 
+
+PGCEncodeFunction *PGCClassGetEncodeFunction(PGCClass *class)
+{
+    return class ? class->functions.encode : NULL;
+}
+
+
+PGCDecodeFunction *PGCClassGetDecodeFunction(PGCClass *class)
+{
+    return class ? class->functions.decode : NULL;
+}
@@ -50,6 +50,8 @@
  @field hash The class’s Hash function.
  @field release The class’s Release function.
  @field retain The class’s Retain function.
+ @field encode The class’s Encode function.
+ @field decode The class’s Decode function.
  
  @discussion The PGCClassFunctions data structure provides a convenient way to store pointers to a class’s functions. A NULL 
      function pointer implies that the class’s superclass implementation should be used. To denote that nothing should be done, a
@@ -84,6 +86,12 @@
      Retain functions increment the retain count of an object. As is the case with Release functions, classes that inherit from PGCObject
      will almost never need to provide their own implementation of Retain except when they use the singleton pattern. In that case, the 
      the implementation need only return the object being retained.
+
+     Encode and Decode functions enable instances of a class to be archived using @link PGCArchiver @/link. An Encode function writes
+     an object’s contents to an archiver using its encoding functions, and a Decode function reads those contents back in the same 
+     order from an unarchiver and returns a new instance with a retain count of 1. Archives refer to classes by name, so a class must
+     have been created before instances of it can be decoded. Classes that do not support archiving should leave both functions NULL,
+     which they can do by simply omitting them from the end of the structure’s initializer.
  */
 typedef struct _PGCClassFunctions PGCClassFunctions;
 struct _PGCClassFunctions {
@@ -94,6 +102,8 @@ struct _PGCClassFunctions {
     PGCHashFunction *hash;
     PGCReleaseFunction *release;
     PGCRetainFunction *retain;
+    PGCEncodeFunction *encode;
+    PGCDecodeFunction *decode;
 } ;
 
 
@@ -163,6 +173,15 @@ extern const char *PGCClassGetName(PGCClass *class);
  */
 extern PGCClass *PGCClassGetSuperclass(PGCClass *class);
 
+/*!
+ @abstract Returns the class with the specified name.
+ @param name The name of the class.
+ @result The class with the specified name; returns NULL if name is NULL or no class with that name has been created.
+ @discussion Classes are typically created lazily the first time their class function is called. As such, this function will not
+     find a class whose class function has never been called.
+ */
+extern PGCClass *PGCClassGetClassWithName(const char *name);
+
 /*!
  @abstract Returns the class functions for the specified class.
  @param class The class
@@ -270,4 +289,22 @@ extern PGCReleaseFunction *PGCClassGetReleaseFunction(PGCClass *class);
  */
 extern PGCRetainFunction *PGCClassGetRetainFunction(PGCClass *class);
 
+/*!
+ @abstract Returns a pointer to the Encode function implementation for the specified class.
+ @param class The class
+ @result The Encode function for the specified class; returns NULL if class is NULL or does not support archiving. The function 
+     returned may not be the same as the function used to initialize the class. Specifically, if a NULL function was specified at
+     class creation, a pointer to the inherited function implementation is returned.
+ */
+extern PGCEncodeFunction *PGCClassGetEncodeFunction(PGCClass *class);
+
+/*!
+ @abstract Returns a pointer to the Decode function implementation for the specified class.
+ @param class The class
+ @result The Decode function for the specified class; returns NULL if class is NULL or does not support archiving. The function 
+     returned may not be the same as the function used to initialize the class. Specifically, if a NULL function was specified at
+     class creation, a pointer to the inherited function implementation is returned.
+ */
+extern PGCDecodeFunction *PGCClassGetDecodeFunction(PGCClass *class);
+
 #endif
@@ -46,7 +46,16 @@
 #include <PGCFoundation/PGCString.h>
 
 #include <PGCFoundation/PGCArray.h>
+#include <PGCFoundation/PGCConcurrentQueue.h>
+#include <PGCFoundation/PGCDecimalArray.h>
 #include <PGCFoundation/PGCDictionary.h>
+#include <PGCFoundation/PGCIntegerArray.h>
 #include <PGCFoundation/PGCList.h>
+#include <PGCFoundation/PGCStaticDictionary.h>
+
+#include <PGCFoundation/PGCArchiver.h>
+#include <PGCFoundation/PGCJSONReader.h>
+#include <PGCFoundation/PGCJSONWriter.h>
+#include <PGCFoundation/PGCMappedFile.h>
 
 #endif
@@ -29,12 +29,67 @@
 #include <PGCFoundation/PGCString.h>
 
 #include <assert.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
+
+#pragma mark Private Global Variables
+
+/*!
+ @abstract Ensures that PGCObjectInitializeDeferredObjectsKey is only called once.
+ */
+static pthread_once_t PGCObjectDeferredObjectsKeyOnce = PTHREAD_ONCE_INIT;
+
+/*!
+ @abstract Indicates whether the key for cleaning up deferred objects was successfully created.
+ */
+static bool PGCObjectDeferredObjectsKeyInitialized = false;
+
+/*!
+ @abstract The thread key used to deallocate a thread's remaining deferred objects when it terminates.
+ @discussion The key's value is the thread's PGCObjectDeferredObjects buffer.
+ */
+static pthread_key_t PGCObjectDeferredObjectsKey;
+
+/*!
+ @abstract The calling thread's deferred objects, which are deallocated in last-in, first-out order.
+ */
+static __thread PGCType *PGCObjectDeferredObjects = NULL;
+
+/*!
+ @abstract The number of objects in PGCObjectDeferredObjects.
+ */
+static __thread uint64_t PGCObjectDeferredObjectCount = 0;
+
+/*!
+ @abstract The number of objects PGCObjectDeferredObjects has room for.
+ */
+static __thread uint64_t PGCObjectDeferredObjectCapacity = 0;
+
+/*!
+ @abstract The calling thread's deferral depth; deallocation is deferred while it is greater than 0.
+ */
+static __thread uint64_t PGCObjectDeferralDepth = 0;
+
+/*!
+ @abstract The calling thread's deallocation time slice in nanoseconds; 0 means there is no limit.
+ */
+static __thread uint64_t PGCObjectDeallocationTimeSlice = 0;
+
+/*!
+ @abstract The number of deallocations between checks of the time when deallocating within a time slice.
+ */
+static const uint64_t PGCObjectDeallocationTimeCheckInterval = 16;
+
 
 #pragma mark Private Function Interfaces
 
 void PGCObjectDealloc(PGCType instance);
+void PGCObjectInitializeDeferredObjectsKey(void);
+void PGCObjectDeferredObjectsThreadWasDestroyed(void *threadVariable);
+bool PGCObjectDeferDealloc(PGCObject *object);
+uint64_t PGCObjectGetNanoseconds(void);
 
 
 #pragma mark -
@@ -98,21 +153,153 @@ void PGCObjectRelease(PGCType instance)
 {
     PGCObject *object = instance;
     
-    // If we have an invalid object or its retain count is 0, we're done
-    if (!object || object->retainCount == 0) return;
+    if (!object) return;
 
-    // Otherwise, if its retain count is 0 after decrementing, dealloc it
-    if (--object->retainCount == 0) PGCDealloc(object);
+    // Objects may be shared between threads, so retain counts are updated atomically. If the retain count is already 0, we're
+    // done. If it's 1, our reference is the only one, so no other thread can be changing it and we can skip the atomic
+    // decrement. Otherwise, if it's 0 after decrementing, dealloc the object.
+    uint64_t retainCount = __atomic_load_n(&object->retainCount, __ATOMIC_ACQUIRE);
+    if (retainCount == 0) return;
+    
+    if (retainCount == 1) {
+        __atomic_store_n(&object->retainCount, 0, __ATOMIC_RELAXED);
+    } else if (__atomic_fetch_sub(&object->retainCount, 1, __ATOMIC_ACQ_REL) != 1) {
+        return;
+    }
+    
+    // Deallocating an object releases the objects it owns, so deallocating a deeply nested object graph recursively could 
+    // overflow the stack. Instead, objects released while deferring are deallocated one at a time by the outermost release.
+    // If the deferred list can't grow, fall back to deallocating immediately.
+    if ((PGCObjectDeferralDepth > 0 || PGCObjectDeallocationTimeSlice > 0) && PGCObjectDeferDealloc(object)) {
+        if (PGCObjectDeferralDepth == 0) PGCObjectDeallocDeferredObjects(PGCObjectDeallocationTimeSlice);
+        return;
+    }
+    
+    PGCObjectDeferralDepth++;
+    PGCDealloc(object);
+    PGCObjectDeferralDepth--;
+    if (PGCObjectDeferralDepth == 0 && PGCObjectDeferredObjectCount > 0) {
+        PGCObjectDeallocDeferredObjects(PGCObjectDeallocationTimeSlice);
+    }
 }
 
 
 PGCType PGCObjectRetain(PGCType instance)
 {
-    if (instance) ((PGCObject *)instance)->retainCount++;
+    if (instance) __atomic_fetch_add(&((PGCObject *)instance)->retainCount, 1, __ATOMIC_RELAXED);
     return instance;
 }
 
 
+#pragma mark Deferred Deallocation
+
+void PGCObjectBeginDeferringDeallocation(void)
+{
+    PGCObjectDeferralDepth++;
+}
+
+
+void PGCObjectEndDeferringDeallocation(void)
+{
+    if (PGCObjectDeferralDepth == 0) return;
+    if (--PGCObjectDeferralDepth == 0 && PGCObjectDeferredObjectCount > 0) {
+        PGCObjectDeallocDeferredObjects(PGCObjectDeallocationTimeSlice);
+    }
+}
+
+
+bool PGCObjectDeallocDeferredObjects(uint64_t nanoseconds)
+{
+    // Nested calls leave the work to the outermost one
+    if (PGCObjectDeferralDepth > 0) return PGCObjectDeferredObjectCount == 0;
+    
+    // Deallocating an object may defer more objects, which are deallocated before the objects deferred before it. The
+    // clock isn’t read until the first check interval has passed, so most releases, which only free a few objects, never
+    // read it at all. The time slice starts at that first reading.
+    uint64_t deadline = 0;
+    uint64_t deallocCount = 0;
+    PGCObjectDeferralDepth++;
+    while (PGCObjectDeferredObjectCount > 0) {
+        PGCDealloc(PGCObjectDeferredObjects[--PGCObjectDeferredObjectCount]);
+        if (nanoseconds == 0 || ++deallocCount % PGCObjectDeallocationTimeCheckInterval != 0) continue;
+        
+        uint64_t now = PGCObjectGetNanoseconds();
+        if (deadline == 0) {
+            deadline = now + nanoseconds;
+        } else if (now >= deadline) {
+            break;
+        }
+    }
+    PGCObjectDeferralDepth--;
+    
+    return PGCObjectDeferredObjectCount == 0;
+}
+
+
+uint64_t PGCObjectGetDeferredObjectCount(void)
+{
+    return PGCObjectDeferredObjectCount;
+}
+
+
+uint64_t PGCObjectGetDeallocationTimeSlice(void)
+{
+    return PGCObjectDeallocationTimeSlice;
+}
+
+
+void PGCObjectSetDeallocationTimeSlice(uint64_t nanoseconds)
+{
+    PGCObjectDeallocationTimeSlice = nanoseconds;
+}
+
+
+void PGCObjectInitializeDeferredObjectsKey(void)
+{
+    PGCObjectDeferredObjectsKeyInitialized = pthread_key_create(&PGCObjectDeferredObjectsKey, PGCObjectDeferredObjectsThreadWasDestroyed) == 0;
+}
+
+
+void PGCObjectDeferredObjectsThreadWasDestroyed(void *threadVariable)
+{
+    // Deallocating the remaining objects may defer more, which allocates a new buffer and sets the key again, so this
+    // function will be called again if necessary
+    PGCObjectDeallocDeferredObjects(0);
+    free(PGCObjectDeferredObjects);
+    PGCObjectDeferredObjects = NULL;
+    PGCObjectDeferredObjectCapacity = 0;
+}
+
+
+bool PGCObjectDeferDealloc(PGCObject *object)
+{
+    if (PGCObjectDeferredObjectCount == PGCObjectDeferredObjectCapacity) {
+        // The key is needed to deallocate the thread's remaining deferred objects when it terminates
+        pthread_once(&PGCObjectDeferredObjectsKeyOnce, PGCObjectInitializeDeferredObjectsKey);
+        if (!PGCObjectDeferredObjectsKeyInitialized) return false;
+        
+        uint64_t capacity = PGCObjectDeferredObjectCapacity > 0 ? PGCObjectDeferredObjectCapacity * 2 : 64;
+        PGCType *objects = realloc(PGCObjectDeferredObjects, capacity * sizeof(PGCType));
+        if (!objects) return false;
+        
+        PGCObjectDeferredObjects = objects;
+        PGCObjectDeferredObjectCapacity = capacity;
+        pthread_setspecific(PGCObjectDeferredObjectsKey, objects);
+    }
+    
+    PGCObjectDeferredObjects[PGCObjectDeferredObjectCount++] = object;
+    return true;
+}
+
+
+uint64_t PGCObjectGetNanoseconds(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000 + time.tv_nsec;
+}
+
+
 #pragma mark Class Introspection
 
 PGCClass *PGCObjectGetClass(PGCType instance)
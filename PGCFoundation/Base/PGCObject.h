@@ -135,6 +135,60 @@ extern void PGCObjectRelease(PGCType instance);
 extern PGCType PGCObjectRetain(PGCType instance);
 
 
+#pragma mark Deferred Deallocation
+
+/*!
+ @abstract Starts deferring the deallocation of objects released on the calling thread.
+ @discussion Until the matching call to @link PGCObjectEndDeferringDeallocation @/link, objects whose retain counts reach 0
+     are added to the calling thread’s list of deferred objects instead of being deallocated immediately. Calls may be nested.
+ 
+     Deallocation is always deferred while an object is being deallocated, so that releasing a deeply nested object graph
+     deallocates its objects one at a time rather than recursively. Functions that release many objects at once, like 
+     @link PGCAutoreleasePoolDestroy @/link, also defer deallocation so that their deferred objects are deallocated together
+     within a single time slice.
+ */
+extern void PGCObjectBeginDeferringDeallocation(void);
+
+/*!
+ @abstract Stops deferring deallocation and deallocates the calling thread’s deferred objects.
+ @discussion If this ends the outermost deferral, the calling thread’s deferred objects are deallocated, subject to the thread’s
+     deallocation time slice.
+ */
+extern void PGCObjectEndDeferringDeallocation(void);
+
+/*!
+ @abstract Deallocates the calling thread’s deferred objects for up to the specified amount of time.
+ @param nanoseconds The maximum amount of time to spend deallocating objects, or 0 to deallocate all of them.
+ @result Whether the calling thread has no deferred objects remaining.
+ @discussion The time limit is only checked periodically, so this function may run somewhat longer than requested. Does nothing 
+     if called while the calling thread is deferring deallocation.
+ */
+extern bool PGCObjectDeallocDeferredObjects(uint64_t nanoseconds);
+
+/*!
+ @abstract Returns the number of objects the calling thread has deferred deallocating.
+ @result The number of deferred objects on the calling thread.
+ */
+extern uint64_t PGCObjectGetDeferredObjectCount(void);
+
+/*!
+ @abstract Returns the maximum amount of time the calling thread spends deallocating deferred objects at once.
+ @result The calling thread’s deallocation time slice in nanoseconds; 0 means there is no limit.
+ */
+extern uint64_t PGCObjectGetDeallocationTimeSlice(void);
+
+/*!
+ @abstract Sets the maximum amount of time the calling thread spends deallocating deferred objects at once.
+ @param nanoseconds The deallocation time slice in nanoseconds, or 0 for no limit. The default is 0.
+ @discussion When a time slice is set, every object whose retain count reaches 0 is deferred. Each release that isn’t itself
+     part of a deallocation then spends up to one time slice deallocating deferred objects, and objects that aren’t deallocated 
+     in that time remain deferred until the next such release or a call to @link PGCObjectDeallocDeferredObjects @/link. This
+     spreads the cost of freeing a large object graph over several calls at the cost of holding memory longer. Any remaining
+     deferred objects are deallocated when the thread terminates.
+ */
+extern void PGCObjectSetDeallocationTimeSlice(uint64_t nanoseconds);
+
+
 #pragma mark Class Introspection
 
 /*!
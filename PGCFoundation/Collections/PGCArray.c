@@ -26,30 +26,147 @@
 
 #include <PGCFoundation/PGCArray.h>
 
+#include <PGCFoundation/PGCArchiver.h>
+#include <PGCFoundation/PGCBoolean.h>
+#include <PGCFoundation/PGCCharacter.h>
+#include <PGCFoundation/PGCDecimal.h>
+#include <PGCFoundation/PGCInteger.h>
 #include <PGCFoundation/PGCString.h>
 
 #include <dispatch/dispatch.h>
 #include <string.h>
+#include <strings.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+typedef struct _PGCArrayStorage {
+    uint64_t referenceCount;
+    PGCObject **buffer;
+    PGCObject **objects;
+    uint64_t count;
+} PGCArrayStorage;
+
 
 struct _PGCArray {
     PGCObject super;
     
+    PGCArrayStorage *storage;
+    PGCObject **buffer;
     PGCObject **objects;
     uint64_t capacity;
+    uint64_t initialCapacity;
     uint64_t increment;
+    double growthFactor;
     uint64_t count;
+
+    uint64_t hash;
+    bool hashIsValid;
+
+    bool cachesObjectHashes;
+    uint64_t *objectHashes;
+    uint64_t objectHashCapacity;
+    uint64_t objectHashCount;
+
+    bool isFrozen;
 };
 
 
+typedef struct _PGCArraySortContext {
+    PGCComparator comparator;
+    PGCSortDescriptor descriptor;
+} PGCArraySortContext;
+
+
+typedef struct _PGCArrayParallelSortState {
+    PGCObject **source;
+    PGCObject **destination;
+    uint64_t count;
+    uint64_t width;
+    PGCArraySortContext *context;
+} PGCArrayParallelSortState;
+
+
+typedef uint64_t (*PGCArrayWordSearchFunction)(const void *words, uint64_t count, uint64_t word);
+
+
 #pragma mark Private Global Constants
 
-static const uint64_t PGCArrayDefaultInitialCapacity = 128;
+static const uint64_t PGCArrayDefaultInitialCapacity = 8;
+static const double PGCArrayDefaultGrowthFactor = 1.5;
+static const uint64_t PGCArraySharedSubarrayMinimumCount = 32;
+static const uint64_t PGCArrayJoinDrainInterval = 256;
+
+static const uint64_t PGCArrayInsertionSortThreshold = 24;
+static const uint64_t PGCArrayNintherThreshold = 128;
+static const uint64_t PGCArrayPartialInsertionSortLimit = 8;
+static const uint64_t PGCArrayConcurrentSortThreshold = 1 << 16;
+static const uint64_t PGCArrayConcurrentSortChunkSize = 1 << 14;
 
 
 #pragma mark Private Function Interfaces
 
 PGCArray *PGCArrayInitWithObjectAndObjectArguments(PGCArray *array, PGCType firstObject, va_list objectArguments);
 void PGCArrayDealloc(PGCType instance);
+uint64_t PGCArrayGetHeadRoom(PGCArray *array);
+uint64_t PGCArrayGetTailRoom(PGCArray *array);
+uint64_t PGCArrayGetGrownCapacity(PGCArray *array, uint64_t minimumCapacity);
+bool PGCArrayReallocateObjects(PGCArray *array, uint64_t capacity);
+bool PGCArrayGrowToMinimumCapacity(PGCArray *array, uint64_t minimumCapacity);
+bool PGCArrayMakeRoomForInsertion(PGCArray *array, bool atHead);
+bool PGCArrayShareStorage(PGCArray *array);
+PGCArray *PGCArrayInitWithSharedStorage(PGCArray *array, PGCArray *sourceArray, PGCRange range);
+void PGCArrayReleaseStorage(PGCArrayStorage *storage);
+bool PGCArrayMakeStorageUnique(PGCArray *array);
+bool PGCArrayCacheObjectHashesToIndex(PGCArray *array, uint64_t endIndex);
+void PGCArrayInvalidateObjectHashesFromIndex(PGCArray *array, uint64_t index);
+uint64_t PGCArrayGetIndexOfWord(const void *words, uint64_t count, uint64_t word);
+uint64_t PGCArrayCountWord(const void *words, uint64_t count, uint64_t word);
+uint64_t PGCArrayGetWord(const void *words, uint64_t index);
+#if defined(__x86_64__)
+uint64_t PGCArrayGetIndexOfWordSSE2(const void *words, uint64_t count, uint64_t word);
+uint64_t PGCArrayGetIndexOfWordAVX2(const void *words, uint64_t count, uint64_t word) __attribute__((target("avx2")));
+uint64_t PGCArrayCountWordSSE2(const void *words, uint64_t count, uint64_t word);
+uint64_t PGCArrayCountWordAVX2(const void *words, uint64_t count, uint64_t word) __attribute__((target("avx2")));
+uint64_t PGCArrayGetIndexOfWordResolving(const void *words, uint64_t count, uint64_t word);
+uint64_t PGCArrayCountWordResolving(const void *words, uint64_t count, uint64_t word);
+void PGCArrayResolveWordSearchFunctions(void);
+#endif
+uint64_t PGCArrayGetBoundOfObjectInSortedRange(PGCArray *array, PGCType instance, PGCRange range, PGCComparator comparator, bool upper);
+
+void PGCArraySortObjectsWithContext(PGCArray *array, PGCSortOptions options, PGCArraySortContext *context);
+PGCComparisonResult PGCArraySortContextCompare(PGCArraySortContext *context, PGCObject *object1, PGCObject *object2);
+PGCComparisonResult PGCArrayCompareNumbers(PGCObject *object1, PGCObject *object2, bool descending);
+bool PGCArrayIsNumber(PGCObject *object);
+double PGCArrayGetNumberValue(PGCObject *object);
+PGCComparisonResult PGCArrayCompareStrings(PGCObject *object1, PGCObject *object2, bool caseInsensitive, bool descending);
+uint64_t PGCArrayGetFloorLog2(uint64_t value);
+void PGCArrayInsertionSort(PGCObject **objects, uint64_t count, PGCArraySortContext *context);
+bool PGCArrayPartialInsertionSort(PGCObject **objects, uint64_t count, PGCArraySortContext *context);
+void PGCArraySwapObjects(PGCObject **objects, uint64_t index1, uint64_t index2);
+void PGCArraySortThreeObjects(PGCObject **objects, uint64_t index1, uint64_t index2, uint64_t index3, PGCArraySortContext *context);
+void PGCArrayHeapSort(PGCObject **objects, uint64_t count, PGCArraySortContext *context);
+void PGCArraySiftDown(PGCObject **objects, uint64_t root, uint64_t count, PGCArraySortContext *context);
+uint64_t PGCArrayPartitionRight(PGCObject **objects, uint64_t count, PGCArraySortContext *context, bool *alreadyPartitioned);
+uint64_t PGCArrayPartitionLeft(PGCObject **objects, uint64_t count, PGCArraySortContext *context);
+void PGCArrayQuickSort(PGCObject **objects, uint64_t count, PGCArraySortContext *context, uint64_t badPartitionsAllowed, bool leftmost);
+void PGCArrayMerge(PGCObject **left, uint64_t leftCount, PGCObject **right, uint64_t rightCount, PGCObject **destination,
+                   PGCArraySortContext *context);
+void PGCArrayMergeSortWithBuffer(PGCObject **objects, uint64_t count, PGCObject **buffer, PGCArraySortContext *context);
+void PGCArrayMergeSort(PGCObject **objects, uint64_t count, PGCArraySortContext *context);
+void PGCArrayParallelMergeSort(PGCObject **objects, uint64_t count, PGCArraySortContext *context);
+void PGCArraySortChunk(void *context, size_t chunkIndex);
+void PGCArrayMergeChunks(void *context, size_t pairIndex);
+
+
+#pragma mark Private Global Variables
+
+#if defined(__x86_64__)
+// The word search implementations are chosen on first use, based on the widest vector unit the CPU supports
+static PGCArrayWordSearchFunction PGCArrayGetIndexOfWordImplementation = PGCArrayGetIndexOfWordResolving;
+static PGCArrayWordSearchFunction PGCArrayCountWordImplementation = PGCArrayCountWordResolving;
+#endif
 
 
 #pragma mark -
@@ -58,7 +175,8 @@ PGCClass *PGCArrayClass(void)
 {
     static PGCClass *arrayClass = NULL;
     if (!arrayClass) {
-        PGCClassFunctions functions = { PGCArrayCopy, PGCArrayDealloc, PGCArrayDescription, PGCArrayEquals, PGCArrayHash, NULL, NULL };
+        PGCClassFunctions functions = { PGCArrayCopy, PGCArrayDealloc, PGCArrayDescription, PGCArrayEquals, PGCArrayHash,
+                                        NULL, NULL, PGCArrayEncode, PGCArrayDecode };
         arrayClass = PGCClassCreate("PGCArray", PGCObjectClass(), functions, sizeof(PGCArray));
     }
     return arrayClass;
@@ -102,13 +220,22 @@ PGCArray *PGCArrayInitWithInitialCapacityAndIncrement(PGCArray *array, uint64_t
     PGCObjectInit(&array->super);
     
     array->count = 0;
-    array->capacity = initialCapacity > 0 ? initialCapacity : PGCArrayDefaultInitialCapacity;
+    array->hashIsValid = false;
     array->increment = increment;
-    array->objects = calloc(array->capacity, sizeof(PGCObject *));
-    if (!array->objects) {
-        PGCRelease(array);
-        return NULL;
-    }
+    array->growthFactor = PGCArrayDefaultGrowthFactor;
+
+    array->cachesObjectHashes = false;
+    array->objectHashes = NULL;
+    array->objectHashCapacity = 0;
+    array->objectHashCount = 0;
+    array->isFrozen = false;
+
+    // Our objects buffer isn’t allocated until the first object is inserted, so empty arrays cost nothing beyond their instance
+    array->storage = NULL;
+    array->buffer = NULL;
+    array->objects = NULL;
+    array->capacity = 0;
+    array->initialCapacity = initialCapacity > 0 ? initialCapacity : PGCArrayDefaultInitialCapacity;
     
     return array;
 }
@@ -145,10 +272,10 @@ void PGCArrayDealloc(PGCType instance)
 {
     if (!PGCObjectIsKindOfClass(instance, PGCArrayClass())) return;
     PGCArray *array = instance;
-    if (array->objects) {
-        PGCArrayRemoveAllObjects(array);
-        free(array->objects);
-    }
+    array->isFrozen = false;
+    PGCArrayRemoveAllObjects(array);
+    free(array->buffer);
+    free(array->objectHashes);
     PGCSuperclassDealloc(array);
 }
 
@@ -157,8 +284,38 @@ PGCType PGCArrayCopy(PGCType instance)
 {
     if (!PGCObjectIsKindOfClass(instance, PGCArrayClass())) return NULL;
     PGCArray *array = instance;
-    PGCArray *copy = PGCArrayInitWithInitialCapacityAndIncrement(NULL, array->count, 0);
-    for (uint64_t i = 0; i < array->count; i++) PGCArrayAddObject(copy, array->objects[i]);
+    
+    // Frozen arrays can never change, so they are their own copies
+    if (array->isFrozen) return PGCRetain(array);
+    
+    // Copies share their original’s objects until one of them is mutated. If we can’t share, fall back to copying.
+    PGCArray *copy = NULL;
+    if (PGCArrayShareStorage(array)) {
+        copy = PGCArrayInitWithSharedStorage(NULL, array, PGCMakeRange(0, array->count));
+    } else {
+        copy = PGCArrayInitWithInitialCapacityAndIncrement(NULL, array->count, array->increment);
+        for (uint64_t i = 0; copy && i < array->count; i++) PGCArrayAddObject(copy, array->objects[i]);
+    }
+    
+    if (!copy) return NULL;
+    
+    copy->initialCapacity = array->initialCapacity;
+    copy->increment = array->increment;
+    copy->growthFactor = array->growthFactor;
+    copy->hash = array->hash;
+    copy->hashIsValid = array->hashIsValid;
+
+    // Copy whatever object hashes we’ve cached rather than recomputing them
+    copy->cachesObjectHashes = array->cachesObjectHashes;
+    if (array->objectHashCount > 0) {
+        copy->objectHashes = malloc(array->objectHashCount * sizeof(uint64_t));
+        if (copy->objectHashes) {
+            memcpy(copy->objectHashes, array->objectHashes, array->objectHashCount * sizeof(uint64_t));
+            copy->objectHashCapacity = array->objectHashCount;
+            copy->objectHashCount = array->objectHashCount;
+        }
+    }
+
     return copy;
 }
 
@@ -177,12 +334,12 @@ bool PGCArrayEquals(PGCType instance1, PGCType instance2)
     
     PGCArray *array1 = instance1;
     PGCArray *array2 = instance2;
+    if (array1 == array2 || (array1->objects == array2->objects && array1->count == array2->count)) return true;
     if (array1->count != array2->count) return false;
     
+    // Cached hashes can't be used to rule out equality, since they go stale when contained objects are mutated in place
     for (uint64_t i = 0; i < array1->count; i++) {
-        PGCType arrayObject1 = array1->objects[i];
-        PGCType arrayObject2 = array2->objects[i];
-        if (PGCHash(arrayObject1) != PGCHash(arrayObject2) || !PGCEquals(arrayObject1, arrayObject2)) return false;
+        if (!PGCEquals(array1->objects[i], array2->objects[i])) return false;
     }
     
     return true;
@@ -192,7 +349,57 @@ bool PGCArrayEquals(PGCType instance1, PGCType instance2)
 uint64_t PGCArrayHash(PGCType instance)
 {
     if (!PGCObjectIsKindOfClass(instance, PGCArrayClass())) return 0;
-    return ((PGCArray *)instance)->count;
+    PGCArray *array = instance;
+    
+    // The hash is computed lazily and cached until the array is mutated. Once it has been computed, appending objects keeps the
+    // cached value up to date, as the hash of the new object can simply be combined with the existing hash. Note that mutating
+    // an object while it is in an array that has been hashed will leave the array with a stale hash.
+    if (!array->hashIsValid) {
+        uint64_t hash = 0;
+        for (uint64_t i = 0; i < array->count; i++) hash = PGCHashCombine(hash, PGCHash(array->objects[i]));
+        array->hash = hash;
+        array->hashIsValid = true;
+    }
+    
+    return array->hash;
+}
+
+
+bool PGCArrayEncode(PGCType instance, PGCArchiver *archiver)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCArrayClass())) return false;
+    PGCArray *array = instance;
+    
+    PGCArchiverEncodeCount(archiver, array->count);
+    for (uint64_t i = 0; i < array->count; i++) {
+        if (!PGCArchiverEncodeObject(archiver, array->objects[i])) return false;
+    }
+    
+    return true;
+}
+
+
+PGCType PGCArrayDecode(PGCClass *class, PGCUnarchiver *unarchiver)
+{
+    uint64_t count = 0;
+    if (!PGCUnarchiverDecodeCount(unarchiver, &count)) return NULL;
+    
+    PGCArray *array = PGCArrayInitWithInitialCapacity(PGCAlloc(class), count);
+    if (!array) return NULL;
+    
+    for (uint64_t i = 0; i < count; i++) {
+        // Claiming each decoded object keeps it out of the autorelease pool
+        PGCType object = PGCRetainAutoreleasedReturnValue(PGCUnarchiverDecodeObject(unarchiver));
+        if (!object) {
+            PGCRelease(array);
+            return NULL;
+        }
+        
+        PGCArrayAddObject(array, object);
+        PGCRelease(object);
+    }
+    
+    return array;
 }
 
 
@@ -210,6 +417,12 @@ bool PGCArrayContainsObject(PGCArray *array, PGCType instance)
 }
 
 
+const PGCType *PGCArrayGetObjects(PGCArray *array)
+{
+    return array ? (const PGCType *)array->objects : NULL;
+}
+
+
 PGCType PGCArrayGetObjectAtIndex(PGCArray *array, uint64_t index)
 {
     return (array && index < array->count) ? PGCAutorelease(PGCRetain(array->objects[index])) : NULL;
@@ -241,6 +454,16 @@ uint64_t PGCArrayGetIndexOfObjectInRange(PGCArray *array, PGCType instance, PGCR
     uint64_t instanceHash = PGCHash(instance);    
     uint64_t lastIndex = range.location + range.length;
     
+    // If we cache object hashes, scan them for candidates without touching the objects themselves
+    if (array->cachesObjectHashes && PGCArrayCacheObjectHashesToIndex(array, lastIndex)) {
+        for (uint64_t i = range.location; i < lastIndex; i++) {
+            i += PGCArrayGetIndexOfWord(&array->objectHashes[i], lastIndex - i, instanceHash);
+            if (i < lastIndex && PGCEquals(instance, array->objects[i])) return i;
+        }
+        
+        return PGCNotFound;
+    }
+    
     for (uint64_t i = range.location; i < lastIndex; i++) {
         PGCType object = array->objects[i];
         if (PGCHash(object) == instanceHash && PGCEquals(instance, object)) return i;
@@ -259,19 +482,97 @@ uint64_t PGCArrayGetIndexOfIdenticalObjectInRange(PGCArray *array, PGCType insta
 {
     if (!array || !instance || array->count == 0 || range.location >= array->count || range.location + range.length > array->count) return PGCNotFound;
 
+    // Where pointers are 64 bits wide, we can use the vectorized word search
     uint64_t lastIndex = range.location + range.length;
+    if (sizeof(PGCObject *) == sizeof(uint64_t)) {
+        uint64_t index = range.location + PGCArrayGetIndexOfWord(&array->objects[range.location], range.length, (uintptr_t)instance);
+        return index < lastIndex ? index : PGCNotFound;
+    }
+
     for (uint64_t i = range.location; i < lastIndex; i++) if (array->objects[i] == instance) return i;
     
     return PGCNotFound;
 }
 
 
+uint64_t PGCArrayCountIdenticalObjects(PGCArray *array, PGCType instance)
+{
+    return array ? PGCArrayCountIdenticalObjectsInRange(array, instance, PGCMakeRange(0, array->count)) : 0;
+}
+
+
+uint64_t PGCArrayCountIdenticalObjectsInRange(PGCArray *array, PGCType instance, PGCRange range)
+{
+    if (!array || !instance || array->count == 0 || range.location >= array->count || range.location + range.length > array->count) return 0;
+
+    if (sizeof(PGCObject *) == sizeof(uint64_t)) {
+        return PGCArrayCountWord(&array->objects[range.location], range.length, (uintptr_t)instance);
+    }
+    
+    uint64_t matchCount = 0;
+    uint64_t lastIndex = range.location + range.length;
+    for (uint64_t i = range.location; i < lastIndex; i++) matchCount += array->objects[i] == instance;
+    return matchCount;
+}
+
+
+uint64_t PGCArrayGetIndexOfObjectInSortedRange(PGCArray *array, PGCType instance, PGCRange range, PGCComparator comparator)
+{
+    uint64_t index = PGCArrayGetLowerBoundOfObjectInSortedRange(array, instance, range, comparator);
+    if (index == PGCNotFound || index == range.location + range.length) return PGCNotFound;
+    return comparator(array->objects[index], instance) == PGCOrderedSame ? index : PGCNotFound;
+}
+
+
+uint64_t PGCArrayGetLowerBoundOfObjectInSortedRange(PGCArray *array, PGCType instance, PGCRange range, PGCComparator comparator)
+{
+    return PGCArrayGetBoundOfObjectInSortedRange(array, instance, range, comparator, false);
+}
+
+
+uint64_t PGCArrayGetUpperBoundOfObjectInSortedRange(PGCArray *array, PGCType instance, PGCRange range, PGCComparator comparator)
+{
+    return PGCArrayGetBoundOfObjectInSortedRange(array, instance, range, comparator, true);
+}
+
+
+uint64_t PGCArrayGetBoundOfObjectInSortedRange(PGCArray *array, PGCType instance, PGCRange range, PGCComparator comparator, bool upper)
+{
+    // Unlike the linear searches, an empty range at the end of the array is valid here, since it’s where objects that are
+    // ordered after every object in the array belong
+    if (!array || !instance || !comparator || range.location > array->count || range.length > array->count - range.location) return PGCNotFound;
+
+    // The lower bound is the first index whose object is not ordered before instance; the upper bound is the first index whose
+    // object is ordered after it
+    uint64_t base = range.location;
+    uint64_t length = range.length;
+    while (length > 0) {
+        uint64_t half = length / 2;
+        PGCComparisonResult result = comparator(array->objects[base + half], instance);
+        if (result < PGCOrderedSame || (upper && result == PGCOrderedSame)) {
+            base += half + 1;
+            length -= half + 1;
+        } else {
+            length = half;
+        }
+    }
+    
+    return base;
+}
+
+
 #pragma mark Subarrays
 
 PGCArray *PGCArraySubarrayWithRange(PGCArray *array, PGCRange range)
 {
     if (!array || range.location >= array->count || range.location + range.length > array->count) return NULL;
 
+    // Large subarrays share their array’s objects like copies do. Small ones don’t, since sharing would keep all of the array’s
+    // objects alive for as long as the subarray exists.
+    if (range.length >= PGCArraySharedSubarrayMinimumCount && range.length >= array->count / 2 && PGCArrayShareStorage(array)) {
+        return PGCAutorelease(PGCArrayInitWithSharedStorage(NULL, array, range));
+    }
+    
     PGCArray *subarray = PGCArrayInitWithInitialCapacity(NULL, range.length);
     uint64_t lastIndex = range.location + range.length;
     for (uint64_t i = range.location; i < lastIndex; i++) {
@@ -291,22 +592,53 @@ void PGCArrayAddObject(PGCArray *array, PGCType instance)
 
 void PGCArrayInsertObjectAtIndex(PGCArray *array, PGCType instance, uint64_t index)
 {
-    if (!array || !instance || index > array->count) return;
+    if (!array || !instance || index > array->count || !PGCArrayMakeStorageUnique(array)) return;
     
-    // Increase the size of our array if necessary
-    if (array->count >= array->capacity) {
-        uint64_t newCapacity = array->capacity + (array->increment > 0 ? array->increment : array->capacity);
-        
-        PGCObject **reallocedObjects = realloc(array->objects, newCapacity * sizeof(PGCObject *));
-        if (!reallocedObjects) return;
-        array->objects = reallocedObjects;
-        array->capacity = newCapacity;
+    // Our objects don’t necessarily start at the beginning of our buffer, so we can make room for the new object by shifting
+    // either the objects before index down one or the objects after it up one. Shift whichever side has fewer objects, making
+    // more room on that side first if necessary. This makes inserting at either end of the array amortized O(1).
+    bool shiftHead = index < array->count / 2;
+    if (!PGCArrayMakeRoomForInsertion(array, shiftHead)) return;
+    
+    if (shiftHead) {
+        array->objects--;
+        memmove(&array->objects[0], &array->objects[1], index * sizeof(PGCObject *));
+    } else {
+        memmove(&array->objects[index + 1], &array->objects[index], (array->count - index) * sizeof(PGCObject *));
     }
     
-    // Shift all the objects starting at index up one
-    memmove(&array->objects[index + 1], &array->objects[index], (array->count - index) * sizeof(PGCObject *));
     array->objects[index] = PGCRetain(instance);
     array->count++;
+    
+    // Appending can update our cached hashes incrementally; inserting anywhere else invalidates them
+    if (index == array->count - 1) {
+        if (array->cachesObjectHashes && array->objectHashCount == index) PGCArrayCacheObjectHashesToIndex(array, array->count);
+        if (array->hashIsValid) {
+            uint64_t instanceHash = array->objectHashCount == array->count ? array->objectHashes[index] : PGCHash(instance);
+            array->hash = PGCHashCombine(array->hash, instanceHash);
+        }
+    } else {
+        PGCArrayInvalidateObjectHashesFromIndex(array, index);
+        array->hashIsValid = false;
+    }
+}
+
+
+void PGCArrayInsertObjectsFromArrayAtIndex(PGCArray *array, PGCArray *otherArray, uint64_t index)
+{
+    PGCArrayReplaceObjectsInRange(array, PGCMakeRange(index, 0), otherArray);
+}
+
+
+uint64_t PGCArrayInsertObjectSorted(PGCArray *array, PGCType instance, PGCComparator comparator)
+{
+    // Inserting after any equal objects keeps equal objects in the order they were inserted
+    uint64_t index = PGCArrayGetUpperBoundOfObjectInSortedRange(array, instance, PGCMakeRange(0, PGCArrayGetCount(array)), comparator);
+    if (index == PGCNotFound) return PGCNotFound;
+    
+    uint64_t count = array->count;
+    PGCArrayInsertObjectAtIndex(array, instance, index);
+    return array->count > count ? index : PGCNotFound;
 }
 
 
@@ -315,55 +647,238 @@ void PGCArrayPushObject(PGCArray *array, PGCType instance)
     PGCArrayInsertObjectAtIndex(array, instance, 0);
 }
 
-void PGCArrayExchangeObjectsAtIndices(PGCArray *array, uint64_t index1, uint64_t index2)
+
+void PGCArrayExchangeValuesAtIndices(PGCArray *array, uint64_t index1, uint64_t index2)
 {
     if (!array || index1 >= array->count || index2 >= array->count || array->objects[index1] == array->objects[index2]) return;
+    if (!PGCArrayMakeStorageUnique(array)) return;
     PGCType index1Object = array->objects[index1];
     array->objects[index1] = array->objects[index2];
     array->objects[index2] = index1Object;
+    array->hashIsValid = false;
+    
+    if (index1 < array->objectHashCount && index2 < array->objectHashCount) {
+        uint64_t index1Hash = array->objectHashes[index1];
+        array->objectHashes[index1] = array->objectHashes[index2];
+        array->objectHashes[index2] = index1Hash;
+    } else {
+        PGCArrayInvalidateObjectHashesFromIndex(array, index1 < index2 ? index1 : index2);
+    }
 }
 
 
 void PGCArrayReplaceObjectAtIndex(PGCArray *array, PGCType instance, uint64_t index)
 {
-    if (!array || index >= array->count || array->objects[index] == instance) return;
+    if (!array || index >= array->count || array->objects[index] == instance || !PGCArrayMakeStorageUnique(array)) return;
     PGCRelease(array->objects[index]);
     array->objects[index] = PGCRetain(instance);
+    array->hashIsValid = false;
+    if (index < array->objectHashCount) array->objectHashes[index] = PGCHash(instance);
+}
+
+
+void PGCArrayReplaceObjectsInRange(PGCArray *array, PGCRange range, PGCArray *replacementArray)
+{
+    if (!array || range.location > array->count || range.location + range.length > array->count) return;
+    
+    uint64_t replacementCount = replacementArray ? replacementArray->count : 0;
+    if ((range.length == 0 && replacementCount == 0) || !PGCArrayMakeStorageUnique(array)) return;
+    
+    // If an array is replacing objects in itself, work from a snapshot of its objects so that they don’t move out from under us
+    PGCObject **replacementObjects = replacementCount > 0 ? replacementArray->objects : NULL;
+    if (replacementArray == array) {
+        replacementObjects = malloc(replacementCount * sizeof(PGCObject *));
+        if (!replacementObjects) return;
+        memcpy(replacementObjects, array->objects, replacementCount * sizeof(PGCObject *));
+    }
+    
+    uint64_t headCount = range.location;
+    uint64_t tailCount = array->count - range.location - range.length;
+    uint64_t newCount = array->count - range.length + replacementCount;
+    
+    // If there isn’t enough room on either side, allocate a bigger buffer before touching anything so that the array is
+    // left unchanged if the allocation fails
+    uint64_t growth = replacementCount > range.length ? replacementCount - range.length : 0;
+    uint64_t newCapacity = 0;
+    PGCObject **newBuffer = NULL;
+    if (growth > PGCArrayGetHeadRoom(array) && growth > PGCArrayGetTailRoom(array)) {
+        newCapacity = PGCArrayGetGrownCapacity(array, newCount);
+        newBuffer = malloc(newCapacity * sizeof(PGCObject *));
+        if (!newBuffer) {
+            if (replacementArray == array) free(replacementObjects);
+            return;
+        }
+    }
+    
+    // Retain the replacement objects before releasing the replaced ones in case some objects are in both sets
+    for (uint64_t i = 0; i < replacementCount; i++) PGCRetain(replacementObjects[i]);
+    for (uint64_t i = range.location; i < range.location + range.length; i++) PGCRelease(array->objects[i]);
+    
+    if (newBuffer) {
+        // Copy the head and tail to their final positions in the new buffer, leaving a gap for the replacement objects
+        if (headCount > 0) memcpy(newBuffer, array->objects, headCount * sizeof(PGCObject *));
+        if (tailCount > 0) {
+            memcpy(&newBuffer[headCount + replacementCount], &array->objects[range.location + range.length], tailCount * sizeof(PGCObject *));
+        }
+        
+        free(array->buffer);
+        array->buffer = newBuffer;
+        array->objects = newBuffer;
+        array->capacity = newCapacity;
+    } else if (replacementCount != range.length) {
+        // Shift whichever of the head or tail has fewer objects, provided there’s room on that side of the buffer
+        bool shiftHead = growth > 0 ? (growth <= PGCArrayGetHeadRoom(array) && (headCount <= tailCount || growth > PGCArrayGetTailRoom(array)))
+                                    : headCount < tailCount;
+        if (shiftHead) {
+            PGCObject **newObjects = array->objects + ((int64_t)range.length - (int64_t)replacementCount);
+            memmove(newObjects, array->objects, headCount * sizeof(PGCObject *));
+            array->objects = newObjects;
+        } else {
+            memmove(&array->objects[range.location + replacementCount], &array->objects[range.location + range.length], 
+                    tailCount * sizeof(PGCObject *));
+        }
+    }
+    
+    if (replacementCount > 0) memcpy(&array->objects[range.location], replacementObjects, replacementCount * sizeof(PGCObject *));
+    if (replacementArray == array) free(replacementObjects);
+
+    array->count = newCount;
+    if (newCount == 0) array->objects = array->buffer;
+    array->hashIsValid = false;
+    PGCArrayInvalidateObjectHashesFromIndex(array, range.location);
 }
 
 
 PGCType PGCArrayPopObject(PGCArray *array)
 {
-    if (!array || array->count == 0) return NULL;
+    if (!array || array->count == 0 || array->isFrozen) return NULL;
     PGCType poppedInstance = PGCArrayGetObjectAtIndex(array, 0);
     PGCArrayRemoveObjectAtIndex(array, 0);
     return poppedInstance;
 }
 
 
+PGCType PGCArrayPopLastObject(PGCArray *array)
+{
+    if (!array || array->count == 0 || array->isFrozen) return NULL;
+    PGCType poppedInstance = PGCArrayGetObjectAtIndex(array, array->count - 1);
+    PGCArrayRemoveObjectAtIndex(array, array->count - 1);
+    return poppedInstance;
+}
+
+
 void PGCArrayRemoveObject(PGCArray *array, PGCType instance)
 {
-    uint64_t indexOfObject; 
-    while ((indexOfObject = PGCArrayGetIndexOfObject(array, instance)) != PGCNotFound) PGCArrayRemoveObjectAtIndex(array, indexOfObject);
+    if (!array || !instance) return;
+    
+    // Don’t give up shared storage unless there’s actually something to remove
+    if (array->storage && PGCArrayGetIndexOfObject(array, instance) == PGCNotFound) return;
+    if (!PGCArrayMakeStorageUnique(array)) return;
+    
+    // Compact the array in a single pass, moving each object we keep down to the next free slot. We retain instance while we
+    // work in case the only thing keeping it alive is our reference to it.
+    PGCRetain(instance);
+    uint64_t instanceHash = PGCHash(instance);
+    
+    // If we cache object hashes, use them for the comparisons and compact them along with the objects
+    uint64_t *objectHashes = array->cachesObjectHashes && PGCArrayCacheObjectHashesToIndex(array, array->count) ? array->objectHashes : NULL;
+    uint64_t keptCount = 0;
+    for (uint64_t i = 0; i < array->count; i++) {
+        PGCObject *object = array->objects[i];
+        uint64_t objectHash = objectHashes ? objectHashes[i] : PGCHash(object);
+        if (objectHash == instanceHash && PGCEquals(instance, object)) {
+            PGCRelease(object);
+        } else {
+            if (objectHashes) objectHashes[keptCount] = objectHash;
+            array->objects[keptCount++] = object;
+        }
+    }
+    
+    if (keptCount != array->count) {
+        array->count = keptCount;
+        if (keptCount == 0) array->objects = array->buffer;
+        array->hashIsValid = false;
+        array->objectHashCount = objectHashes ? keptCount : 0;
+    }
+    
+    PGCRelease(instance);
 }
 
 
 void PGCArrayRemoveObjectAtIndex(PGCArray *array, uint64_t index)
 {
-    if (!array || index >= array->count) return;
+    if (!array || index >= array->count || !PGCArrayMakeStorageUnique(array)) return;
     PGCRelease(array->objects[index]);
     
-    // Shift all the objects starting at index + 1 down one
-    memmove(&array->objects[index], &array->objects[index + 1], (array->count - index - 1) * sizeof(PGCObject *));
-    --array->count;
+    // Close the gap by shifting whichever side of index has fewer objects
+    if (index < array->count / 2) {
+        memmove(&array->objects[1], &array->objects[0], index * sizeof(PGCObject *));
+        array->objects++;
+    } else {
+        memmove(&array->objects[index], &array->objects[index + 1], (array->count - index - 1) * sizeof(PGCObject *));
+    }
+    
+    if (--array->count == 0) array->objects = array->buffer;
+    array->hashIsValid = false;
+    PGCArrayInvalidateObjectHashesFromIndex(array, index);
+}
+
+
+void PGCArrayRemoveObjectsInRange(PGCArray *array, PGCRange range)
+{
+    PGCArrayReplaceObjectsInRange(array, range, NULL);
+}
+
+
+void PGCArrayRemoveObjectsPassingTest(PGCArray *array, PGCIndexedTestBlock test)
+{
+    if (!array || !test || !PGCArrayMakeStorageUnique(array)) return;
+    
+    // Like PGCArrayRemoveObject, this compacts the array in a single pass. Once the test sets stop, we keep all remaining objects.
+    bool stop = false;
+    uint64_t keptCount = 0;
+    uint64_t keptHashCount = 0;
+    for (uint64_t i = 0; i < array->count; i++) {
+        PGCObject *object = array->objects[i];
+        if (!stop && test(object, i, &stop)) {
+            PGCRelease(object);
+        } else {
+            // Cached hashes stay valid for the kept objects that had them, which are a prefix of the kept objects
+            if (i < array->objectHashCount) array->objectHashes[keptHashCount++] = array->objectHashes[i];
+            array->objects[keptCount++] = object;
+        }
+    }
+    
+    if (keptCount != array->count) {
+        array->count = keptCount;
+        if (keptCount == 0) array->objects = array->buffer;
+        array->hashIsValid = false;
+        array->objectHashCount = keptHashCount;
+    }
 }
 
 
 void PGCArrayRemoveAllObjects(PGCArray *array)
 {
-    if (!array) return;
-    for (uint64_t i = 0; i < array->count; i++) PGCRelease(array->objects[i]); 
+    if (!array || array->isFrozen) return;
+    
+    // There’s no need to copy shared storage just to empty it, so simply give it up. Deferring deallocation lets the
+    // objects be deallocated within a single time slice.
+    PGCObjectBeginDeferringDeallocation();
+    if (array->storage) {
+        PGCArrayReleaseStorage(array->storage);
+        array->storage = NULL;
+        array->buffer = NULL;
+        array->capacity = 0;
+    } else {
+        for (uint64_t i = 0; i < array->count; i++) PGCRelease(array->objects[i]); 
+    }
+    
+    array->objects = array->buffer;
     array->count = 0;
+    array->hashIsValid = false;
+    array->objectHashCount = 0;
+    PGCObjectEndDeferringDeallocation();
 }
 
 
@@ -374,10 +889,12 @@ PGCString *PGCArrayJoinComponentsWithString(PGCArray *array, PGCString *separato
     if (!array) return NULL;
     PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
     
+    // Draining periodically keeps the pool from holding every description at once without paying for a drain per component
     PGCString *join = PGCStringInit(NULL);
     for (uint64_t i = 0; i < array->count; i++) {
         PGCStringAppendString(join, PGCDescription(array->objects[i]));
         if (i != array->count - 1) PGCStringAppendString(join, separator);
+        if ((i + 1) % PGCArrayJoinDrainInterval == 0) PGCAutoreleasePoolDrain(pool);
     }
     
     PGCAutoreleasePoolDestroy(pool);
@@ -385,18 +902,926 @@ PGCString *PGCArrayJoinComponentsWithString(PGCArray *array, PGCString *separato
 }
 
 
-#pragma mark Memory Efficiency
+#pragma mark Memory Management
+
+uint64_t PGCArrayGetCapacity(PGCArray *array)
+{
+    return array ? array->capacity : 0;
+}
+
+
+double PGCArrayGetGrowthFactor(PGCArray *array)
+{
+    return array ? array->growthFactor : 0;
+}
+
+
+void PGCArraySetGrowthFactor(PGCArray *array, double growthFactor)
+{
+    // Growth factors that don’t actually grow the array would make every insertion reallocate
+    if (!array || growthFactor <= 1.0 || array->isFrozen) return;
+    array->growthFactor = growthFactor;
+}
+
+
+void PGCArrayReserveCapacity(PGCArray *array, uint64_t capacity)
+{
+    if (!array || capacity <= array->capacity || !PGCArrayMakeStorageUnique(array)) return;
+    PGCArrayReallocateObjects(array, capacity);
+}
+
 
 void PGCArrayCondense(PGCArray *array)
 {
-    if (!array || array->capacity == array->count || (array->count == 0 && array->capacity <= PGCArrayDefaultInitialCapacity)) return;
+    if (!array || !PGCArrayMakeStorageUnique(array)) return;
+    if (array->capacity != array->count) PGCArrayReallocateObjects(array, array->count);
+    
+    if (array->objectHashCount == 0) {
+        free(array->objectHashes);
+        array->objectHashes = NULL;
+        array->objectHashCapacity = 0;
+    } else if (array->objectHashCapacity != array->objectHashCount) {
+        uint64_t *reallocedHashes = realloc(array->objectHashes, array->objectHashCount * sizeof(uint64_t));
+        if (!reallocedHashes) return;
+        array->objectHashes = reallocedHashes;
+        array->objectHashCapacity = array->objectHashCount;
+    }
+}
+
+
+bool PGCArrayGetCachesObjectHashes(PGCArray *array)
+{
+    return array ? array->cachesObjectHashes : false;
+}
 
-    uint64_t newCapacity = array->count != 0 ? array->count : PGCArrayDefaultInitialCapacity;
-    PGCObject **reallocedObjects = realloc(array->objects, newCapacity * sizeof(PGCObject *));
-    if (!reallocedObjects) return;
+
+void PGCArraySetCachesObjectHashes(PGCArray *array, bool cachesObjectHashes)
+{
+    if (!array || array->cachesObjectHashes == cachesObjectHashes || array->isFrozen) return;
+    array->cachesObjectHashes = cachesObjectHashes;
     
-    array->objects = reallocedObjects;
+    // Hashes are computed lazily by the first search that needs them
+    if (!cachesObjectHashes) {
+        free(array->objectHashes);
+        array->objectHashes = NULL;
+        array->objectHashCapacity = 0;
+        array->objectHashCount = 0;
+    }
+}
+
+
+uint64_t PGCArrayGetHeadRoom(PGCArray *array)
+{
+    return array->buffer ? array->objects - array->buffer : 0;
+}
+
+
+uint64_t PGCArrayGetTailRoom(PGCArray *array)
+{
+    return array->capacity - PGCArrayGetHeadRoom(array) - array->count;
+}
+
+
+uint64_t PGCArrayGetGrownCapacity(PGCArray *array, uint64_t minimumCapacity)
+{
+    // The first allocation uses the initial capacity. After that, we grow geometrically so that appending n objects takes
+    // amortized linear time. If the array was created with an increment, it is the minimum number of slots added per growth.
+    uint64_t newCapacity = array->initialCapacity;
+    if (array->capacity > 0) {
+        newCapacity = (uint64_t)(array->capacity * array->growthFactor);
+        if (newCapacity < array->capacity + array->increment) newCapacity = array->capacity + array->increment;
+        if (newCapacity <= array->capacity) newCapacity = array->capacity + 1;
+    }
+    
+    return newCapacity < minimumCapacity ? minimumCapacity : newCapacity;
+}
+
+
+bool PGCArrayReallocateObjects(PGCArray *array, uint64_t capacity)
+{
+    // Move our objects to the start of the buffer so that realloc preserves them
+    if (array->objects != array->buffer) {
+        memmove(array->buffer, array->objects, array->count * sizeof(PGCObject *));
+        array->objects = array->buffer;
+    }
+    
+    // Empty arrays give up their buffer entirely; it will be reallocated lazily on the next insertion
+    if (capacity == 0) {
+        free(array->buffer);
+        array->buffer = NULL;
+        array->objects = NULL;
+        array->capacity = 0;
+        return true;
+    }
+    
+    PGCObject **reallocedBuffer = realloc(array->buffer, capacity * sizeof(PGCObject *));
+    if (!reallocedBuffer) return false;
+    
+    array->buffer = reallocedBuffer;
+    array->objects = reallocedBuffer;
+    array->capacity = capacity;
+    return true;
+}
+
+
+bool PGCArrayGrowToMinimumCapacity(PGCArray *array, uint64_t minimumCapacity)
+{
+    if (minimumCapacity <= array->capacity) return true;
+    return PGCArrayReallocateObjects(array, PGCArrayGetGrownCapacity(array, minimumCapacity));
+}
+
+
+bool PGCArrayMakeRoomForInsertion(PGCArray *array, bool atHead)
+{
+    uint64_t headRoom = PGCArrayGetHeadRoom(array);
+    if (atHead ? headRoom > 0 : PGCArrayGetTailRoom(array) > 0) return true;
+    
+    // When appending to an array whose objects start at the beginning of its buffer, realloc may be able to grow in place
+    if (!atHead && headRoom == 0) return PGCArrayGrowToMinimumCapacity(array, array->count + 1);
+    
+    // Otherwise, we need to reposition our objects within the buffer. If enough of the buffer is free, we reuse it. If not, we
+    // allocate a bigger one. Room for insertions at the head is made by centering the objects in the buffer, while room for
+    // insertions at the tail is made by moving the objects to the start of the buffer. Either way, the number of free slots
+    // created is proportional to the count, so the cost of moving the objects is amortized over subsequent insertions.
+    uint64_t freeSlotCount = array->capacity - array->count;
+    uint64_t newCapacity = freeSlotCount > array->count / 2 ? array->capacity : PGCArrayGetGrownCapacity(array, array->count + 1);
+    uint64_t newHeadRoom = atHead ? (newCapacity - array->count + 1) / 2 : 0;
+
+    if (newCapacity == array->capacity) {
+        memmove(&array->buffer[newHeadRoom], array->objects, array->count * sizeof(PGCObject *));
+        array->objects = &array->buffer[newHeadRoom];
+        return true;
+    }
+    
+    PGCObject **newBuffer = malloc(newCapacity * sizeof(PGCObject *));
+    if (!newBuffer) return false;
+    
+    if (array->count > 0) memcpy(&newBuffer[newHeadRoom], array->objects, array->count * sizeof(PGCObject *));
+    free(array->buffer);
+    
+    array->buffer = newBuffer;
+    array->objects = &newBuffer[newHeadRoom];
     array->capacity = newCapacity;
+    return true;
+}
+
+
+bool PGCArrayCacheObjectHashesToIndex(PGCArray *array, uint64_t endIndex)
+{
+    // Cached hashes are kept for a prefix of the array. Mutations truncate the prefix at the first index they affect, and
+    // searches extend it as far as they need to.
+    if (endIndex <= array->objectHashCount) return true;
+    
+    if (endIndex > array->objectHashCapacity) {
+        uint64_t capacity = array->capacity > endIndex ? array->capacity : endIndex;
+        uint64_t *reallocedHashes = realloc(array->objectHashes, capacity * sizeof(uint64_t));
+        if (!reallocedHashes) return false;
+        array->objectHashes = reallocedHashes;
+        array->objectHashCapacity = capacity;
+    }
+    
+    for (uint64_t i = array->objectHashCount; i < endIndex; i++) array->objectHashes[i] = PGCHash(array->objects[i]);
+    array->objectHashCount = endIndex;
+    return true;
+}
+
+
+void PGCArrayInvalidateObjectHashesFromIndex(PGCArray *array, uint64_t index)
+{
+    if (index < array->objectHashCount) array->objectHashCount = index;
+}
+
+
+#pragma mark Shared Storage
+
+bool PGCArrayShareStorage(PGCArray *array)
+{
+    // An array’s storage records the objects it has retained. Once an array has storage, any number of copies and subarrays may
+    // share its buffer and objects, and none of them may modify either until it has made its storage unique.
+    if (array->storage) return true;
+    
+    PGCArrayStorage *storage = malloc(sizeof(PGCArrayStorage));
+    if (!storage) return false;
+    
+    storage->referenceCount = 1;
+    storage->buffer = array->buffer;
+    storage->objects = array->objects;
+    storage->count = array->count;
+    array->storage = storage;
+    return true;
+}
+
+
+PGCArray *PGCArrayInitWithSharedStorage(PGCArray *array, PGCArray *sourceArray, PGCRange range)
+{
+    array = PGCArrayInit(array);
+    if (!array) return NULL;
+    
+    // Storage may be shared by arrays on different threads, so its reference count is updated atomically
+    __sync_fetch_and_add(&sourceArray->storage->referenceCount, 1);
+    array->storage = sourceArray->storage;
+    array->buffer = sourceArray->buffer;
+    array->objects = &sourceArray->objects[range.location];
+    array->capacity = sourceArray->capacity;
+    array->count = range.length;
+    return array;
+}
+
+
+void PGCArrayReleaseStorage(PGCArrayStorage *storage)
+{
+    if (__sync_sub_and_fetch(&storage->referenceCount, 1) > 0) return;
+    for (uint64_t i = 0; i < storage->count; i++) PGCRelease(storage->objects[i]);
+    free(storage->buffer);
+    free(storage);
+}
+
+
+bool PGCArrayMakeStorageUnique(PGCArray *array)
+{
+    // Every mutation goes through here, so this is where frozen arrays refuse them
+    if (array->isFrozen) return false;
+    
+    PGCArrayStorage *storage = array->storage;
+    if (!storage) return true;
+    
+    // If no other array shares our storage, we can take it over, releasing any objects in it that we don’t contain
+    if (__sync_fetch_and_add(&storage->referenceCount, 0) == 1) {
+        for (PGCObject **object = storage->objects; object < array->objects; object++) PGCRelease(*object);
+        for (PGCObject **object = &array->objects[array->count]; object < &storage->objects[storage->count]; object++) PGCRelease(*object);
+        free(storage);
+        array->storage = NULL;
+        return true;
+    }
+    
+    // Otherwise, copy our objects into a buffer of our own. This is the only place where copies pay for copying.
+    PGCObject **buffer = NULL;
+    if (array->count > 0) {
+        buffer = malloc(array->count * sizeof(PGCObject *));
+        if (!buffer) return false;
+        for (uint64_t i = 0; i < array->count; i++) buffer[i] = PGCRetain(array->objects[i]);
+    }
+    
+    PGCArrayReleaseStorage(storage);
+    array->storage = NULL;
+    array->buffer = buffer;
+    array->objects = buffer;
+    array->capacity = array->count;
+    return true;
+}
+
+
+#pragma mark Freezing
+
+PGCArray *PGCArrayFreeze(PGCArray *array)
+{
+    if (!array) return NULL;
+    if (array->isFrozen) return PGCAutorelease(PGCRetain(array));
+    
+    PGCArray *frozenArray = PGCArrayInitWithInitialCapacity(NULL, array->count);
+    if (!frozenArray) return NULL;
+    
+    // Frozen arrays are sized exactly, with no room at either end
+    if (array->count > 0) {
+        PGCObject **buffer = malloc(array->count * sizeof(PGCObject *));
+        if (!buffer) {
+            PGCRelease(frozenArray);
+            return NULL;
+        }
+        
+        for (uint64_t i = 0; i < array->count; i++) buffer[i] = PGCRetain(array->objects[i]);
+        frozenArray->buffer = buffer;
+        frozenArray->objects = buffer;
+        frozenArray->capacity = array->count;
+        frozenArray->count = array->count;
+    }
+    
+    // Everything that is otherwise computed lazily is computed now, so that reading a frozen array never writes to it. This lets
+    // any number of threads read it without locking.
+    frozenArray->cachesObjectHashes = array->cachesObjectHashes;
+    if ((frozenArray->cachesObjectHashes && !PGCArrayCacheObjectHashesToIndex(frozenArray, frozenArray->count)) ||
+        !PGCArrayShareStorage(frozenArray)) {
+        PGCRelease(frozenArray);
+        return NULL;
+    }
+    
+    PGCArrayHash(frozenArray);
+    frozenArray->isFrozen = true;
+    return PGCAutorelease(frozenArray);
+}
+
+
+bool PGCArrayIsFrozen(PGCArray *array)
+{
+    return array ? array->isFrozen : false;
+}
+
+
+#pragma mark Word Search
+
+uint64_t PGCArrayGetIndexOfWord(const void *words, uint64_t count, uint64_t word)
+{
+    // Searches count 64-bit words for word, returning the index of the first match or count if there is none
+#if defined(__x86_64__)
+    return __atomic_load_n(&PGCArrayGetIndexOfWordImplementation, __ATOMIC_RELAXED)(words, count, word);
+#else
+    for (uint64_t i = 0; i < count; i++) if (PGCArrayGetWord(words, i) == word) return i;
+    return count;
+#endif
+}
+
+
+uint64_t PGCArrayCountWord(const void *words, uint64_t count, uint64_t word)
+{
+#if defined(__x86_64__)
+    return __atomic_load_n(&PGCArrayCountWordImplementation, __ATOMIC_RELAXED)(words, count, word);
+#else
+    uint64_t matchCount = 0;
+    for (uint64_t i = 0; i < count; i++) matchCount += PGCArrayGetWord(words, i) == word;
+    return matchCount;
+#endif
+}
+
+
+uint64_t PGCArrayGetWord(const void *words, uint64_t index)
+{
+    // Words may be object pointers, so we read them with memcpy rather than through a uint64_t pointer
+    uint64_t word;
+    memcpy(&word, (const char *)words + index * sizeof(uint64_t), sizeof(uint64_t));
+    return word;
+}
+
+
+#if defined(__x86_64__)
+uint64_t PGCArrayGetIndexOfWordResolving(const void *words, uint64_t count, uint64_t word)
+{
+    PGCArrayResolveWordSearchFunctions();
+    return PGCArrayGetIndexOfWord(words, count, word);
+}
+
+
+uint64_t PGCArrayCountWordResolving(const void *words, uint64_t count, uint64_t word)
+{
+    PGCArrayResolveWordSearchFunctions();
+    return PGCArrayCountWord(words, count, word);
+}
+
+
+void PGCArrayResolveWordSearchFunctions(void)
+{
+    // Threads that race to get here all store the same functions, so no further synchronization is needed
+    bool supportsAVX2 = __builtin_cpu_supports("avx2");
+    __atomic_store_n(&PGCArrayGetIndexOfWordImplementation, supportsAVX2 ? PGCArrayGetIndexOfWordAVX2 : PGCArrayGetIndexOfWordSSE2,
+                     __ATOMIC_RELAXED);
+    __atomic_store_n(&PGCArrayCountWordImplementation, supportsAVX2 ? PGCArrayCountWordAVX2 : PGCArrayCountWordSSE2, __ATOMIC_RELAXED);
+}
+
+
+uint64_t PGCArrayGetIndexOfWordSSE2(const void *words, uint64_t count, uint64_t word)
+{
+    // SSE2 can only compare 32-bit lanes, so a 64-bit word matches when both of its halves do. Check four words at a time.
+    const __m128i *vectors = words;
+    __m128i needle = _mm_set1_epi64x((int64_t)word);
+    uint64_t i = 0;
+    for (; i + 4 <= count; i += 4, vectors += 2) {
+        __m128i equal01 = _mm_cmpeq_epi32(_mm_loadu_si128(vectors), needle);
+        __m128i equal23 = _mm_cmpeq_epi32(_mm_loadu_si128(vectors + 1), needle);
+        equal01 = _mm_and_si128(equal01, _mm_shuffle_epi32(equal01, _MM_SHUFFLE(2, 3, 0, 1)));
+        equal23 = _mm_and_si128(equal23, _mm_shuffle_epi32(equal23, _MM_SHUFFLE(2, 3, 0, 1)));
+        
+        int mask = _mm_movemask_pd(_mm_castsi128_pd(equal01)) | (_mm_movemask_pd(_mm_castsi128_pd(equal23)) << 2);
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    
+    for (; i < count; i++) if (PGCArrayGetWord(words, i) == word) return i;
+    return count;
+}
+
+
+uint64_t PGCArrayGetIndexOfWordAVX2(const void *words, uint64_t count, uint64_t word)
+{
+    // Check eight words at a time
+    const __m256i *vectors = words;
+    __m256i needle = _mm256_set1_epi64x((int64_t)word);
+    uint64_t i = 0;
+    for (; i + 8 <= count; i += 8, vectors += 2) {
+        __m256i equal0123 = _mm256_cmpeq_epi64(_mm256_loadu_si256(vectors), needle);
+        __m256i equal4567 = _mm256_cmpeq_epi64(_mm256_loadu_si256(vectors + 1), needle);
+        
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(equal0123)) | (_mm256_movemask_pd(_mm256_castsi256_pd(equal4567)) << 4);
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    
+    for (; i < count; i++) if (PGCArrayGetWord(words, i) == word) return i;
+    return count;
+}
+
+
+uint64_t PGCArrayCountWordSSE2(const void *words, uint64_t count, uint64_t word)
+{
+    // Matching lanes are all ones, i.e., -1, so subtracting the comparison results counts the matches in each lane
+    const __m128i *vectors = words;
+    __m128i needle = _mm_set1_epi64x((int64_t)word);
+    __m128i matchCounts = _mm_setzero_si128();
+    uint64_t i = 0;
+    for (; i + 2 <= count; i += 2, vectors++) {
+        __m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128(vectors), needle);
+        equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+        matchCounts = _mm_sub_epi64(matchCounts, equal);
+    }
+    
+    uint64_t laneCounts[2];
+    _mm_storeu_si128((__m128i *)laneCounts, matchCounts);
+    uint64_t matchCount = laneCounts[0] + laneCounts[1];
+    for (; i < count; i++) matchCount += PGCArrayGetWord(words, i) == word;
+    return matchCount;
+}
+
+
+uint64_t PGCArrayCountWordAVX2(const void *words, uint64_t count, uint64_t word)
+{
+    const __m256i *vectors = words;
+    __m256i needle = _mm256_set1_epi64x((int64_t)word);
+    __m256i matchCounts = _mm256_setzero_si256();
+    uint64_t i = 0;
+    for (; i + 4 <= count; i += 4, vectors++) {
+        matchCounts = _mm256_sub_epi64(matchCounts, _mm256_cmpeq_epi64(_mm256_loadu_si256(vectors), needle));
+    }
+    
+    uint64_t laneCounts[4];
+    _mm256_storeu_si256((__m256i *)laneCounts, matchCounts);
+    uint64_t matchCount = laneCounts[0] + laneCounts[1] + laneCounts[2] + laneCounts[3];
+    for (; i < count; i++) matchCount += PGCArrayGetWord(words, i) == word;
+    return matchCount;
+}
+#endif
+
+
+#pragma mark Sorting
+
+void PGCArraySortUsingComparator(PGCArray *array, PGCComparator comparator)
+{
+    PGCArraySortWithOptionsUsingComparator(array, 0, comparator);
+}
+
+
+void PGCArrayStableSortUsingComparator(PGCArray *array, PGCComparator comparator)
+{
+    PGCArraySortWithOptionsUsingComparator(array, PGCSortStable, comparator);
+}
+
+
+void PGCArraySortWithOptionsUsingComparator(PGCArray *array, PGCSortOptions options, PGCComparator comparator)
+{
+    if (!array || !comparator) return;
+    PGCArraySortContext context = { comparator, 0 };
+    PGCArraySortObjectsWithContext(array, options, &context);
+}
+
+
+void PGCArraySortUsingDescriptor(PGCArray *array, PGCSortDescriptor descriptor)
+{
+    if (!array || descriptor > PGCSortDescriptorCaseInsensitiveStringDescending) return;
+    PGCArraySortContext context = { NULL, descriptor };
+    PGCArraySortObjectsWithContext(array, PGCSortStable, &context);
+}
+
+
+void PGCArraySortObjectsWithContext(PGCArray *array, PGCSortOptions options, PGCArraySortContext *context)
+{
+    if (array->count < 2 || !PGCArrayMakeStorageUnique(array)) return;
+    
+    // Unstable sorts use pattern-defeating quicksort, which sorts in place and is very fast on common input patterns. Stable
+    // sorts use merge sort, which needs a scratch buffer the size of the array. Large concurrent sorts are split into chunks
+    // that are sorted and merged on the global concurrent queue.
+    if ((options & PGCSortConcurrent) && array->count >= PGCArrayConcurrentSortThreshold) {
+        PGCArrayParallelMergeSort(array->objects, array->count, context);
+    } else if (options & PGCSortStable) {
+        PGCArrayMergeSort(array->objects, array->count, context);
+    } else {
+        PGCArrayQuickSort(array->objects, array->count, context, PGCArrayGetFloorLog2(array->count), true);
+    }
+    
+    array->hashIsValid = false;
+    array->objectHashCount = 0;
+}
+
+
+PGCComparisonResult PGCArraySortContextCompare(PGCArraySortContext *context, PGCObject *object1, PGCObject *object2)
+{
+    if (context->comparator) return context->comparator(object1, object2);
+
+    // Descending descriptors have odd values
+    bool descending = context->descriptor & 1;
+    switch (context->descriptor) {
+        case PGCSortDescriptorNumericAscending:
+        case PGCSortDescriptorNumericDescending:
+            return PGCArrayCompareNumbers(object1, object2, descending);
+        case PGCSortDescriptorStringAscending:
+        case PGCSortDescriptorStringDescending:
+            return PGCArrayCompareStrings(object1, object2, false, descending);
+        default:
+            return PGCArrayCompareStrings(object1, object2, true, descending);
+    }
+}
+
+
+PGCComparisonResult PGCArrayCompareNumbers(PGCObject *object1, PGCObject *object2, bool descending)
+{
+    // Numbers sort before objects that aren’t numbers regardless of direction. Objects that aren’t numbers are considered equal.
+    bool isNumber1 = PGCArrayIsNumber(object1);
+    bool isNumber2 = PGCArrayIsNumber(object2);
+    if (!isNumber1 || !isNumber2) return isNumber1 == isNumber2 ? PGCOrderedSame : (isNumber1 ? PGCOrderedAscending : PGCOrderedDescending);
+
+    PGCComparisonResult result = PGCOrderedSame;
+    
+    // Compare integers exactly, taking their signedness into account. Everything else is compared as a double.
+    if (PGCObjectGetClass(object1) == PGCIntegerClass() && PGCObjectGetClass(object2) == PGCIntegerClass()) {
+        PGCInteger *integer1 = (PGCInteger *)object1;
+        PGCInteger *integer2 = (PGCInteger *)object2;
+        bool isNegative1 = PGCIntegerIsSigned(integer1) && PGCIntegerGetSignedValue(integer1) < 0;
+        bool isNegative2 = PGCIntegerIsSigned(integer2) && PGCIntegerGetSignedValue(integer2) < 0;
+        if (isNegative1 != isNegative2) {
+            result = isNegative1 ? PGCOrderedAscending : PGCOrderedDescending;
+        } else {
+            // With the same sign, the unsigned bit patterns of both values order the same way their values do
+            uint64_t value1 = PGCIntegerGetUnsignedValue(integer1);
+            uint64_t value2 = PGCIntegerGetUnsignedValue(integer2);
+            result = value1 < value2 ? PGCOrderedAscending : (value1 > value2 ? PGCOrderedDescending : PGCOrderedSame);
+        }
+    } else {
+        double value1 = PGCArrayGetNumberValue(object1);
+        double value2 = PGCArrayGetNumberValue(object2);
+        result = value1 < value2 ? PGCOrderedAscending : (value1 > value2 ? PGCOrderedDescending : PGCOrderedSame);
+    }
+    
+    return descending ? -result : result;
+}
+
+
+bool PGCArrayIsNumber(PGCObject *object)
+{
+    PGCClass *class = PGCObjectGetClass(object);
+    return class == PGCIntegerClass() || class == PGCDecimalClass() || class == PGCBooleanClass() || class == PGCCharacterClass();
+}
+
+
+double PGCArrayGetNumberValue(PGCObject *object)
+{
+    PGCClass *class = PGCObjectGetClass(object);
+    if (class == PGCIntegerClass()) {
+        PGCInteger *integer = (PGCInteger *)object;
+        return PGCIntegerIsSigned(integer) ? (double)PGCIntegerGetSignedValue(integer) : (double)PGCIntegerGetUnsignedValue(integer);
+    } else if (class == PGCDecimalClass()) {
+        return PGCDecimalGetValue((PGCDecimal *)object);
+    } else if (class == PGCBooleanClass()) {
+        return PGCBooleanGetValue((PGCBoolean *)object) ? 1 : 0;
+    } else if (class == PGCCharacterClass()) {
+        return PGCCharacterGetValue((PGCCharacter *)object);
+    }
+    
+    return 0;
+}
+
+
+PGCComparisonResult PGCArrayCompareStrings(PGCObject *object1, PGCObject *object2, bool caseInsensitive, bool descending)
+{
+    // Strings sort before objects that aren’t strings regardless of direction. Objects that aren’t strings are considered equal.
+    bool isString1 = PGCObjectIsKindOfClass(object1, PGCStringClass());
+    bool isString2 = PGCObjectIsKindOfClass(object2, PGCStringClass());
+    if (!isString1 || !isString2) return isString1 == isString2 ? PGCOrderedSame : (isString1 ? PGCOrderedAscending : PGCOrderedDescending);
+
+    const char *cString1 = PGCStringGetCString((PGCString *)object1);
+    const char *cString2 = PGCStringGetCString((PGCString *)object2);
+    int result = caseInsensitive ? strcasecmp(cString1, cString2) : strcmp(cString1, cString2);
+    if (descending) result = -result;
+    return result < 0 ? PGCOrderedAscending : (result > 0 ? PGCOrderedDescending : PGCOrderedSame);
+}
+
+
+uint64_t PGCArrayGetFloorLog2(uint64_t value)
+{
+    uint64_t log = 0;
+    while (value >>= 1) log++;
+    return log;
+}
+
+
+void PGCArrayInsertionSort(PGCObject **objects, uint64_t count, PGCArraySortContext *context)
+{
+    for (uint64_t i = 1; i < count; i++) {
+        PGCObject *object = objects[i];
+        uint64_t j = i;
+        while (j > 0 && PGCArraySortContextCompare(context, object, objects[j - 1]) < 0) {
+            objects[j] = objects[j - 1];
+            j--;
+        }
+        
+        objects[j] = object;
+    }
+}
+
+
+bool PGCArrayPartialInsertionSort(PGCObject **objects, uint64_t count, PGCArraySortContext *context)
+{
+    // Like an insertion sort, but gives up once it has moved more than a small number of objects. This quickly finishes
+    // sorting ranges that are already nearly sorted without risking quadratic behavior on ranges that aren’t.
+    uint64_t moveCount = 0;
+    for (uint64_t i = 1; i < count; i++) {
+        if (moveCount > PGCArrayPartialInsertionSortLimit) return false;
+        
+        PGCObject *object = objects[i];
+        uint64_t j = i;
+        while (j > 0 && PGCArraySortContextCompare(context, object, objects[j - 1]) < 0) {
+            objects[j] = objects[j - 1];
+            j--;
+        }
+        
+        objects[j] = object;
+        moveCount += i - j;
+    }
+    
+    return true;
+}
+
+
+void PGCArraySwapObjects(PGCObject **objects, uint64_t index1, uint64_t index2)
+{
+    PGCObject *object = objects[index1];
+    objects[index1] = objects[index2];
+    objects[index2] = object;
+}
+
+
+void PGCArraySortThreeObjects(PGCObject **objects, uint64_t index1, uint64_t index2, uint64_t index3, PGCArraySortContext *context)
+{
+    if (PGCArraySortContextCompare(context, objects[index2], objects[index1]) < 0) PGCArraySwapObjects(objects, index1, index2);
+    if (PGCArraySortContextCompare(context, objects[index3], objects[index2]) < 0) {
+        PGCArraySwapObjects(objects, index2, index3);
+        if (PGCArraySortContextCompare(context, objects[index2], objects[index1]) < 0) PGCArraySwapObjects(objects, index1, index2);
+    }
+}
+
+
+void PGCArrayHeapSort(PGCObject **objects, uint64_t count, PGCArraySortContext *context)
+{
+    for (uint64_t i = count / 2; i > 0; i--) PGCArraySiftDown(objects, i - 1, count, context);
+    for (uint64_t end = count - 1; end > 0; end--) {
+        PGCArraySwapObjects(objects, 0, end);
+        PGCArraySiftDown(objects, 0, end, context);
+    }
+}
+
+
+void PGCArraySiftDown(PGCObject **objects, uint64_t root, uint64_t count, PGCArraySortContext *context)
+{
+    uint64_t child;
+    while ((child = 2 * root + 1) < count) {
+        if (child + 1 < count && PGCArraySortContextCompare(context, objects[child], objects[child + 1]) < 0) child++;
+        if (PGCArraySortContextCompare(context, objects[root], objects[child]) >= 0) return;
+        PGCArraySwapObjects(objects, root, child);
+        root = child;
+    }
+}
+
+
+uint64_t PGCArrayPartitionRight(PGCObject **objects, uint64_t count, PGCArraySortContext *context, bool *alreadyPartitioned)
+{
+    // Partitions objects around the pivot in objects[0] so that objects less than the pivot come before it and all others come
+    // after it. The median-of-three pivot selection guarantees that an object at least as large as the pivot is at the end of
+    // the range, which bounds the first scan.
+    PGCObject *pivot = objects[0];
+    uint64_t first = 0;
+    uint64_t last = count;
+    
+    while (PGCArraySortContextCompare(context, objects[++first], pivot) < 0);
+    
+    if (first == 1) {
+        while (first < last && PGCArraySortContextCompare(context, objects[--last], pivot) >= 0);
+    } else {
+        while (PGCArraySortContextCompare(context, objects[--last], pivot) >= 0);
+    }
+    
+    // If the first pair of objects that needs to be swapped is already out of order, no swaps are needed at all
+    *alreadyPartitioned = first >= last;
+    
+    while (first < last) {
+        PGCArraySwapObjects(objects, first, last);
+        while (PGCArraySortContextCompare(context, objects[++first], pivot) < 0);
+        while (PGCArraySortContextCompare(context, objects[--last], pivot) >= 0);
+    }
+    
+    uint64_t pivotIndex = first - 1;
+    objects[0] = objects[pivotIndex];
+    objects[pivotIndex] = pivot;
+    return pivotIndex;
+}
+
+
+uint64_t PGCArrayPartitionLeft(PGCObject **objects, uint64_t count, PGCArraySortContext *context)
+{
+    // Partitions objects so that objects equal to the pivot come first. This is only used when the object preceding the range
+    // is equal to the pivot, in which case every object in the left partition is equal to the pivot and needs no more sorting.
+    PGCObject *pivot = objects[0];
+    uint64_t first = 0;
+    uint64_t last = count;
+    
+    while (PGCArraySortContextCompare(context, pivot, objects[--last]) < 0);
+    
+    if (last + 1 == count) {
+        while (first < last && PGCArraySortContextCompare(context, pivot, objects[++first]) >= 0);
+    } else {
+        while (PGCArraySortContextCompare(context, pivot, objects[++first]) >= 0);
+    }
+    
+    while (first < last) {
+        PGCArraySwapObjects(objects, first, last);
+        while (PGCArraySortContextCompare(context, pivot, objects[--last]) < 0);
+        while (PGCArraySortContextCompare(context, pivot, objects[++first]) >= 0);
+    }
+    
+    objects[0] = objects[last];
+    objects[last] = pivot;
+    return last;
+}
+
+
+void PGCArrayQuickSort(PGCObject **objects, uint64_t count, PGCArraySortContext *context, uint64_t badPartitionsAllowed, bool leftmost)
+{
+    // This is a C port of the core of Orson Peters’ pattern-defeating quicksort. It is an introsort that also detects already
+    // partitioned ranges and ranges with many equal objects, and shuffles objects around when it chooses bad pivots to break up
+    // the patterns that cause them.
+    while (count >= PGCArrayInsertionSortThreshold) {
+        // Choose the pivot using the median of three, or for large ranges, the pseudomedian of nine. The result is in objects[0].
+        uint64_t middle = count / 2;
+        if (count > PGCArrayNintherThreshold) {
+            PGCArraySortThreeObjects(objects, 0, middle, count - 1, context);
+            PGCArraySortThreeObjects(objects, 1, middle - 1, count - 2, context);
+            PGCArraySortThreeObjects(objects, 2, middle + 1, count - 3, context);
+            PGCArraySortThreeObjects(objects, middle - 1, middle, middle + 1, context);
+            PGCArraySwapObjects(objects, 0, middle);
+        } else {
+            PGCArraySortThreeObjects(objects, middle, 0, count - 1, context);
+        }
+        
+        // If the object before this range is equal to the pivot, so are all the objects that would go to the left of it
+        if (!leftmost && PGCArraySortContextCompare(context, objects[-1], objects[0]) >= 0) {
+            uint64_t pivotIndex = PGCArrayPartitionLeft(objects, count, context);
+            objects += pivotIndex + 1;
+            count -= pivotIndex + 1;
+            continue;
+        }
+        
+        bool alreadyPartitioned = false;
+        uint64_t pivotIndex = PGCArrayPartitionRight(objects, count, context, &alreadyPartitioned);
+        uint64_t leftCount = pivotIndex;
+        uint64_t rightCount = count - pivotIndex - 1;
+        PGCObject **right = objects + pivotIndex + 1;
+        
+        if (leftCount < count / 8 || rightCount < count / 8) {
+            // The partition was highly unbalanced. After too many of these, fall back to heap sort to guarantee O(n log n).
+            if (badPartitionsAllowed-- == 0) {
+                PGCArrayHeapSort(objects, count, context);
+                return;
+            }
+            
+            // Otherwise, swap some objects around to break up whatever pattern caused the bad pivot
+            if (leftCount >= PGCArrayInsertionSortThreshold) {
+                PGCArraySwapObjects(objects, 0, leftCount / 4);
+                PGCArraySwapObjects(objects, pivotIndex - 1, pivotIndex - leftCount / 4);
+            }
+            
+            if (rightCount >= PGCArrayInsertionSortThreshold) {
+                PGCArraySwapObjects(right, 0, rightCount / 4);
+                PGCArraySwapObjects(right, rightCount - 1, rightCount - rightCount / 4);
+            }
+        } else if (alreadyPartitioned && PGCArrayPartialInsertionSort(objects, leftCount, context) &&
+                   PGCArrayPartialInsertionSort(right, rightCount, context)) {
+            // The range was already partitioned and both sides turned out to be nearly sorted, so we’re done
+            return;
+        }
+        
+        // Recurse into the smaller side and loop on the larger one to keep the stack depth logarithmic
+        if (leftCount < rightCount) {
+            PGCArrayQuickSort(objects, leftCount, context, badPartitionsAllowed, leftmost);
+            objects = right;
+            count = rightCount;
+            leftmost = false;
+        } else {
+            PGCArrayQuickSort(right, rightCount, context, badPartitionsAllowed, false);
+            count = leftCount;
+        }
+    }
+    
+    PGCArrayInsertionSort(objects, count, context);
+}
+
+
+void PGCArrayMerge(PGCObject **left, uint64_t leftCount, PGCObject **right, uint64_t rightCount, PGCObject **destination,
+                   PGCArraySortContext *context)
+{
+    // Take from the left run unless the right run’s object is strictly smaller, which keeps the merge stable
+    uint64_t i = 0, j = 0, k = 0;
+    while (i < leftCount && j < rightCount) {
+        destination[k++] = PGCArraySortContextCompare(context, right[j], left[i]) < 0 ? right[j++] : left[i++];
+    }
+    
+    memcpy(&destination[k], &left[i], (leftCount - i) * sizeof(PGCObject *));
+    memcpy(&destination[k + leftCount - i], &right[j], (rightCount - j) * sizeof(PGCObject *));
+}
+
+
+void PGCArrayMergeSortWithBuffer(PGCObject **objects, uint64_t count, PGCObject **buffer, PGCArraySortContext *context)
+{
+    // Bottom-up merge sort: insertion sort small runs in place, then merge runs of doubling width back and forth between objects
+    // and buffer
+    for (uint64_t start = 0; start < count; start += PGCArrayInsertionSortThreshold) {
+        uint64_t runCount = count - start < PGCArrayInsertionSortThreshold ? count - start : PGCArrayInsertionSortThreshold;
+        PGCArrayInsertionSort(&objects[start], runCount, context);
+    }
+    
+    PGCObject **source = objects;
+    PGCObject **destination = buffer;
+    for (uint64_t width = PGCArrayInsertionSortThreshold; width < count; width *= 2) {
+        for (uint64_t start = 0; start < count; start += 2 * width) {
+            uint64_t leftCount = count - start < width ? count - start : width;
+            uint64_t rightCount = count - start - leftCount < width ? count - start - leftCount : width;
+            PGCArrayMerge(&source[start], leftCount, &source[start + leftCount], rightCount, &destination[start], context);
+        }
+        
+        PGCObject **swap = source;
+        source = destination;
+        destination = swap;
+    }
+    
+    if (source != objects) memcpy(objects, source, count * sizeof(PGCObject *));
+}
+
+
+void PGCArrayMergeSort(PGCObject **objects, uint64_t count, PGCArraySortContext *context)
+{
+    PGCObject **buffer = malloc(count * sizeof(PGCObject *));
+    if (!buffer) {
+        // Fall back to a stable insertion sort rather than leaving the array unsorted
+        PGCArrayInsertionSort(objects, count, context);
+        return;
+    }
+    
+    PGCArrayMergeSortWithBuffer(objects, count, buffer, context);
+    free(buffer);
+}
+
+
+void PGCArrayParallelMergeSort(PGCObject **objects, uint64_t count, PGCArraySortContext *context)
+{
+    PGCObject **buffer = malloc(count * sizeof(PGCObject *));
+    if (!buffer) {
+        PGCArrayInsertionSort(objects, count, context);
+        return;
+    }
+    
+    // Sort chunks concurrently, then merge pairs of neighboring runs concurrently at each level until one run is left
+    PGCArrayParallelSortState state = { objects, buffer, count, PGCArrayConcurrentSortChunkSize, context };
+    uint64_t chunkCount = (count + state.width - 1) / state.width;
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+    dispatch_apply_f(chunkCount, queue, &state, PGCArraySortChunk);
+    
+    for (; state.width < count; state.width *= 2) {
+        dispatch_apply_f((count + 2 * state.width - 1) / (2 * state.width), queue, &state, PGCArrayMergeChunks);
+        
+        PGCObject **swap = state.source;
+        state.source = state.destination;
+        state.destination = swap;
+    }
+    
+    if (state.source != objects) memcpy(objects, state.source, count * sizeof(PGCObject *));
+    free(buffer);
+}
+
+
+void PGCArraySortChunk(void *context, size_t chunkIndex)
+{
+    PGCArrayParallelSortState *state = context;
+    uint64_t start = chunkIndex * state->width;
+    uint64_t chunkCount = state->count - start < state->width ? state->count - start : state->width;
+    
+    // Comparators may autorelease objects, and this may be running on a thread without an autorelease pool
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+    PGCArrayMergeSortWithBuffer(&state->source[start], chunkCount, &state->destination[start], state->context);
+    PGCAutoreleasePoolDestroy(pool);
+}
+
+
+void PGCArrayMergeChunks(void *context, size_t pairIndex)
+{
+    PGCArrayParallelSortState *state = context;
+    uint64_t start = pairIndex * 2 * state->width;
+    uint64_t leftCount = state->count - start < state->width ? state->count - start : state->width;
+    uint64_t rightCount = state->count - start - leftCount < state->width ? state->count - start - leftCount : state->width;
+    
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+    PGCArrayMerge(&state->source[start], leftCount, &state->source[start + leftCount], rightCount, &state->destination[start], state->context);
+    PGCAutoreleasePoolDestroy(pool);
 }
 
 
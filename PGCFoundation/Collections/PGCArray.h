@@ -47,10 +47,13 @@ extern PGCType PGCArrayCopy(PGCType instance);
 extern PGCString *PGCArrayDescription(PGCType instance);
 extern bool PGCArrayEquals(PGCType instance1, PGCType instance2);
 extern uint64_t PGCArrayHash(PGCType instance);
+extern bool PGCArrayEncode(PGCType instance, PGCArchiver *archiver);
+extern PGCType PGCArrayDecode(PGCClass *class, PGCUnarchiver *unarchiver);
 
 #pragma mark Accessors
 
 extern uint64_t PGCArrayGetCount(PGCArray *array);
+extern const PGCType *PGCArrayGetObjects(PGCArray *array);
 extern bool PGCArrayContainsObject(PGCArray *array, PGCType instance);
 
 extern PGCType PGCArrayGetObjectAtIndex(PGCArray *array, uint64_t index);
@@ -61,6 +64,12 @@ extern uint64_t PGCArrayGetIndexOfObject(PGCArray *array, PGCType instance);
 extern uint64_t PGCArrayGetIndexOfObjectInRange(PGCArray *array, PGCType instance, PGCRange range);
 extern uint64_t PGCArrayGetIndexOfIdenticalObject(PGCArray *array, PGCType instance);
 extern uint64_t PGCArrayGetIndexOfIdenticalObjectInRange(PGCArray *array, PGCType instance, PGCRange range);
+extern uint64_t PGCArrayCountIdenticalObjects(PGCArray *array, PGCType instance);
+extern uint64_t PGCArrayCountIdenticalObjectsInRange(PGCArray *array, PGCType instance, PGCRange range);
+
+extern uint64_t PGCArrayGetIndexOfObjectInSortedRange(PGCArray *array, PGCType instance, PGCRange range, PGCComparator comparator);
+extern uint64_t PGCArrayGetLowerBoundOfObjectInSortedRange(PGCArray *array, PGCType instance, PGCRange range, PGCComparator comparator);
+extern uint64_t PGCArrayGetUpperBoundOfObjectInSortedRange(PGCArray *array, PGCType instance, PGCRange range, PGCComparator comparator);
 
 #pragma mark Subarrays
 
@@ -70,15 +79,21 @@ extern PGCArray *PGCArraySubarrayWithRange(PGCArray *array, PGCRange range);
 
 extern void PGCArrayAddObject(PGCArray *array, PGCType instance);
 extern void PGCArrayInsertObjectAtIndex(PGCArray *array, PGCType instance, uint64_t index);
+extern void PGCArrayInsertObjectsFromArrayAtIndex(PGCArray *array, PGCArray *otherArray, uint64_t index);
+extern uint64_t PGCArrayInsertObjectSorted(PGCArray *array, PGCType instance, PGCComparator comparator);
 extern void PGCArrayPushObject(PGCArray *array, PGCType instance);
 
 extern void PGCArrayExchangeValuesAtIndices(PGCArray *array, uint64_t index1, uint64_t index2);
 
 extern void PGCArrayReplaceObjectAtIndex(PGCArray *array, PGCType instance, uint64_t index);
+extern void PGCArrayReplaceObjectsInRange(PGCArray *array, PGCRange range, PGCArray *replacementArray);
 
 extern PGCType PGCArrayPopObject(PGCArray *array);
+extern PGCType PGCArrayPopLastObject(PGCArray *array);
 extern void PGCArrayRemoveObject(PGCArray *array, PGCType instance);
 extern void PGCArrayRemoveObjectAtIndex(PGCArray *array, uint64_t index);
+extern void PGCArrayRemoveObjectsInRange(PGCArray *array, PGCRange range);
+extern void PGCArrayRemoveObjectsPassingTest(PGCArray *array, PGCIndexedTestBlock test);
 extern void PGCArrayRemoveAllObjects(PGCArray *array);
 
 #pragma mark String Conversion
@@ -86,10 +101,31 @@ extern void PGCArrayRemoveAllObjects(PGCArray *array);
 extern PGCString *PGCArrayJoinComponentsWithString(PGCArray *array, PGCString *separator);
 
 
-#pragma mark Memory Efficiency
+#pragma mark Memory Management
 
+extern uint64_t PGCArrayGetCapacity(PGCArray *array);
+extern double PGCArrayGetGrowthFactor(PGCArray *array);
+extern void PGCArraySetGrowthFactor(PGCArray *array, double growthFactor);
+extern void PGCArrayReserveCapacity(PGCArray *array, uint64_t capacity);
 extern void PGCArrayCondense(PGCArray *array);
 
+// An array that caches object hashes skips any object whose cached hash doesn’t match when searching. Objects in it must
+// not be mutated while caching is on; turn caching off and back on to recompute the hashes after changing one.
+extern bool PGCArrayGetCachesObjectHashes(PGCArray *array);
+extern void PGCArraySetCachesObjectHashes(PGCArray *array, bool cachesObjectHashes);
+
+#pragma mark Freezing
+
+extern PGCArray *PGCArrayFreeze(PGCArray *array);
+extern bool PGCArrayIsFrozen(PGCArray *array);
+
+#pragma mark Sorting
+
+extern void PGCArraySortUsingComparator(PGCArray *array, PGCComparator comparator);
+extern void PGCArrayStableSortUsingComparator(PGCArray *array, PGCComparator comparator);
+extern void PGCArraySortWithOptionsUsingComparator(PGCArray *array, PGCSortOptions options, PGCComparator comparator);
+extern void PGCArraySortUsingDescriptor(PGCArray *array, PGCSortDescriptor descriptor);
+
 #pragma mark Enumeration
 
 extern void PGCArrayEnumerateObjectsWithBlock(PGCArray *array, PGCEnumerationOptions options, PGCIndexedEnumerationBlock block);
@@ -0,0 +1,367 @@
+//
+//  PGCConcurrentQueue.c
+//  PGCFoundation
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <PGCFoundation/PGCConcurrentQueue.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+// The queue is a bounded ring of cells, each with a sequence number that says whose turn it is to use the cell. A producer may
+// fill the cell for position p when its sequence is p, and a consumer may empty it when its sequence is p + 1. Producers and
+// consumers claim positions by advancing their own counter with a compare-and-swap, so neither side ever takes a lock.
+typedef struct _PGCConcurrentQueueCell {
+    uint64_t sequence;
+    PGCType object;
+} PGCConcurrentQueueCell;
+
+
+struct _PGCConcurrentQueue {
+    PGCObject super;
+    
+    PGCConcurrentQueueCell *cells;
+    uint64_t mask;
+    
+    // Keep the two counters on separate cache lines so that producers and consumers don’t contend for the same line
+    char enqueuePadding[64];
+    uint64_t enqueuePosition;
+    char dequeuePadding[64 - sizeof(uint64_t)];
+    uint64_t dequeuePosition;
+    char waitPadding[64 - sizeof(uint64_t)];
+    
+    // Only used by the blocking functions once they have given up spinning
+    pthread_mutex_t waitMutex;
+    pthread_cond_t notEmptyCondition;
+    pthread_cond_t notFullCondition;
+    uint64_t waitingConsumerCount;
+    uint64_t waitingProducerCount;
+};
+
+
+#pragma mark Private Global Constants
+
+static const uint64_t PGCConcurrentQueueDefaultCapacity = 1024;
+static const uint64_t PGCConcurrentQueueMaximumCapacity = 1ULL << 32;
+static const uint64_t PGCConcurrentQueueSpinCount = 64;
+static const uint64_t PGCConcurrentQueueYieldCount = 16;
+
+
+#pragma mark Private Function Interfaces
+
+void PGCConcurrentQueueDealloc(PGCType instance);
+void PGCConcurrentQueueWaitToPushObject(PGCConcurrentQueue *queue, PGCType instance, bool retainsObject);
+bool PGCConcurrentQueuePushObject(PGCConcurrentQueue *queue, PGCType instance, bool retainsObject);
+PGCType PGCConcurrentQueuePopObject(PGCConcurrentQueue *queue);
+void PGCConcurrentQueueWakeWaiter(PGCConcurrentQueue *queue, uint64_t *waitingCount, pthread_cond_t *condition);
+void PGCConcurrentQueuePause(uint64_t attempt);
+
+
+#pragma mark -
+
+PGCClass *PGCConcurrentQueueClass(void)
+{
+    static PGCClass *queueClass = NULL;
+    if (!queueClass) {
+        PGCClassFunctions functions = { NULL, PGCConcurrentQueueDealloc, PGCConcurrentQueueDescription, NULL, NULL, NULL, NULL };
+        queueClass = PGCClassCreate("PGCConcurrentQueue", PGCObjectClass(), functions, sizeof(PGCConcurrentQueue));
+    }
+    return queueClass;
+}
+
+
+PGCConcurrentQueue *PGCConcurrentQueueInstance(void)
+{
+    return PGCAutorelease(PGCConcurrentQueueInit(NULL));
+}
+
+
+#pragma mark Basic Functions
+
+PGCConcurrentQueue *PGCConcurrentQueueInit(PGCConcurrentQueue *queue)
+{
+    return PGCConcurrentQueueInitWithCapacity(queue, PGCConcurrentQueueDefaultCapacity);
+}
+
+
+PGCConcurrentQueue *PGCConcurrentQueueInitWithCapacity(PGCConcurrentQueue *queue, uint64_t capacity)
+{
+    if (!queue && (queue = PGCAlloc(PGCConcurrentQueueClass())) == NULL) return NULL;
+    PGCObjectInit(&queue->super);
+    
+    // Round the capacity up to a power of two so that positions map to cells with a mask
+    if (capacity > PGCConcurrentQueueMaximumCapacity) capacity = PGCConcurrentQueueMaximumCapacity;
+    uint64_t cellCount = 2;
+    while (cellCount < capacity) cellCount <<= 1;
+    
+    queue->cells = malloc(cellCount * sizeof(PGCConcurrentQueueCell));
+    if (!queue->cells) {
+        PGCRelease(queue);
+        return NULL;
+    }
+    
+    for (uint64_t i = 0; i < cellCount; i++) {
+        queue->cells[i].sequence = i;
+        queue->cells[i].object = NULL;
+    }
+    
+    queue->mask = cellCount - 1;
+    queue->enqueuePosition = 0;
+    queue->dequeuePosition = 0;
+    
+    pthread_mutex_init(&queue->waitMutex, NULL);
+    pthread_cond_init(&queue->notEmptyCondition, NULL);
+    pthread_cond_init(&queue->notFullCondition, NULL);
+    return queue;
+}
+
+
+void PGCConcurrentQueueDealloc(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCConcurrentQueueClass())) return;
+    PGCConcurrentQueue *queue = instance;
+    
+    if (queue->cells) {
+        PGCType object;
+        while ((object = PGCConcurrentQueuePopObject(queue))) PGCRelease(object);
+        free(queue->cells);
+        
+        pthread_mutex_destroy(&queue->waitMutex);
+        pthread_cond_destroy(&queue->notEmptyCondition);
+        pthread_cond_destroy(&queue->notFullCondition);
+    }
+    
+    PGCSuperclassDealloc(instance);
+}
+
+
+PGCString *PGCConcurrentQueueDescription(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCConcurrentQueueClass())) return NULL;
+    return PGCStringInstanceWithFormat("<PGCConcurrentQueue %p: %llu objects>", instance, PGCConcurrentQueueGetCount(instance));
+}
+
+
+#pragma mark Accessors
+
+uint64_t PGCConcurrentQueueGetCapacity(PGCConcurrentQueue *queue)
+{
+    return queue ? queue->mask + 1 : 0;
+}
+
+
+uint64_t PGCConcurrentQueueGetCount(PGCConcurrentQueue *queue)
+{
+    if (!queue) return 0;
+    
+    // The count is a snapshot. Read the dequeue position first so that the difference can't go negative.
+    uint64_t dequeuePosition = __atomic_load_n(&queue->dequeuePosition, __ATOMIC_ACQUIRE);
+    uint64_t enqueuePosition = __atomic_load_n(&queue->enqueuePosition, __ATOMIC_ACQUIRE);
+    return enqueuePosition - dequeuePosition;
+}
+
+
+#pragma mark Enqueueing and Dequeueing
+
+void PGCConcurrentQueueEnqueueObject(PGCConcurrentQueue *queue, PGCType instance)
+{
+    if (!queue || !instance) return;
+    PGCConcurrentQueueWaitToPushObject(queue, instance, true);
+}
+
+
+void PGCConcurrentQueueEnqueueRetainedObject(PGCConcurrentQueue *queue, PGCType instance)
+{
+    // The caller’s reference becomes the queue’s, so an object that can’t be enqueued at all is released
+    if (!instance) return;
+    if (!queue) {
+        PGCRelease(instance);
+        return;
+    }
+    
+    PGCConcurrentQueueWaitToPushObject(queue, instance, false);
+}
+
+
+bool PGCConcurrentQueueTryEnqueueObject(PGCConcurrentQueue *queue, PGCType instance)
+{
+    if (!queue || !instance || !PGCConcurrentQueuePushObject(queue, instance, true)) return false;
+    PGCConcurrentQueueWakeWaiter(queue, &queue->waitingConsumerCount, &queue->notEmptyCondition);
+    return true;
+}
+
+
+bool PGCConcurrentQueueTryEnqueueRetainedObject(PGCConcurrentQueue *queue, PGCType instance)
+{
+    // If the queue is full, the caller keeps its reference
+    if (!queue || !instance || !PGCConcurrentQueuePushObject(queue, instance, false)) return false;
+    PGCConcurrentQueueWakeWaiter(queue, &queue->waitingConsumerCount, &queue->notEmptyCondition);
+    return true;
+}
+
+
+PGCType PGCConcurrentQueueDequeueObject(PGCConcurrentQueue *queue)
+{
+    if (!queue) return NULL;
+    
+    PGCType object = NULL;
+    for (uint64_t i = 0; i < PGCConcurrentQueueSpinCount + PGCConcurrentQueueYieldCount; i++) {
+        if ((object = PGCConcurrentQueuePopObject(queue))) {
+            PGCConcurrentQueueWakeWaiter(queue, &queue->waitingProducerCount, &queue->notFullCondition);
+            return object;
+        }
+        
+        PGCConcurrentQueuePause(i);
+    }
+    
+    pthread_mutex_lock(&queue->waitMutex);
+    __atomic_add_fetch(&queue->waitingConsumerCount, 1, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    while (!(object = PGCConcurrentQueuePopObject(queue))) pthread_cond_wait(&queue->notEmptyCondition, &queue->waitMutex);
+    __atomic_sub_fetch(&queue->waitingConsumerCount, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&queue->waitMutex);
+    
+    PGCConcurrentQueueWakeWaiter(queue, &queue->waitingProducerCount, &queue->notFullCondition);
+    return object;
+}
+
+
+PGCType PGCConcurrentQueueTryDequeueObject(PGCConcurrentQueue *queue)
+{
+    PGCType object = queue ? PGCConcurrentQueuePopObject(queue) : NULL;
+    if (object) PGCConcurrentQueueWakeWaiter(queue, &queue->waitingProducerCount, &queue->notFullCondition);
+    return object;
+}
+
+
+void PGCConcurrentQueueWaitToPushObject(PGCConcurrentQueue *queue, PGCType instance, bool retainsObject)
+{
+    for (uint64_t i = 0; i < PGCConcurrentQueueSpinCount + PGCConcurrentQueueYieldCount; i++) {
+        if (PGCConcurrentQueuePushObject(queue, instance, retainsObject)) {
+            PGCConcurrentQueueWakeWaiter(queue, &queue->waitingConsumerCount, &queue->notEmptyCondition);
+            return;
+        }
+        
+        PGCConcurrentQueuePause(i);
+    }
+    
+    // Announce that we’re waiting before checking again, so that a consumer either sees us waiting or we see the room it made
+    pthread_mutex_lock(&queue->waitMutex);
+    __atomic_add_fetch(&queue->waitingProducerCount, 1, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    while (!PGCConcurrentQueuePushObject(queue, instance, retainsObject)) {
+        pthread_cond_wait(&queue->notFullCondition, &queue->waitMutex);
+    }
+    __atomic_sub_fetch(&queue->waitingProducerCount, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&queue->waitMutex);
+    
+    PGCConcurrentQueueWakeWaiter(queue, &queue->waitingConsumerCount, &queue->notEmptyCondition);
+}
+
+
+bool PGCConcurrentQueuePushObject(PGCConcurrentQueue *queue, PGCType instance, bool retainsObject)
+{
+    PGCConcurrentQueueCell *cell = NULL;
+    uint64_t position = __atomic_load_n(&queue->enqueuePosition, __ATOMIC_RELAXED);
+    while (true) {
+        cell = &queue->cells[position & queue->mask];
+        int64_t difference = (int64_t)(__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) - position);
+        if (difference == 0) {
+            if (__atomic_compare_exchange_n(&queue->enqueuePosition, &position, position + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+        } else if (difference < 0) {
+            // The cell still holds an object from one lap ago, so the queue is full
+            return false;
+        } else {
+            position = __atomic_load_n(&queue->enqueuePosition, __ATOMIC_RELAXED);
+        }
+    }
+    
+    // The queue’s reference is the one handed to whoever dequeues the object. Objects enqueued with a retained variant
+    // already carry that reference.
+    cell->object = retainsObject ? PGCRetain(instance) : instance;
+    __atomic_store_n(&cell->sequence, position + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+
+PGCType PGCConcurrentQueuePopObject(PGCConcurrentQueue *queue)
+{
+    PGCConcurrentQueueCell *cell = NULL;
+    uint64_t position = __atomic_load_n(&queue->dequeuePosition, __ATOMIC_RELAXED);
+    while (true) {
+        cell = &queue->cells[position & queue->mask];
+        int64_t difference = (int64_t)(__atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) - (position + 1));
+        if (difference == 0) {
+            if (__atomic_compare_exchange_n(&queue->dequeuePosition, &position, position + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+        } else if (difference < 0) {
+            return NULL;
+        } else {
+            position = __atomic_load_n(&queue->dequeuePosition, __ATOMIC_RELAXED);
+        }
+    }
+    
+    PGCType object = cell->object;
+    cell->object = NULL;
+    __atomic_store_n(&cell->sequence, position + queue->mask + 1, __ATOMIC_RELEASE);
+    return object;
+}
+
+
+void PGCConcurrentQueueWakeWaiter(PGCConcurrentQueue *queue, uint64_t *waitingCount, pthread_cond_t *condition)
+{
+    // Pairs with the fence a waiter issues after announcing itself. Without waiters, this is the only cost of blocking support.
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(waitingCount, __ATOMIC_RELAXED) == 0) return;
+    
+    pthread_mutex_lock(&queue->waitMutex);
+    pthread_cond_signal(condition);
+    pthread_mutex_unlock(&queue->waitMutex);
+}
+
+
+void PGCConcurrentQueuePause(uint64_t attempt)
+{
+    // Spinning only helps when another processor can make progress in the meantime, so go straight to yielding on a uniprocessor
+    static long processorCount = 0;
+    long count = __atomic_load_n(&processorCount, __ATOMIC_RELAXED);
+    if (count == 0) {
+        count = sysconf(_SC_NPROCESSORS_ONLN);
+        __atomic_store_n(&processorCount, count, __ATOMIC_RELAXED);
+    }
+    
+    if (attempt < PGCConcurrentQueueSpinCount && count > 1) {
+#if defined(__x86_64__)
+        _mm_pause();
+#endif
+        return;
+    }
+    
+    sched_yield();
+}
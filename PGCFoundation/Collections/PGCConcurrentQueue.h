@@ -0,0 +1,60 @@
+//
+//  PGCConcurrentQueue.h
+//  PGCFoundation
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef PGCCONCURRENTQUEUE_H
+#define PGCCONCURRENTQUEUE_H
+
+#include <PGCFoundation/PGCObject.h>
+#include <PGCFoundation/PGCString.h>
+
+typedef struct _PGCConcurrentQueue PGCConcurrentQueue;
+
+extern PGCClass *PGCConcurrentQueueClass(void);
+extern PGCConcurrentQueue *PGCConcurrentQueueInstance(void);
+
+#pragma mark Basic Functions
+
+extern PGCConcurrentQueue *PGCConcurrentQueueInit(PGCConcurrentQueue *queue);
+extern PGCConcurrentQueue *PGCConcurrentQueueInitWithCapacity(PGCConcurrentQueue *queue, uint64_t capacity);
+
+extern PGCString *PGCConcurrentQueueDescription(PGCType instance);
+
+#pragma mark Accessors
+
+extern uint64_t PGCConcurrentQueueGetCapacity(PGCConcurrentQueue *queue);
+extern uint64_t PGCConcurrentQueueGetCount(PGCConcurrentQueue *queue);
+
+#pragma mark Enqueueing and Dequeueing
+
+extern void PGCConcurrentQueueEnqueueObject(PGCConcurrentQueue *queue, PGCType instance);
+extern void PGCConcurrentQueueEnqueueRetainedObject(PGCConcurrentQueue *queue, PGCType instance);
+extern bool PGCConcurrentQueueTryEnqueueObject(PGCConcurrentQueue *queue, PGCType instance);
+extern bool PGCConcurrentQueueTryEnqueueRetainedObject(PGCConcurrentQueue *queue, PGCType instance);
+
+extern PGCType PGCConcurrentQueueDequeueObject(PGCConcurrentQueue *queue);
+extern PGCType PGCConcurrentQueueTryDequeueObject(PGCConcurrentQueue *queue);
+
+#endif
@@ -0,0 +1,479 @@
+//
+//  PGCDecimalArray.c
+//  PGCFoundation
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <PGCFoundation/PGCDecimalArray.h>
+
+#include <PGCFoundation/PGCDecimal.h>
+#include <PGCFoundation/PGCInteger.h>
+#include <PGCFoundation/PGCString.h>
+
+#include <string.h>
+
+struct _PGCDecimalArray {
+    PGCObject super;
+    
+    double *values;
+    uint64_t count;
+    uint64_t capacity;
+    uint64_t initialCapacity;
+};
+
+
+#pragma mark Private Global Constants
+
+static const uint64_t PGCDecimalArrayDefaultInitialCapacity = 16;
+static const double PGCDecimalArrayGrowthFactor = 1.5;
+
+// Values processed per iteration by the arithmetic and search loops below
+enum { PGCDecimalArrayLaneCount = 8 };
+
+
+#pragma mark Private Function Interfaces
+
+void PGCDecimalArrayDealloc(PGCType instance);
+bool PGCDecimalArrayGrowToMinimumCapacity(PGCDecimalArray *decimalArray, uint64_t minimumCapacity);
+bool PGCDecimalArrayReallocateValues(PGCDecimalArray *decimalArray, uint64_t capacity);
+
+
+#pragma mark -
+
+PGCClass *PGCDecimalArrayClass(void)
+{
+    static PGCClass *decimalArrayClass = NULL;
+    if (!decimalArrayClass) {
+        PGCClassFunctions functions = { PGCDecimalArrayCopy, PGCDecimalArrayDealloc, PGCDecimalArrayDescription, PGCDecimalArrayEquals,
+                                        PGCDecimalArrayHash, NULL, NULL };
+        decimalArrayClass = PGCClassCreate("PGCDecimalArray", PGCObjectClass(), functions, sizeof(PGCDecimalArray));
+    }
+    return decimalArrayClass;
+}
+
+
+PGCDecimalArray *PGCDecimalArrayInstance(void)
+{
+    return PGCAutorelease(PGCDecimalArrayInit(NULL));
+}
+
+
+PGCDecimalArray *PGCDecimalArrayInstanceWithValues(const double *values, uint64_t count)
+{
+    return PGCAutorelease(PGCDecimalArrayInitWithValues(NULL, values, count));
+}
+
+
+PGCDecimalArray *PGCDecimalArrayInstanceWithArray(PGCArray *array)
+{
+    return PGCAutorelease(PGCDecimalArrayInitWithArray(NULL, array));
+}
+
+
+#pragma mark Basic Functions
+
+PGCDecimalArray *PGCDecimalArrayInit(PGCDecimalArray *decimalArray)
+{
+    return PGCDecimalArrayInitWithInitialCapacity(decimalArray, 0);
+}
+
+
+PGCDecimalArray *PGCDecimalArrayInitWithInitialCapacity(PGCDecimalArray *decimalArray, uint64_t initialCapacity)
+{
+    if (!decimalArray && (decimalArray = PGCAlloc(PGCDecimalArrayClass())) == NULL) return NULL;
+    PGCObjectInit(&decimalArray->super);
+    
+    decimalArray->values = NULL;
+    decimalArray->count = 0;
+    decimalArray->capacity = 0;
+    decimalArray->initialCapacity = initialCapacity > 0 ? initialCapacity : PGCDecimalArrayDefaultInitialCapacity;
+    return decimalArray;
+}
+
+
+PGCDecimalArray *PGCDecimalArrayInitWithValues(PGCDecimalArray *decimalArray, const double *values, uint64_t count)
+{
+    decimalArray = PGCDecimalArrayInitWithInitialCapacity(decimalArray, count);
+    if (!decimalArray) return NULL;
+    
+    PGCDecimalArrayAddValues(decimalArray, values, count);
+    return decimalArray;
+}
+
+
+PGCDecimalArray *PGCDecimalArrayInitWithArray(PGCDecimalArray *decimalArray, PGCArray *array)
+{
+    uint64_t count = PGCArrayGetCount(array);
+    decimalArray = PGCDecimalArrayInitWithInitialCapacity(decimalArray, count);
+    if (!decimalArray) return NULL;
+    
+    // Every object in the array must be a PGCDecimal or PGCInteger
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+    for (uint64_t i = 0; i < count; i++) {
+        PGCType object = PGCArrayGetObjectAtIndex(array, i);
+        if (PGCObjectIsKindOfClass(object, PGCDecimalClass())) {
+            PGCDecimalArrayAddValue(decimalArray, PGCDecimalGetValue(object));
+        } else if (PGCObjectIsKindOfClass(object, PGCIntegerClass())) {
+            PGCInteger *integer = object;
+            PGCDecimalArrayAddValue(decimalArray, PGCIntegerIsSigned(integer) ? (double)PGCIntegerGetSignedValue(integer)
+                                                                              : (double)PGCIntegerGetUnsignedValue(integer));
+        } else {
+            PGCAutoreleasePoolDestroy(pool);
+            PGCRelease(decimalArray);
+            return NULL;
+        }
+    }
+    
+    PGCAutoreleasePoolDestroy(pool);
+    return decimalArray;
+}
+
+
+void PGCDecimalArrayDealloc(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCDecimalArrayClass())) return;
+    free(((PGCDecimalArray *)instance)->values);
+    PGCSuperclassDealloc(instance);
+}
+
+
+PGCType PGCDecimalArrayCopy(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCDecimalArrayClass())) return NULL;
+    PGCDecimalArray *decimalArray = instance;
+    return PGCDecimalArrayInitWithValues(NULL, decimalArray->values, decimalArray->count);
+}
+
+
+PGCString *PGCDecimalArrayDescription(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCDecimalArrayClass())) return NULL;
+    PGCDecimalArray *decimalArray = instance;
+    
+    PGCString *description = PGCStringInstanceWithCString("[");
+    for (uint64_t i = 0; i < decimalArray->count; i++) {
+        PGCStringAppendFormat(description, i == 0 ? "%f" : ", %f", decimalArray->values[i]);
+    }
+    
+    PGCStringAppendFormat(description, "]");
+    return description;
+}
+
+
+bool PGCDecimalArrayEquals(PGCType instance1, PGCType instance2)
+{
+    if (!PGCObjectIsKindOfClass(instance1, PGCDecimalArrayClass()) || !PGCObjectIsKindOfClass(instance2, PGCDecimalArrayClass())) return false;
+    
+    PGCDecimalArray *decimalArray1 = instance1;
+    PGCDecimalArray *decimalArray2 = instance2;
+    if (decimalArray1->count != decimalArray2->count) return false;
+    
+    // Compare values rather than bytes so that 0.0 and -0.0 are equal, as they are for PGCDecimal
+    for (uint64_t i = 0; i < decimalArray1->count; i++) if (decimalArray1->values[i] != decimalArray2->values[i]) return false;
+    return true;
+}
+
+
+uint64_t PGCDecimalArrayHash(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCDecimalArrayClass())) return 0;
+    PGCDecimalArray *decimalArray = instance;
+    
+    // Hash the bit patterns of the values, treating -0.0 as 0.0 to stay consistent with PGCDecimalArrayEquals
+    uint64_t hash = 0;
+    for (uint64_t i = 0; i < decimalArray->count; i++) {
+        double value = decimalArray->values[i] == 0 ? 0 : decimalArray->values[i];
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        hash = PGCHashCombine(hash, bits);
+    }
+    
+    return hash;
+}
+
+
+#pragma mark Accessors
+
+uint64_t PGCDecimalArrayGetCount(PGCDecimalArray *decimalArray)
+{
+    return decimalArray ? decimalArray->count : 0;
+}
+
+
+const double *PGCDecimalArrayGetValues(PGCDecimalArray *decimalArray)
+{
+    return decimalArray ? decimalArray->values : NULL;
+}
+
+
+double PGCDecimalArrayGetValueAtIndex(PGCDecimalArray *decimalArray, uint64_t index)
+{
+    return decimalArray && index < decimalArray->count ? decimalArray->values[index] : 0;
+}
+
+
+uint64_t PGCDecimalArrayGetIndexOfValue(PGCDecimalArray *decimalArray, double value)
+{
+    return decimalArray ? PGCDecimalArrayGetIndexOfValueInRange(decimalArray, value, PGCMakeRange(0, decimalArray->count)) : PGCNotFound;
+}
+
+
+uint64_t PGCDecimalArrayGetIndexOfValueInRange(PGCDecimalArray *decimalArray, double value, PGCRange range)
+{
+    if (!decimalArray || range.location >= decimalArray->count || range.location + range.length > decimalArray->count) return PGCNotFound;
+    
+    // NaN is never equal to anything, so it can’t be found
+    const double *values = decimalArray->values;
+    uint64_t i = range.location;
+    uint64_t lastIndex = range.location + range.length;
+    for (; i + PGCDecimalArrayLaneCount <= lastIndex; i += PGCDecimalArrayLaneCount) {
+        bool matched = false;
+        for (uint64_t lane = 0; lane < PGCDecimalArrayLaneCount; lane++) matched |= values[i + lane] == value;
+        if (matched) break;
+    }
+    
+    for (; i < lastIndex; i++) if (values[i] == value) return i;
+    return PGCNotFound;
+}
+
+
+#pragma mark Value Addition, Replacement, and Removal
+
+void PGCDecimalArrayAddValue(PGCDecimalArray *decimalArray, double value)
+{
+    PGCDecimalArrayAddValues(decimalArray, &value, 1);
+}
+
+
+void PGCDecimalArrayAddValues(PGCDecimalArray *decimalArray, const double *values, uint64_t count)
+{
+    if (!decimalArray || !values || count == 0 || !PGCDecimalArrayGrowToMinimumCapacity(decimalArray, decimalArray->count + count)) return;
+    memcpy(&decimalArray->values[decimalArray->count], values, count * sizeof(double));
+    decimalArray->count += count;
+}
+
+
+void PGCDecimalArrayInsertValueAtIndex(PGCDecimalArray *decimalArray, double value, uint64_t index)
+{
+    if (!decimalArray || index > decimalArray->count || !PGCDecimalArrayGrowToMinimumCapacity(decimalArray, decimalArray->count + 1)) return;
+    memmove(&decimalArray->values[index + 1], &decimalArray->values[index], (decimalArray->count - index) * sizeof(double));
+    decimalArray->values[index] = value;
+    decimalArray->count++;
+}
+
+
+void PGCDecimalArrayReplaceValueAtIndex(PGCDecimalArray *decimalArray, double value, uint64_t index)
+{
+    if (!decimalArray || index >= decimalArray->count) return;
+    decimalArray->values[index] = value;
+}
+
+
+void PGCDecimalArrayRemoveValueAtIndex(PGCDecimalArray *decimalArray, uint64_t index)
+{
+    PGCDecimalArrayRemoveValuesInRange(decimalArray, PGCMakeRange(index, 1));
+}
+
+
+void PGCDecimalArrayRemoveValuesInRange(PGCDecimalArray *decimalArray, PGCRange range)
+{
+    if (!decimalArray || range.location >= decimalArray->count || range.location + range.length > decimalArray->count) return;
+    
+    uint64_t tailCount = decimalArray->count - range.location - range.length;
+    memmove(&decimalArray->values[range.location], &decimalArray->values[range.location + range.length], tailCount * sizeof(double));
+    decimalArray->count -= range.length;
+}
+
+
+void PGCDecimalArrayRemoveAllValues(PGCDecimalArray *decimalArray)
+{
+    if (!decimalArray) return;
+    decimalArray->count = 0;
+}
+
+
+#pragma mark Arithmetic
+
+double PGCDecimalArrayGetSum(PGCDecimalArray *decimalArray)
+{
+    if (!decimalArray) return 0;
+    
+    // The compiler can’t reorder floating-point additions, so a single running sum can’t be vectorized. Keeping a separate sum
+    // per lane can be. Note that this means the result may differ slightly from a sum computed in index order.
+    const double *values = decimalArray->values;
+    double sums[PGCDecimalArrayLaneCount] = { 0 };
+    uint64_t i = 0;
+    for (; i + PGCDecimalArrayLaneCount <= decimalArray->count; i += PGCDecimalArrayLaneCount) {
+        for (uint64_t lane = 0; lane < PGCDecimalArrayLaneCount; lane++) sums[lane] += values[i + lane];
+    }
+    
+    double sum = 0;
+    for (uint64_t lane = 0; lane < PGCDecimalArrayLaneCount; lane++) sum += sums[lane];
+    for (; i < decimalArray->count; i++) sum += values[i];
+    return sum;
+}
+
+
+double PGCDecimalArrayGetMinimum(PGCDecimalArray *decimalArray)
+{
+    if (!decimalArray || decimalArray->count == 0) return 0;
+    
+    const double *values = decimalArray->values;
+    double minimums[PGCDecimalArrayLaneCount];
+    for (uint64_t lane = 0; lane < PGCDecimalArrayLaneCount; lane++) minimums[lane] = values[0];
+    
+    uint64_t i = 0;
+    for (; i + PGCDecimalArrayLaneCount <= decimalArray->count; i += PGCDecimalArrayLaneCount) {
+        for (uint64_t lane = 0; lane < PGCDecimalArrayLaneCount; lane++) {
+            minimums[lane] = values[i + lane] < minimums[lane] ? values[i + lane] : minimums[lane];
+        }
+    }
+    
+    double minimum = minimums[0];
+    for (uint64_t lane = 1; lane < PGCDecimalArrayLaneCount; lane++) if (minimums[lane] < minimum) minimum = minimums[lane];
+    for (; i < decimalArray->count; i++) if (values[i] < minimum) minimum = values[i];
+    return minimum;
+}
+
+
+double PGCDecimalArrayGetMaximum(PGCDecimalArray *decimalArray)
+{
+    if (!decimalArray || decimalArray->count == 0) return 0;
+    
+    const double *values = decimalArray->values;
+    double maximums[PGCDecimalArrayLaneCount];
+    for (uint64_t lane = 0; lane < PGCDecimalArrayLaneCount; lane++) maximums[lane] = values[0];
+    
+    uint64_t i = 0;
+    for (; i + PGCDecimalArrayLaneCount <= decimalArray->count; i += PGCDecimalArrayLaneCount) {
+        for (uint64_t lane = 0; lane < PGCDecimalArrayLaneCount; lane++) {
+            maximums[lane] = values[i + lane] > maximums[lane] ? values[i + lane] : maximums[lane];
+        }
+    }
+    
+    double maximum = maximums[0];
+    for (uint64_t lane = 1; lane < PGCDecimalArrayLaneCount; lane++) if (maximums[lane] > maximum) maximum = maximums[lane];
+    for (; i < decimalArray->count; i++) if (values[i] > maximum) maximum = values[i];
+    return maximum;
+}
+
+
+double PGCDecimalArrayGetDotProduct(PGCDecimalArray *decimalArray1, PGCDecimalArray *decimalArray2)
+{
+    if (!decimalArray1 || !decimalArray2 || decimalArray1->count != decimalArray2->count) return 0;
+    
+    const double *values1 = decimalArray1->values;
+    const double *values2 = decimalArray2->values;
+    double sums[PGCDecimalArrayLaneCount] = { 0 };
+    uint64_t i = 0;
+    for (; i + PGCDecimalArrayLaneCount <= decimalArray1->count; i += PGCDecimalArrayLaneCount) {
+        for (uint64_t lane = 0; lane < PGCDecimalArrayLaneCount; lane++) sums[lane] += values1[i + lane] * values2[i + lane];
+    }
+    
+    double sum = 0;
+    for (uint64_t lane = 0; lane < PGCDecimalArrayLaneCount; lane++) sum += sums[lane];
+    for (; i < decimalArray1->count; i++) sum += values1[i] * values2[i];
+    return sum;
+}
+
+
+void PGCDecimalArrayScan(PGCDecimalArray *decimalArray)
+{
+    if (!decimalArray) return;
+    
+    // Replaces each value with the sum of it and every value before it
+    double *values = decimalArray->values;
+    double sum = 0;
+    for (uint64_t i = 0; i < decimalArray->count; i++) {
+        sum += values[i];
+        values[i] = sum;
+    }
+}
+
+
+#pragma mark Boxing
+
+PGCArray *PGCDecimalArrayGetArray(PGCDecimalArray *decimalArray)
+{
+    if (!decimalArray) return NULL;
+    
+    PGCArray *array = PGCArrayInitWithInitialCapacity(NULL, decimalArray->count);
+    if (!array) return NULL;
+    
+    for (uint64_t i = 0; i < decimalArray->count; i++) {
+        PGCDecimal *decimal = PGCDecimalInitWithValue(NULL, decimalArray->values[i]);
+        PGCArrayAddObject(array, decimal);
+        PGCRelease(decimal);
+    }
+    
+    return PGCAutorelease(array);
+}
+
+
+#pragma mark Memory Management
+
+uint64_t PGCDecimalArrayGetCapacity(PGCDecimalArray *decimalArray)
+{
+    return decimalArray ? decimalArray->capacity : 0;
+}
+
+
+void PGCDecimalArrayReserveCapacity(PGCDecimalArray *decimalArray, uint64_t capacity)
+{
+    if (!decimalArray || capacity <= decimalArray->capacity) return;
+    PGCDecimalArrayReallocateValues(decimalArray, capacity);
+}
+
+
+void PGCDecimalArrayCondense(PGCDecimalArray *decimalArray)
+{
+    if (!decimalArray || decimalArray->capacity == decimalArray->count) return;
+    PGCDecimalArrayReallocateValues(decimalArray, decimalArray->count);
+}
+
+
+bool PGCDecimalArrayGrowToMinimumCapacity(PGCDecimalArray *decimalArray, uint64_t minimumCapacity)
+{
+    if (minimumCapacity <= decimalArray->capacity) return true;
+    
+    uint64_t capacity = decimalArray->capacity > 0 ? (uint64_t)(decimalArray->capacity * PGCDecimalArrayGrowthFactor) : decimalArray->initialCapacity;
+    return PGCDecimalArrayReallocateValues(decimalArray, capacity < minimumCapacity ? minimumCapacity : capacity);
+}
+
+
+bool PGCDecimalArrayReallocateValues(PGCDecimalArray *decimalArray, uint64_t capacity)
+{
+    if (capacity == 0) {
+        free(decimalArray->values);
+        decimalArray->values = NULL;
+        decimalArray->capacity = 0;
+        return true;
+    }
+    
+    double *reallocedValues = realloc(decimalArray->values, capacity * sizeof(double));
+    if (!reallocedValues) return false;
+    
+    decimalArray->values = reallocedValues;
+    decimalArray->capacity = capacity;
+    return true;
+}
@@ -0,0 +1,89 @@
+//
+//  PGCDecimalArray.h
+//  PGCFoundation
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef PGCDECIMALARRAY_H
+#define PGCDECIMALARRAY_H
+
+#include <PGCFoundation/PGCObject.h>
+#include <PGCFoundation/PGCArray.h>
+
+typedef struct _PGCDecimalArray PGCDecimalArray;
+
+extern PGCClass *PGCDecimalArrayClass(void);
+extern PGCDecimalArray *PGCDecimalArrayInstance(void);
+extern PGCDecimalArray *PGCDecimalArrayInstanceWithValues(const double *values, uint64_t count);
+extern PGCDecimalArray *PGCDecimalArrayInstanceWithArray(PGCArray *array);
+
+#pragma mark Basic Functions
+
+extern PGCDecimalArray *PGCDecimalArrayInit(PGCDecimalArray *decimalArray);
+extern PGCDecimalArray *PGCDecimalArrayInitWithInitialCapacity(PGCDecimalArray *decimalArray, uint64_t initialCapacity);
+extern PGCDecimalArray *PGCDecimalArrayInitWithValues(PGCDecimalArray *decimalArray, const double *values, uint64_t count);
+extern PGCDecimalArray *PGCDecimalArrayInitWithArray(PGCDecimalArray *decimalArray, PGCArray *array);
+
+extern PGCType PGCDecimalArrayCopy(PGCType instance);
+extern PGCString *PGCDecimalArrayDescription(PGCType instance);
+extern bool PGCDecimalArrayEquals(PGCType instance1, PGCType instance2);
+extern uint64_t PGCDecimalArrayHash(PGCType instance);
+
+#pragma mark Accessors
+
+extern uint64_t PGCDecimalArrayGetCount(PGCDecimalArray *decimalArray);
+extern const double *PGCDecimalArrayGetValues(PGCDecimalArray *decimalArray);
+extern double PGCDecimalArrayGetValueAtIndex(PGCDecimalArray *decimalArray, uint64_t index);
+
+extern uint64_t PGCDecimalArrayGetIndexOfValue(PGCDecimalArray *decimalArray, double value);
+extern uint64_t PGCDecimalArrayGetIndexOfValueInRange(PGCDecimalArray *decimalArray, double value, PGCRange range);
+
+#pragma mark Value Addition, Replacement, and Removal
+
+extern void PGCDecimalArrayAddValue(PGCDecimalArray *decimalArray, double value);
+extern void PGCDecimalArrayAddValues(PGCDecimalArray *decimalArray, const double *values, uint64_t count);
+extern void PGCDecimalArrayInsertValueAtIndex(PGCDecimalArray *decimalArray, double value, uint64_t index);
+extern void PGCDecimalArrayReplaceValueAtIndex(PGCDecimalArray *decimalArray, double value, uint64_t index);
+extern void PGCDecimalArrayRemoveValueAtIndex(PGCDecimalArray *decimalArray, uint64_t index);
+extern void PGCDecimalArrayRemoveValuesInRange(PGCDecimalArray *decimalArray, PGCRange range);
+extern void PGCDecimalArrayRemoveAllValues(PGCDecimalArray *decimalArray);
+
+#pragma mark Arithmetic
+
+extern double PGCDecimalArrayGetSum(PGCDecimalArray *decimalArray);
+extern double PGCDecimalArrayGetMinimum(PGCDecimalArray *decimalArray);
+extern double PGCDecimalArrayGetMaximum(PGCDecimalArray *decimalArray);
+extern double PGCDecimalArrayGetDotProduct(PGCDecimalArray *decimalArray1, PGCDecimalArray *decimalArray2);
+extern void PGCDecimalArrayScan(PGCDecimalArray *decimalArray);
+
+#pragma mark Boxing
+
+extern PGCArray *PGCDecimalArrayGetArray(PGCDecimalArray *decimalArray);
+
+#pragma mark Memory Management
+
+extern uint64_t PGCDecimalArrayGetCapacity(PGCDecimalArray *decimalArray);
+extern void PGCDecimalArrayReserveCapacity(PGCDecimalArray *decimalArray, uint64_t capacity);
+extern void PGCDecimalArrayCondense(PGCDecimalArray *decimalArray);
+
+#endif
@@ -25,21 +25,45 @@
 //
 
 #include <PGCFoundation/PGCDictionary.h>
+#include <PGCFoundation/PGCArchiver.h>
 #include <PGCFoundation/PGCList.h>
 
 #include "PGCDictionaryEntry.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 struct _PGCDictionary {
     PGCObject super;
     PGCList **buckets;
     uint64_t count;
+
+    uint64_t hash;
+    bool hashIsValid;
+
+    // Frozen dictionaries have no buckets. Instead, they store their keys’ hashes in ascending order in a single allocation,
+    // followed by their keys and objects in the same order.
+    bool isFrozen;
+    uint64_t *keyHashes;
+    PGCType *keys;
+    PGCType *objects;
 };
 
+
+typedef struct _PGCDictionaryFrozenEntry {
+    uint64_t keyHash;
+    PGCType key;
+    PGCType object;
+} PGCDictionaryFrozenEntry;
+
+
 const uint64_t PGCDictionaryBucketCount = 512;
 
 PGCDictionary *PGCDictionaryInitWithObjectAndKeyAndArguments(PGCDictionary *dictionary, PGCType object, PGCType key, va_list arguments);
 PGCDictionaryEntry *PGCDictionaryGetEntryForKey(PGCList *bucket, PGCType key); 
 void PGCDictionaryDealloc(PGCType instance);
+uint64_t PGCDictionaryGetFrozenIndexForKey(PGCDictionary *dictionary, PGCType key);
+int PGCDictionaryCompareFrozenEntries(const void *entry1, const void *entry2);
 
 #pragma mark -
 
@@ -48,7 +72,7 @@ PGCClass *PGCDictionaryClass(void)
     static PGCClass *dictionaryClass = NULL;
     if (!dictionaryClass) {
         PGCClassFunctions functions = { PGCDictionaryCopy, PGCDictionaryDealloc, PGCDictionaryDescription, 
-            PGCDictionaryEquals, PGCDictionaryHash, NULL, NULL };
+            PGCDictionaryEquals, PGCDictionaryHash, NULL, NULL, PGCDictionaryEncode, PGCDictionaryDecode };
         dictionaryClass = PGCClassCreate("PGCDictionary", PGCObjectClass(), functions, sizeof(PGCDictionary));
     }
     return dictionaryClass;    
@@ -131,6 +155,15 @@ void PGCDictionaryDealloc(PGCType instance)
         free(dictionary->buckets);
     }
     
+    if (dictionary->keyHashes) {
+        for (uint64_t i = 0; i < dictionary->count; i++) {
+            PGCRelease(dictionary->keys[i]);
+            PGCRelease(dictionary->objects[i]);
+        }
+        
+        free(dictionary->keyHashes);
+    }
+    
     PGCSuperclassDealloc(dictionary);
 }
 
@@ -140,6 +173,9 @@ PGCType PGCDictionaryCopy(PGCType instance)
     if (!PGCObjectIsKindOfClass(instance, PGCDictionaryClass())) return NULL;
     PGCDictionary *dictionary = instance;
     
+    // Frozen dictionaries can never change, so they are their own copies
+    if (dictionary->isFrozen) return PGCRetain(dictionary);
+    
     PGCDictionary *copy = PGCDictionaryInit(NULL);
     if (!copy) return NULL;
     
@@ -167,10 +203,13 @@ PGCType PGCDictionaryCopy(PGCType instance)
             }
             
             PGCListAddObject(copy->buckets[i], entryCopy);
+            PGCRelease(entryCopy);
         }
     }
     
     copy->count = dictionary->count;
+    copy->hash = dictionary->hash;
+    copy->hashIsValid = dictionary->hashIsValid;
     
     return copy;
 }
@@ -187,14 +226,129 @@ PGCString *PGCDictionaryDescription(PGCType instance)
 
 bool PGCDictionaryEquals(PGCType instance1, PGCType instance2)
 {
-    return false;
+    if (!PGCObjectIsKindOfClass(instance1, PGCDictionaryClass()) || !PGCObjectIsKindOfClass(instance2, PGCDictionaryClass())) return false;
+    
+    PGCDictionary *dictionary1 = instance1;
+    PGCDictionary *dictionary2 = instance2;
+    if (dictionary1 == dictionary2) return true;
+    if (dictionary1->count != dictionary2->count) return false;
+    
+    // If either dictionary is frozen, look up each of its entries in the other
+    if (dictionary2->isFrozen) {
+        dictionary2 = dictionary1;
+        dictionary1 = instance2;
+    }
+    
+    if (dictionary1->isFrozen) {
+        for (uint64_t i = 0; i < dictionary1->count; i++) {
+            PGCType object2 = PGCDictionaryGetObjectForKey(dictionary2, dictionary1->keys[i]);
+            if (!object2 || !PGCEquals(dictionary1->objects[i], object2)) return false;
+        }
+        
+        return true;
+    }
+    
+    // Equal keys have equal hashes, so any key in one of dictionary1’s buckets must be in the corresponding bucket of dictionary2
+    for (uint64_t i = 0; i < PGCDictionaryBucketCount; i++) {
+        PGCList *bucket = dictionary1->buckets[i];
+        if (!bucket) continue;
+        
+        uint64_t entryCount = PGCListGetCount(bucket);
+        for (uint64_t j = 0; j < entryCount; j++) {
+            PGCDictionaryEntry *entry1 = PGCListGetObjectAtIndex(bucket, j);
+            PGCDictionaryEntry *entry2 = PGCDictionaryGetEntryForKey(dictionary2->buckets[i], PGCDictionaryEntryGetKey(entry1));
+            if (!entry2 || !PGCEquals(PGCDictionaryEntryGetObject(entry1), PGCDictionaryEntryGetObject(entry2))) return false;
+        }
+    }
+    
+    return true;
 }
 
 
 uint64_t PGCDictionaryHash(PGCType instance)
 {
     if (!PGCObjectIsKindOfClass(instance, PGCDictionaryClass())) return 0;
-    return ((PGCDictionary *)instance)->count;
+    PGCDictionary *dictionary = instance;
+    
+    // A dictionary’s hash is the sum of its entries’ hashes, which makes it independent of the order of the entries. Like arrays,
+    // the hash is computed lazily, but once computed, it is kept up to date as objects are set and removed.
+    if (!dictionary->hashIsValid) {
+        uint64_t hash = 0;
+        for (uint64_t i = 0; i < PGCDictionaryBucketCount; i++) {
+            PGCList *bucket = dictionary->buckets[i];
+            if (!bucket) continue;
+            
+            uint64_t entryCount = PGCListGetCount(bucket);
+            for (uint64_t j = 0; j < entryCount; j++) hash += PGCDictionaryEntryHash(PGCListGetObjectAtIndex(bucket, j));
+        }
+        
+        dictionary->hash = hash;
+        dictionary->hashIsValid = true;
+    }
+    
+    return dictionary->hash;
+}
+
+
+bool PGCDictionaryEncode(PGCType instance, PGCArchiver *archiver)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCDictionaryClass())) return false;
+    PGCDictionary *dictionary = instance;
+    
+    // Entries are written as alternating keys and objects
+    PGCArchiverEncodeCount(archiver, dictionary->count);
+    if (dictionary->isFrozen) {
+        for (uint64_t i = 0; i < dictionary->count; i++) {
+            if (!PGCArchiverEncodeObject(archiver, dictionary->keys[i]) || !PGCArchiverEncodeObject(archiver, dictionary->objects[i])) {
+                return false;
+            }
+        }
+        
+        return true;
+    }
+    
+    for (uint64_t i = 0; i < PGCDictionaryBucketCount; i++) {
+        PGCList *bucket = dictionary->buckets[i];
+        if (!bucket) continue;
+        
+        uint64_t entryCount = PGCListGetCount(bucket);
+        for (uint64_t j = 0; j < entryCount; j++) {
+            PGCDictionaryEntry *entry = PGCListGetObjectAtIndex(bucket, j);
+            if (!PGCArchiverEncodeObject(archiver, PGCDictionaryEntryGetKey(entry)) ||
+                !PGCArchiverEncodeObject(archiver, PGCDictionaryEntryGetObject(entry))) {
+                return false;
+            }
+        }
+    }
+    
+    return true;
+}
+
+
+PGCType PGCDictionaryDecode(PGCClass *class, PGCUnarchiver *unarchiver)
+{
+    uint64_t count = 0;
+    if (!PGCUnarchiverDecodeCount(unarchiver, &count)) return NULL;
+    
+    PGCDictionary *dictionary = PGCDictionaryInit(PGCAlloc(class));
+    if (!dictionary) return NULL;
+    
+    for (uint64_t i = 0; i < count; i++) {
+        // Claiming each decoded key and object keeps them out of the autorelease pool
+        PGCType key = PGCRetainAutoreleasedReturnValue(PGCUnarchiverDecodeObject(unarchiver));
+        PGCType object = key ? PGCRetainAutoreleasedReturnValue(PGCUnarchiverDecodeObject(unarchiver)) : NULL;
+        if (!object) {
+            PGCRelease(key);
+            PGCRelease(dictionary);
+            return NULL;
+        }
+        
+        PGCDictionarySetObjectForKey(dictionary, object, key);
+        PGCRelease(object);
+        PGCRelease(key);
+    }
+    
+    return dictionary;
 }
 
 
@@ -221,6 +375,11 @@ PGCDictionaryEntry *PGCDictionaryGetEntryForKey(PGCList *bucket, PGCType key)
 PGCType PGCDictionaryGetObjectForKey(PGCDictionary *dictionary, PGCType key)
 {
     if (!dictionary || !key) return NULL;
+    if (dictionary->isFrozen) {
+        uint64_t index = PGCDictionaryGetFrozenIndexForKey(dictionary, key);
+        return index != PGCNotFound ? PGCAutorelease(PGCRetain(dictionary->objects[index])) : NULL;
+    }
+    
     PGCList *bucket = dictionary->buckets[PGCHash(key) % PGCDictionaryBucketCount];
     return PGCDictionaryEntryGetObject(PGCDictionaryGetEntryForKey(bucket, key));
 }
@@ -228,7 +387,7 @@ PGCType PGCDictionaryGetObjectForKey(PGCDictionary *dictionary, PGCType key)
 
 void PGCDictionarySetObjectForKey(PGCDictionary *dictionary, PGCType object, PGCType key)
 {
-    if (!dictionary || !object || !key) return;
+    if (!dictionary || !object || !key || dictionary->isFrozen) return;
     uint64_t bucketIndex = PGCHash(key) % PGCDictionaryBucketCount;
     
     // Allocate a bucket if necessary
@@ -244,10 +403,13 @@ void PGCDictionarySetObjectForKey(PGCDictionary *dictionary, PGCType object, PGC
     // create a new entry, add it to the bucket, and increment our count
     PGCDictionaryEntry *entry = PGCDictionaryGetEntryForKey(bucket, keyCopy);
     if (entry) {
+        if (dictionary->hashIsValid) dictionary->hash -= PGCDictionaryEntryHash(entry);
         PGCDictionaryEntrySetObject(entry, object);
+        if (dictionary->hashIsValid) dictionary->hash += PGCDictionaryEntryHash(entry);
     } else if ((entry = PGCDictionaryEntryInitWithObjectAndKey(NULL, object, keyCopy))) {
         PGCListAddObject(bucket, entry);
         dictionary->count++;
+        if (dictionary->hashIsValid) dictionary->hash += PGCDictionaryEntryHash(entry);
         PGCRelease(entry);
     }
     
@@ -258,7 +420,7 @@ void PGCDictionarySetObjectForKey(PGCDictionary *dictionary, PGCType object, PGC
 
 void PGCDictionaryRemoveObjectForKey(PGCDictionary *dictionary, PGCType key)
 {
-    if (!dictionary || !key) return;
+    if (!dictionary || !key || dictionary->isFrozen) return;
     
     PGCList *bucket = dictionary->buckets[PGCHash(key) % PGCDictionaryBucketCount];
     uint64_t entryCount = PGCListGetCount(bucket);
@@ -266,24 +428,37 @@ void PGCDictionaryRemoveObjectForKey(PGCDictionary *dictionary, PGCType key)
         PGCDictionaryEntry *entry = PGCListGetObjectAtIndex(bucket, i);
         if (!PGCDictionaryEntryKeyEquals(entry, key)) continue;
         
+        if (dictionary->hashIsValid) dictionary->hash -= PGCDictionaryEntryHash(entry);
         PGCListRemoveObjectAtIndex(bucket, i);
         --dictionary->count;
+        return;
     }
 }
 
 
 void PGCDictionaryRemoveAllObjects(PGCDictionary *dictionary)
 {
-    if (!dictionary) return;
-    for (uint64_t i = 0; i < PGCDictionaryBucketCount; i++) PGCListRemoveAllObjects(dictionary->buckets[i]);
+    if (!dictionary || dictionary->isFrozen) return;
+    for (uint64_t i = 0; i < PGCDictionaryBucketCount; i++) {
+        if (dictionary->buckets[i]) PGCListRemoveAllObjects(dictionary->buckets[i]);
+    }
+    
+    dictionary->count = 0;
+    dictionary->hashIsValid = false;
 }
 
 
 PGCArray *PGCDictionaryGetAllKeys(PGCDictionary *dictionary)
 {
+    if (!dictionary) return NULL;
     PGCArray *allKeys = PGCArrayInitWithInitialCapacity(NULL, dictionary->count);
     if (!allKeys) return NULL;
     
+    if (dictionary->isFrozen) {
+        for (uint64_t i = 0; i < dictionary->count; i++) PGCArrayAddObject(allKeys, dictionary->keys[i]);
+        return PGCAutorelease(allKeys);
+    }
+    
     for (uint64_t i = 0; i < PGCDictionaryBucketCount; i++) {
         PGCList *bucket = dictionary->buckets[i];
         if (!bucket) continue;
@@ -300,9 +475,15 @@ PGCArray *PGCDictionaryGetAllKeys(PGCDictionary *dictionary)
 
 PGCArray *PGCDictionaryGetAllObjects(PGCDictionary *dictionary)
 {
+    if (!dictionary) return NULL;
     PGCArray *allObjects = PGCArrayInitWithInitialCapacity(NULL, dictionary->count);
     if (!allObjects) return NULL;
     
+    if (dictionary->isFrozen) {
+        for (uint64_t i = 0; i < dictionary->count; i++) PGCArrayAddObject(allObjects, dictionary->objects[i]);
+        return PGCAutorelease(allObjects);
+    }
+    
     for (uint64_t i = 0; i < PGCDictionaryBucketCount; i++) {
         PGCList *bucket = dictionary->buckets[i];
         if (!bucket) continue;
@@ -315,3 +496,133 @@ PGCArray *PGCDictionaryGetAllObjects(PGCDictionary *dictionary)
     
     return PGCAutorelease(allObjects);
 }
+
+
+void PGCDictionaryGetKeysAndObjects(PGCDictionary *dictionary, PGCType *keys, PGCType *objects)
+{
+    // Fills keys and objects, either of which may be NULL, with the dictionary’s entries without retaining them. This lets
+    // callers walk a dictionary without creating any arrays.
+    if (!dictionary) return;
+    if (dictionary->isFrozen) {
+        if (keys) memcpy(keys, dictionary->keys, dictionary->count * sizeof(PGCType));
+        if (objects) memcpy(objects, dictionary->objects, dictionary->count * sizeof(PGCType));
+        return;
+    }
+    
+    // Walk each bucket with a cursor, which visits its nodes in order without retaining or autoreleasing the entries
+    uint64_t entryIndex = 0;
+    for (uint64_t i = 0; i < PGCDictionaryBucketCount; i++) {
+        PGCList *bucket = dictionary->buckets[i];
+        if (!bucket) continue;
+        
+        PGCListCursor cursor = PGCListGetCursorAtIndex(bucket, 0);
+        while (PGCListCursorHasNext(&cursor)) {
+            PGCDictionaryEntry *entry = PGCListCursorNext(&cursor);
+            if (keys) keys[entryIndex] = PGCDictionaryEntryGetKey(entry);
+            if (objects) objects[entryIndex] = PGCDictionaryEntryGetObject(entry);
+            entryIndex++;
+        }
+    }
+}
+
+
+#pragma mark Freezing
+
+PGCDictionary *PGCDictionaryFreeze(PGCDictionary *dictionary)
+{
+    if (!dictionary) return NULL;
+    if (dictionary->isFrozen) return PGCAutorelease(PGCRetain(dictionary));
+    
+    PGCDictionary *frozenDictionary = PGCAlloc(PGCDictionaryClass());
+    if (!frozenDictionary) return NULL;
+    PGCObjectInit(&frozenDictionary->super);
+    
+    uint64_t count = dictionary->count;
+    PGCDictionaryFrozenEntry *entries = NULL;
+    if (count > 0) {
+        frozenDictionary->keyHashes = malloc(count * (sizeof(uint64_t) + 2 * sizeof(PGCType)));
+        entries = malloc(count * sizeof(PGCDictionaryFrozenEntry));
+        if (!frozenDictionary->keyHashes || !entries) {
+            free(entries);
+            PGCRelease(frozenDictionary);
+            return NULL;
+        }
+        
+        frozenDictionary->keys = (PGCType *)&frozenDictionary->keyHashes[count];
+        frozenDictionary->objects = &frozenDictionary->keys[count];
+    }
+    
+    // Gather our entries and sort them by their keys’ hashes. Like copies, frozen dictionaries retain our key copies rather than
+    // copying them again.
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+    uint64_t entryIndex = 0;
+    for (uint64_t i = 0; i < PGCDictionaryBucketCount; i++) {
+        PGCList *bucket = dictionary->buckets[i];
+        if (!bucket) continue;
+        
+        uint64_t entryCount = PGCListGetCount(bucket);
+        for (uint64_t j = 0; j < entryCount; j++) {
+            PGCDictionaryEntry *entry = PGCListGetObjectAtIndex(bucket, j);
+            PGCType key = PGCDictionaryEntryGetKey(entry);
+            entries[entryIndex].keyHash = PGCHash(key);
+            entries[entryIndex].key = key;
+            entries[entryIndex].object = PGCDictionaryEntryGetObject(entry);
+            entryIndex++;
+        }
+    }
+    
+    if (count > 0) qsort(entries, count, sizeof(PGCDictionaryFrozenEntry), PGCDictionaryCompareFrozenEntries);
+    for (uint64_t i = 0; i < count; i++) {
+        frozenDictionary->keyHashes[i] = entries[i].keyHash;
+        frozenDictionary->keys[i] = PGCRetain(entries[i].key);
+        frozenDictionary->objects[i] = PGCRetain(entries[i].object);
+    }
+    
+    PGCAutoreleasePoolDestroy(pool);
+    free(entries);
+    
+    // Compute the hash now so that reading a frozen dictionary never writes to it
+    frozenDictionary->count = count;
+    frozenDictionary->hash = PGCDictionaryHash(dictionary);
+    frozenDictionary->hashIsValid = true;
+    frozenDictionary->isFrozen = true;
+    return PGCAutorelease(frozenDictionary);
+}
+
+
+bool PGCDictionaryIsFrozen(PGCDictionary *dictionary)
+{
+    return dictionary ? dictionary->isFrozen : false;
+}
+
+
+uint64_t PGCDictionaryGetFrozenIndexForKey(PGCDictionary *dictionary, PGCType key)
+{
+    // Binary search for the first entry with key’s hash, then check each entry with that hash for key
+    uint64_t keyHash = PGCHash(key);
+    uint64_t base = 0;
+    uint64_t length = dictionary->count;
+    while (length > 0) {
+        uint64_t half = length / 2;
+        if (dictionary->keyHashes[base + half] < keyHash) {
+            base += half + 1;
+            length -= half + 1;
+        } else {
+            length = half;
+        }
+    }
+    
+    for (uint64_t i = base; i < dictionary->count && dictionary->keyHashes[i] == keyHash; i++) {
+        if (PGCEquals(dictionary->keys[i], key)) return i;
+    }
+    
+    return PGCNotFound;
+}
+
+
+int PGCDictionaryCompareFrozenEntries(const void *entry1, const void *entry2)
+{
+    uint64_t keyHash1 = ((const PGCDictionaryFrozenEntry *)entry1)->keyHash;
+    uint64_t keyHash2 = ((const PGCDictionaryFrozenEntry *)entry2)->keyHash;
+    return keyHash1 < keyHash2 ? -1 : keyHash1 > keyHash2;
+}
@@ -47,6 +47,8 @@ extern PGCType PGCDictionaryCopy(PGCType instance);
 extern PGCString *PGCDictionaryDescription(PGCType instance);
 extern bool PGCDictionaryEquals(PGCType instance1, PGCType instance2);
 extern uint64_t PGCDictionaryHash(PGCType instance);
+extern bool PGCDictionaryEncode(PGCType instance, PGCArchiver *archiver);
+extern PGCType PGCDictionaryDecode(PGCClass *class, PGCUnarchiver *unarchiver);
 
 #pragma mark Accessors
 
@@ -57,6 +59,12 @@ extern void PGCDictionaryRemoveObjectForKey(PGCDictionary *dictionary, PGCType k
 extern void PGCDictionaryRemoveAllObjects(PGCDictionary *dictionary);
 
 extern PGCArray *PGCDictionaryGetAllKeys(PGCDictionary *dictionary);
-extern PGCArray *PGCDictionaryGetAllValues(PGCDictionary *dictionary);
+extern PGCArray *PGCDictionaryGetAllObjects(PGCDictionary *dictionary);
+extern void PGCDictionaryGetKeysAndObjects(PGCDictionary *dictionary, PGCType *keys, PGCType *objects);
+
+#pragma mark Freezing
+
+extern PGCDictionary *PGCDictionaryFreeze(PGCDictionary *dictionary);
+extern bool PGCDictionaryIsFrozen(PGCDictionary *dictionary);
 
 #endif
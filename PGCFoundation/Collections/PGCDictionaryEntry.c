@@ -36,7 +36,6 @@ struct _PGCDictionaryEntry {
 #pragma mark Private Function Interfaces
 
 void PGCDictionaryEntryDealloc(PGCType instance);
-uint64_t PGCDictionaryEntryHash(PGCType instance);
 
 
 #pragma mark -
@@ -45,7 +44,7 @@ PGCClass *PGCDictionaryEntryClass(void)
 {
     static PGCClass *dictionaryEntryClass = NULL;
     if (!dictionaryEntryClass) {
-        PGCClassFunctions functions = { PGCDictionaryEntryCopy, PGCDictionaryEntryDealloc, NULL, NULL, NULL, NULL, NULL };
+        PGCClassFunctions functions = { PGCDictionaryEntryCopy, PGCDictionaryEntryDealloc, NULL, NULL, PGCDictionaryEntryHash, NULL, NULL };
         dictionaryEntryClass = PGCClassCreate("PGCDictionaryEntry", PGCObjectClass(), functions, sizeof(PGCDictionaryEntry));
     }
     return dictionaryEntryClass;    
@@ -84,7 +83,17 @@ PGCType PGCDictionaryEntryCopy(PGCType instance)
 {
     if (!PGCObjectIsKindOfClass(instance, PGCDictionaryEntryClass())) return NULL;
     PGCDictionaryEntry *entry = instance;
-    return PGCDictionaryEntryInitWithObjectAndKey(entry, entry->object, entry->key);
+    return PGCDictionaryEntryInitWithObjectAndKey(NULL, entry->object, entry->key);
+}
+
+
+uint64_t PGCDictionaryEntryHash(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCDictionaryEntryClass())) return 0;
+    PGCDictionaryEntry *entry = instance;
+    
+    // Mix the combined hash so that dictionaries can simply add up the hashes of their entries
+    return PGCHashMix(PGCHashCombine(PGCHash(entry->key), PGCHash(entry->object)));
 }
 
 
@@ -36,6 +36,7 @@ extern PGCDictionaryEntry *PGCDictionaryEntryInstanceWithObjectAndKey(PGCType ob
 
 extern PGCDictionaryEntry *PGCDictionaryEntryInitWithObjectAndKey(PGCDictionaryEntry *entry, PGCType object, PGCType key);
 extern PGCType PGCDictionaryEntryCopy(PGCType instance);
+extern uint64_t PGCDictionaryEntryHash(PGCType instance);
 
 extern PGCType PGCDictionaryEntryGetKey(PGCDictionaryEntry *entry);
 
@@ -0,0 +1,465 @@
+//
+//  PGCIntegerArray.c
+//  PGCFoundation
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <PGCFoundation/PGCIntegerArray.h>
+
+#include <PGCFoundation/PGCInteger.h>
+#include <PGCFoundation/PGCString.h>
+
+#include <string.h>
+
+struct _PGCIntegerArray {
+    PGCObject super;
+    
+    int64_t *values;
+    uint64_t count;
+    uint64_t capacity;
+    uint64_t initialCapacity;
+};
+
+
+#pragma mark Private Global Constants
+
+static const uint64_t PGCIntegerArrayDefaultInitialCapacity = 16;
+static const double PGCIntegerArrayGrowthFactor = 1.5;
+
+// The arithmetic and search loops work on this many values per iteration, keeping one accumulator per lane. Loops written this
+// way are vectorized by the compiler for whatever vector unit the target has.
+enum { PGCIntegerArrayLaneCount = 8 };
+
+
+#pragma mark Private Function Interfaces
+
+void PGCIntegerArrayDealloc(PGCType instance);
+bool PGCIntegerArrayGrowToMinimumCapacity(PGCIntegerArray *integerArray, uint64_t minimumCapacity);
+bool PGCIntegerArrayReallocateValues(PGCIntegerArray *integerArray, uint64_t capacity);
+
+
+#pragma mark -
+
+PGCClass *PGCIntegerArrayClass(void)
+{
+    static PGCClass *integerArrayClass = NULL;
+    if (!integerArrayClass) {
+        PGCClassFunctions functions = { PGCIntegerArrayCopy, PGCIntegerArrayDealloc, PGCIntegerArrayDescription, PGCIntegerArrayEquals,
+                                        PGCIntegerArrayHash, NULL, NULL };
+        integerArrayClass = PGCClassCreate("PGCIntegerArray", PGCObjectClass(), functions, sizeof(PGCIntegerArray));
+    }
+    return integerArrayClass;
+}
+
+
+PGCIntegerArray *PGCIntegerArrayInstance(void)
+{
+    return PGCAutorelease(PGCIntegerArrayInit(NULL));
+}
+
+
+PGCIntegerArray *PGCIntegerArrayInstanceWithValues(const int64_t *values, uint64_t count)
+{
+    return PGCAutorelease(PGCIntegerArrayInitWithValues(NULL, values, count));
+}
+
+
+PGCIntegerArray *PGCIntegerArrayInstanceWithArray(PGCArray *array)
+{
+    return PGCAutorelease(PGCIntegerArrayInitWithArray(NULL, array));
+}
+
+
+#pragma mark Basic Functions
+
+PGCIntegerArray *PGCIntegerArrayInit(PGCIntegerArray *integerArray)
+{
+    return PGCIntegerArrayInitWithInitialCapacity(integerArray, 0);
+}
+
+
+PGCIntegerArray *PGCIntegerArrayInitWithInitialCapacity(PGCIntegerArray *integerArray, uint64_t initialCapacity)
+{
+    if (!integerArray && (integerArray = PGCAlloc(PGCIntegerArrayClass())) == NULL) return NULL;
+    PGCObjectInit(&integerArray->super);
+    
+    // As with PGCArray, the values buffer isn’t allocated until the first value is added
+    integerArray->values = NULL;
+    integerArray->count = 0;
+    integerArray->capacity = 0;
+    integerArray->initialCapacity = initialCapacity > 0 ? initialCapacity : PGCIntegerArrayDefaultInitialCapacity;
+    return integerArray;
+}
+
+
+PGCIntegerArray *PGCIntegerArrayInitWithValues(PGCIntegerArray *integerArray, const int64_t *values, uint64_t count)
+{
+    integerArray = PGCIntegerArrayInitWithInitialCapacity(integerArray, count);
+    if (!integerArray) return NULL;
+    
+    PGCIntegerArrayAddValues(integerArray, values, count);
+    return integerArray;
+}
+
+
+PGCIntegerArray *PGCIntegerArrayInitWithArray(PGCIntegerArray *integerArray, PGCArray *array)
+{
+    uint64_t count = PGCArrayGetCount(array);
+    integerArray = PGCIntegerArrayInitWithInitialCapacity(integerArray, count);
+    if (!integerArray) return NULL;
+    
+    // Every object in the array must be a PGCInteger; unsigned values are stored as their two’s complement bit patterns
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+    for (uint64_t i = 0; i < count; i++) {
+        PGCType object = PGCArrayGetObjectAtIndex(array, i);
+        if (!PGCObjectIsKindOfClass(object, PGCIntegerClass())) {
+            PGCAutoreleasePoolDestroy(pool);
+            PGCRelease(integerArray);
+            return NULL;
+        }
+        
+        PGCIntegerArrayAddValue(integerArray, PGCIntegerGetSignedValue(object));
+    }
+    
+    PGCAutoreleasePoolDestroy(pool);
+    return integerArray;
+}
+
+
+void PGCIntegerArrayDealloc(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCIntegerArrayClass())) return;
+    free(((PGCIntegerArray *)instance)->values);
+    PGCSuperclassDealloc(instance);
+}
+
+
+PGCType PGCIntegerArrayCopy(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCIntegerArrayClass())) return NULL;
+    PGCIntegerArray *integerArray = instance;
+    return PGCIntegerArrayInitWithValues(NULL, integerArray->values, integerArray->count);
+}
+
+
+PGCString *PGCIntegerArrayDescription(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCIntegerArrayClass())) return NULL;
+    PGCIntegerArray *integerArray = instance;
+    
+    PGCString *description = PGCStringInstanceWithCString("[");
+    for (uint64_t i = 0; i < integerArray->count; i++) {
+        PGCStringAppendFormat(description, i == 0 ? "%lld" : ", %lld", integerArray->values[i]);
+    }
+    
+    PGCStringAppendFormat(description, "]");
+    return description;
+}
+
+
+bool PGCIntegerArrayEquals(PGCType instance1, PGCType instance2)
+{
+    if (!PGCObjectIsKindOfClass(instance1, PGCIntegerArrayClass()) || !PGCObjectIsKindOfClass(instance2, PGCIntegerArrayClass())) return false;
+    
+    PGCIntegerArray *integerArray1 = instance1;
+    PGCIntegerArray *integerArray2 = instance2;
+    if (integerArray1->count != integerArray2->count) return false;
+    return integerArray1->count == 0 || memcmp(integerArray1->values, integerArray2->values, integerArray1->count * sizeof(int64_t)) == 0;
+}
+
+
+uint64_t PGCIntegerArrayHash(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCIntegerArrayClass())) return 0;
+    PGCIntegerArray *integerArray = instance;
+    
+    uint64_t hash = 0;
+    for (uint64_t i = 0; i < integerArray->count; i++) hash = PGCHashCombine(hash, (uint64_t)integerArray->values[i]);
+    return hash;
+}
+
+
+#pragma mark Accessors
+
+uint64_t PGCIntegerArrayGetCount(PGCIntegerArray *integerArray)
+{
+    return integerArray ? integerArray->count : 0;
+}
+
+
+const int64_t *PGCIntegerArrayGetValues(PGCIntegerArray *integerArray)
+{
+    return integerArray ? integerArray->values : NULL;
+}
+
+
+int64_t PGCIntegerArrayGetValueAtIndex(PGCIntegerArray *integerArray, uint64_t index)
+{
+    return integerArray && index < integerArray->count ? integerArray->values[index] : 0;
+}
+
+
+uint64_t PGCIntegerArrayGetIndexOfValue(PGCIntegerArray *integerArray, int64_t value)
+{
+    return integerArray ? PGCIntegerArrayGetIndexOfValueInRange(integerArray, value, PGCMakeRange(0, integerArray->count)) : PGCNotFound;
+}
+
+
+uint64_t PGCIntegerArrayGetIndexOfValueInRange(PGCIntegerArray *integerArray, int64_t value, PGCRange range)
+{
+    if (!integerArray || range.location >= integerArray->count || range.location + range.length > integerArray->count) return PGCNotFound;
+    
+    // Compare a full set of lanes at a time, and only find the exact index once one of them matches
+    const int64_t *values = integerArray->values;
+    uint64_t i = range.location;
+    uint64_t lastIndex = range.location + range.length;
+    for (; i + PGCIntegerArrayLaneCount <= lastIndex; i += PGCIntegerArrayLaneCount) {
+        bool matched = false;
+        for (uint64_t lane = 0; lane < PGCIntegerArrayLaneCount; lane++) matched |= values[i + lane] == value;
+        if (matched) break;
+    }
+    
+    for (; i < lastIndex; i++) if (values[i] == value) return i;
+    return PGCNotFound;
+}
+
+
+#pragma mark Value Addition, Replacement, and Removal
+
+void PGCIntegerArrayAddValue(PGCIntegerArray *integerArray, int64_t value)
+{
+    PGCIntegerArrayAddValues(integerArray, &value, 1);
+}
+
+
+void PGCIntegerArrayAddValues(PGCIntegerArray *integerArray, const int64_t *values, uint64_t count)
+{
+    if (!integerArray || !values || count == 0 || !PGCIntegerArrayGrowToMinimumCapacity(integerArray, integerArray->count + count)) return;
+    memcpy(&integerArray->values[integerArray->count], values, count * sizeof(int64_t));
+    integerArray->count += count;
+}
+
+
+void PGCIntegerArrayInsertValueAtIndex(PGCIntegerArray *integerArray, int64_t value, uint64_t index)
+{
+    if (!integerArray || index > integerArray->count || !PGCIntegerArrayGrowToMinimumCapacity(integerArray, integerArray->count + 1)) return;
+    memmove(&integerArray->values[index + 1], &integerArray->values[index], (integerArray->count - index) * sizeof(int64_t));
+    integerArray->values[index] = value;
+    integerArray->count++;
+}
+
+
+void PGCIntegerArrayReplaceValueAtIndex(PGCIntegerArray *integerArray, int64_t value, uint64_t index)
+{
+    if (!integerArray || index >= integerArray->count) return;
+    integerArray->values[index] = value;
+}
+
+
+void PGCIntegerArrayRemoveValueAtIndex(PGCIntegerArray *integerArray, uint64_t index)
+{
+    PGCIntegerArrayRemoveValuesInRange(integerArray, PGCMakeRange(index, 1));
+}
+
+
+void PGCIntegerArrayRemoveValuesInRange(PGCIntegerArray *integerArray, PGCRange range)
+{
+    if (!integerArray || range.location >= integerArray->count || range.location + range.length > integerArray->count) return;
+    
+    uint64_t tailCount = integerArray->count - range.location - range.length;
+    memmove(&integerArray->values[range.location], &integerArray->values[range.location + range.length], tailCount * sizeof(int64_t));
+    integerArray->count -= range.length;
+}
+
+
+void PGCIntegerArrayRemoveAllValues(PGCIntegerArray *integerArray)
+{
+    if (!integerArray) return;
+    integerArray->count = 0;
+}
+
+
+#pragma mark Arithmetic
+
+int64_t PGCIntegerArrayGetSum(PGCIntegerArray *integerArray)
+{
+    if (!integerArray) return 0;
+    
+    // Sums are computed with unsigned arithmetic so that overflow wraps around rather than being undefined
+    const int64_t *values = integerArray->values;
+    uint64_t sums[PGCIntegerArrayLaneCount] = { 0 };
+    uint64_t i = 0;
+    for (; i + PGCIntegerArrayLaneCount <= integerArray->count; i += PGCIntegerArrayLaneCount) {
+        for (uint64_t lane = 0; lane < PGCIntegerArrayLaneCount; lane++) sums[lane] += (uint64_t)values[i + lane];
+    }
+    
+    uint64_t sum = 0;
+    for (uint64_t lane = 0; lane < PGCIntegerArrayLaneCount; lane++) sum += sums[lane];
+    for (; i < integerArray->count; i++) sum += (uint64_t)values[i];
+    return (int64_t)sum;
+}
+
+
+int64_t PGCIntegerArrayGetMinimum(PGCIntegerArray *integerArray)
+{
+    if (!integerArray || integerArray->count == 0) return 0;
+    
+    const int64_t *values = integerArray->values;
+    int64_t minimums[PGCIntegerArrayLaneCount];
+    for (uint64_t lane = 0; lane < PGCIntegerArrayLaneCount; lane++) minimums[lane] = values[0];
+    
+    uint64_t i = 0;
+    for (; i + PGCIntegerArrayLaneCount <= integerArray->count; i += PGCIntegerArrayLaneCount) {
+        for (uint64_t lane = 0; lane < PGCIntegerArrayLaneCount; lane++) {
+            minimums[lane] = values[i + lane] < minimums[lane] ? values[i + lane] : minimums[lane];
+        }
+    }
+    
+    int64_t minimum = minimums[0];
+    for (uint64_t lane = 1; lane < PGCIntegerArrayLaneCount; lane++) if (minimums[lane] < minimum) minimum = minimums[lane];
+    for (; i < integerArray->count; i++) if (values[i] < minimum) minimum = values[i];
+    return minimum;
+}
+
+
+int64_t PGCIntegerArrayGetMaximum(PGCIntegerArray *integerArray)
+{
+    if (!integerArray || integerArray->count == 0) return 0;
+    
+    const int64_t *values = integerArray->values;
+    int64_t maximums[PGCIntegerArrayLaneCount];
+    for (uint64_t lane = 0; lane < PGCIntegerArrayLaneCount; lane++) maximums[lane] = values[0];
+    
+    uint64_t i = 0;
+    for (; i + PGCIntegerArrayLaneCount <= integerArray->count; i += PGCIntegerArrayLaneCount) {
+        for (uint64_t lane = 0; lane < PGCIntegerArrayLaneCount; lane++) {
+            maximums[lane] = values[i + lane] > maximums[lane] ? values[i + lane] : maximums[lane];
+        }
+    }
+    
+    int64_t maximum = maximums[0];
+    for (uint64_t lane = 1; lane < PGCIntegerArrayLaneCount; lane++) if (maximums[lane] > maximum) maximum = maximums[lane];
+    for (; i < integerArray->count; i++) if (values[i] > maximum) maximum = values[i];
+    return maximum;
+}
+
+
+int64_t PGCIntegerArrayGetDotProduct(PGCIntegerArray *integerArray1, PGCIntegerArray *integerArray2)
+{
+    if (!integerArray1 || !integerArray2 || integerArray1->count != integerArray2->count) return 0;
+    
+    const int64_t *values1 = integerArray1->values;
+    const int64_t *values2 = integerArray2->values;
+    uint64_t sums[PGCIntegerArrayLaneCount] = { 0 };
+    uint64_t i = 0;
+    for (; i + PGCIntegerArrayLaneCount <= integerArray1->count; i += PGCIntegerArrayLaneCount) {
+        for (uint64_t lane = 0; lane < PGCIntegerArrayLaneCount; lane++) sums[lane] += (uint64_t)values1[i + lane] * (uint64_t)values2[i + lane];
+    }
+    
+    uint64_t sum = 0;
+    for (uint64_t lane = 0; lane < PGCIntegerArrayLaneCount; lane++) sum += sums[lane];
+    for (; i < integerArray1->count; i++) sum += (uint64_t)values1[i] * (uint64_t)values2[i];
+    return (int64_t)sum;
+}
+
+
+void PGCIntegerArrayScan(PGCIntegerArray *integerArray)
+{
+    if (!integerArray) return;
+    
+    // Replaces each value with the sum of it and every value before it
+    int64_t *values = integerArray->values;
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < integerArray->count; i++) {
+        sum += (uint64_t)values[i];
+        values[i] = (int64_t)sum;
+    }
+}
+
+
+#pragma mark Boxing
+
+PGCArray *PGCIntegerArrayGetArray(PGCIntegerArray *integerArray)
+{
+    if (!integerArray) return NULL;
+    
+    PGCArray *array = PGCArrayInitWithInitialCapacity(NULL, integerArray->count);
+    if (!array) return NULL;
+    
+    for (uint64_t i = 0; i < integerArray->count; i++) {
+        PGCInteger *integer = PGCIntegerInitWithSignedValue(NULL, integerArray->values[i]);
+        PGCArrayAddObject(array, integer);
+        PGCRelease(integer);
+    }
+    
+    return PGCAutorelease(array);
+}
+
+
+#pragma mark Memory Management
+
+uint64_t PGCIntegerArrayGetCapacity(PGCIntegerArray *integerArray)
+{
+    return integerArray ? integerArray->capacity : 0;
+}
+
+
+void PGCIntegerArrayReserveCapacity(PGCIntegerArray *integerArray, uint64_t capacity)
+{
+    if (!integerArray || capacity <= integerArray->capacity) return;
+    PGCIntegerArrayReallocateValues(integerArray, capacity);
+}
+
+
+void PGCIntegerArrayCondense(PGCIntegerArray *integerArray)
+{
+    if (!integerArray || integerArray->capacity == integerArray->count) return;
+    PGCIntegerArrayReallocateValues(integerArray, integerArray->count);
+}
+
+
+bool PGCIntegerArrayGrowToMinimumCapacity(PGCIntegerArray *integerArray, uint64_t minimumCapacity)
+{
+    if (minimumCapacity <= integerArray->capacity) return true;
+    
+    uint64_t capacity = integerArray->capacity > 0 ? (uint64_t)(integerArray->capacity * PGCIntegerArrayGrowthFactor) : integerArray->initialCapacity;
+    return PGCIntegerArrayReallocateValues(integerArray, capacity < minimumCapacity ? minimumCapacity : capacity);
+}
+
+
+bool PGCIntegerArrayReallocateValues(PGCIntegerArray *integerArray, uint64_t capacity)
+{
+    if (capacity == 0) {
+        free(integerArray->values);
+        integerArray->values = NULL;
+        integerArray->capacity = 0;
+        return true;
+    }
+    
+    int64_t *reallocedValues = realloc(integerArray->values, capacity * sizeof(int64_t));
+    if (!reallocedValues) return false;
+    
+    integerArray->values = reallocedValues;
+    integerArray->capacity = capacity;
+    return true;
+}
@@ -0,0 +1,89 @@
+//
+//  PGCIntegerArray.h
+//  PGCFoundation
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef PGCINTEGERARRAY_H
+#define PGCINTEGERARRAY_H
+
+#include <PGCFoundation/PGCObject.h>
+#include <PGCFoundation/PGCArray.h>
+
+typedef struct _PGCIntegerArray PGCIntegerArray;
+
+extern PGCClass *PGCIntegerArrayClass(void);
+extern PGCIntegerArray *PGCIntegerArrayInstance(void);
+extern PGCIntegerArray *PGCIntegerArrayInstanceWithValues(const int64_t *values, uint64_t count);
+extern PGCIntegerArray *PGCIntegerArrayInstanceWithArray(PGCArray *array);
+
+#pragma mark Basic Functions
+
+extern PGCIntegerArray *PGCIntegerArrayInit(PGCIntegerArray *integerArray);
+extern PGCIntegerArray *PGCIntegerArrayInitWithInitialCapacity(PGCIntegerArray *integerArray, uint64_t initialCapacity);
+extern PGCIntegerArray *PGCIntegerArrayInitWithValues(PGCIntegerArray *integerArray, const int64_t *values, uint64_t count);
+extern PGCIntegerArray *PGCIntegerArrayInitWithArray(PGCIntegerArray *integerArray, PGCArray *array);
+
+extern PGCType PGCIntegerArrayCopy(PGCType instance);
+extern PGCString *PGCIntegerArrayDescription(PGCType instance);
+extern bool PGCIntegerArrayEquals(PGCType instance1, PGCType instance2);
+extern uint64_t PGCIntegerArrayHash(PGCType instance);
+
+#pragma mark Accessors
+
+extern uint64_t PGCIntegerArrayGetCount(PGCIntegerArray *integerArray);
+extern const int64_t *PGCIntegerArrayGetValues(PGCIntegerArray *integerArray);
+extern int64_t PGCIntegerArrayGetValueAtIndex(PGCIntegerArray *integerArray, uint64_t index);
+
+extern uint64_t PGCIntegerArrayGetIndexOfValue(PGCIntegerArray *integerArray, int64_t value);
+extern uint64_t PGCIntegerArrayGetIndexOfValueInRange(PGCIntegerArray *integerArray, int64_t value, PGCRange range);
+
+#pragma mark Value Addition, Replacement, and Removal
+
+extern void PGCIntegerArrayAddValue(PGCIntegerArray *integerArray, int64_t value);
+extern void PGCIntegerArrayAddValues(PGCIntegerArray *integerArray, const int64_t *values, uint64_t count);
+extern void PGCIntegerArrayInsertValueAtIndex(PGCIntegerArray *integerArray, int64_t value, uint64_t index);
+extern void PGCIntegerArrayReplaceValueAtIndex(PGCIntegerArray *integerArray, int64_t value, uint64_t index);
+extern void PGCIntegerArrayRemoveValueAtIndex(PGCIntegerArray *integerArray, uint64_t index);
+extern void PGCIntegerArrayRemoveValuesInRange(PGCIntegerArray *integerArray, PGCRange range);
+extern void PGCIntegerArrayRemoveAllValues(PGCIntegerArray *integerArray);
+
+#pragma mark Arithmetic
+
+extern int64_t PGCIntegerArrayGetSum(PGCIntegerArray *integerArray);
+extern int64_t PGCIntegerArrayGetMinimum(PGCIntegerArray *integerArray);
+extern int64_t PGCIntegerArrayGetMaximum(PGCIntegerArray *integerArray);
+extern int64_t PGCIntegerArrayGetDotProduct(PGCIntegerArray *integerArray1, PGCIntegerArray *integerArray2);
+extern void PGCIntegerArrayScan(PGCIntegerArray *integerArray);
+
+#pragma mark Boxing
+
+extern PGCArray *PGCIntegerArrayGetArray(PGCIntegerArray *integerArray);
+
+#pragma mark Memory Management
+
+extern uint64_t PGCIntegerArrayGetCapacity(PGCIntegerArray *integerArray);
+extern void PGCIntegerArrayReserveCapacity(PGCIntegerArray *integerArray, uint64_t capacity);
+extern void PGCIntegerArrayCondense(PGCIntegerArray *integerArray);
+
+#endif
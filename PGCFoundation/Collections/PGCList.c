@@ -23,35 +23,131 @@
 //  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 //  THE SOFTWARE.
 //
-
 #include <PGCFoundation/PGCList.h>
+#include <PGCFoundation/PGCArchiver.h>
+
+#include <dispatch/dispatch.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
 
 #pragma mark - PGCListNode
 
+typedef struct _PGCListEntry {
+    PGCType object;
+    uint64_t objectHash;
+} PGCListEntry;
+
+
+// Each node holds up to capacity objects. Ordinary lists use single-object nodes; unrolled lists pack several objects into each
+// node, which means fewer allocations and better locality when walking the list.
 typedef struct _PGCListNode PGCListNode;
 struct _PGCListNode {
     PGCListNode *previous;
     PGCListNode *next;
-    PGCType object;
+    uint32_t count;
+    uint16_t capacity;
+    
+    // In indexed lists, a node of height h is also linked into skip list levels 0 through h - 1. Its skip links are stored
+    // after its entries.
+    uint8_t height;
+    bool isIndexed;
+    PGCListEntry entries[];
 };
 
 
+// A skip link points to the next node at its level. Its width is the number of objects from the start of the node it belongs
+// to up to the start of the next node, or to the end of the list if there is no next node.
+typedef struct _PGCListSkipLink {
+    PGCListNode *next;
+    uint64_t width;
+} PGCListSkipLink;
+
+
 struct _PGCList {
     PGCObject super;
     
     PGCListNode *head;
     PGCListNode *tail;
+    
+    // current is the most recently accessed node and currentIndex is the index of its first object
     PGCListNode *current;
+    uint64_t currentIndex;
     
     uint64_t count;
-    uint64_t currentIndex;
+    uint64_t nodeCapacity;
+    
+    // Incremented whenever objects are inserted or removed so that cursors can tell when their position is no longer valid
+    uint64_t mutationCount;
+
+    uint64_t hash;
+    bool hashIsValid;
+    bool cachesObjectHashes;
+    
+    // Indexed lists keep a skip list over their nodes. indexLinks are the head links for each level.
+    bool isIndexed;
+    PGCListSkipLink *indexLinks;
+    uint64_t indexLevelCount;
+    uint64_t randomState;
 };
 
+
+#pragma mark Private Global Constants
+
+static const uint64_t PGCListMaximumNodeCapacity = 1024;
+static const uint64_t PGCListNodeChunkCount = 1024;
+static const uint64_t PGCListMaximumThreadFreeNodeCount = 2 * PGCListNodeChunkCount;
+static const uint64_t PGCListJoinDrainInterval = 256;
+
+// Used to size the search paths kept on the stack, so this needs to be a constant expression
+enum { PGCListMaximumIndexLevelCount = 24 };
+
+
+#pragma mark Private Global Variables
+
+// Single-object nodes are carved out of large chunks and recycled through a free list owned by the current thread, so no locking
+// is needed to allocate or free them. A node freed on a different thread than the one that allocated it joins the freeing
+// thread’s list. So that threads that mostly free nodes don’t hoard them while threads that mostly allocate nodes keep carving
+// new chunks, a thread’s list is capped, and batches of its excess nodes are moved to a shared list, which threads take batches
+// from before allocating a new chunk. When a thread exits, its free nodes are moved to the shared list as well.
+//
+// Batches on the shared list are linked through their first nodes’ previous pointers, and their first nodes’ counts hold the
+// number of nodes in the batch.
+static __thread PGCListNode *PGCListThreadFreeNodes = NULL;
+static __thread uint64_t PGCListThreadFreeNodeCount = 0;
+static __thread bool PGCListThreadIsRegistered = false;
+
+static pthread_once_t PGCListNodePoolOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t PGCListNodePoolKey;
+static pthread_mutex_t PGCListSharedFreeNodesMutex = PTHREAD_MUTEX_INITIALIZER;
+static PGCListNode *PGCListSharedFreeNodeBatches = NULL;
+
+
 #pragma mark Private Function Interfaces
 
 PGCList *PGCListInitWithObjectAndObjectArguments(PGCList *list, PGCType firstObject, va_list objectArguments);
 void PGCListDealloc(PGCType instance);
-PGCListNode *PGCListGetNodeAtIndex(PGCList *list, uint64_t index);
+PGCListNode *PGCListGetNodeAtIndex(PGCList *list, uint64_t index, uint64_t *offset);
+PGCListEntry *PGCListGetEntryAtIndex(PGCList *list, uint64_t index);
+void PGCListLinkNodeAfterNode(PGCList *list, PGCListNode *node, PGCListNode *previousNode);
+void PGCListUnlinkNode(PGCList *list, PGCListNode *node);
+bool PGCListSplitNodeAtIndex(PGCList *list, uint64_t index, PGCListNode **nextNode);
+PGCListNode *PGCListIndexFindNode(PGCList *list, uint64_t index, PGCListSkipLink **path, uint64_t *pathPositions, uint64_t *nodeIndex);
+void PGCListIndexInsertNode(PGCList *list, PGCListNode *node, uint64_t nodeIndex, PGCListSkipLink **path, uint64_t *pathPositions);
+void PGCListIndexRemoveNode(PGCList *list, PGCListNode *node, uint64_t nodeIndex);
+void PGCListIndexRebuild(PGCList *list);
+uint64_t PGCListIndexRandomHeight(PGCList *list);
+bool PGCListCursorIsValid(PGCListCursor *cursor);
+void PGCListCursorSeekToIndex(PGCListCursor *cursor, uint64_t index);
+
+PGCListNode *PGCListNodeCreate(PGCList *list, uint64_t capacity);
+void PGCListNodeDestroy(PGCListNode *node);
+PGCListSkipLink *PGCListNodeGetSkipLinks(PGCListNode *node);
+bool PGCListNodePoolRefill(void);
+void PGCListNodePoolRegisterThread(void);
+void PGCListNodePoolShareNodes(PGCListNode *nodes, uint64_t count);
+void PGCListNodePoolCreateKey(void);
+void PGCListNodePoolThreadDidExit(void *value);
 
 
 #pragma mark - PGCList
@@ -60,7 +156,8 @@ PGCClass *PGCListClass(void)
 {
     static PGCClass *listClass = NULL;
     if (!listClass) {
-        PGCClassFunctions functions = { PGCListCopy, PGCListDealloc, PGCListDescription, PGCListEquals, PGCListHash, NULL, NULL };
+        PGCClassFunctions functions = { PGCListCopy, PGCListDealloc, PGCListDescription, PGCListEquals, PGCListHash,
+                                        NULL, NULL, PGCListEncode, PGCListDecode };
         listClass = PGCClassCreate("PGCList", PGCObjectClass(), functions, sizeof(PGCList));
     }
     return listClass;
@@ -88,10 +185,20 @@ PGCList *PGCListInstanceWithObjects(PGCType object1, ...)
 #pragma mark Basic Functions
 
 PGCList *PGCListInit(PGCList *list)
+{
+    return PGCListInitWithNodeCapacity(list, 1);
+}
+
+
+PGCList *PGCListInitWithNodeCapacity(PGCList *list, uint64_t nodeCapacity)
 {
     if (!list && (list = PGCAlloc(PGCListClass())) == NULL) return NULL;
     PGCObjectInit(&list->super);
     list->currentIndex = PGCNotFound;
+    list->randomState = (uintptr_t)list * 0x9E3779B97F4A7C15ULL | 1;
+    
+    if (nodeCapacity < 1) nodeCapacity = 1;
+    list->nodeCapacity = nodeCapacity < PGCListMaximumNodeCapacity ? nodeCapacity : PGCListMaximumNodeCapacity;
     return list;
 }
 
@@ -127,6 +234,7 @@ void PGCListDealloc(PGCType instance)
 {
     if (!PGCObjectIsKindOfClass(instance, PGCListClass())) return;
     PGCListRemoveAllObjects((PGCList *)instance);
+    free(((PGCList *)instance)->indexLinks);
     PGCSuperclassDealloc(instance);
 }
 
@@ -136,8 +244,16 @@ PGCType PGCListCopy(PGCType instance)
     if (!PGCObjectIsKindOfClass(instance, PGCListClass())) return NULL;
     PGCList *list = instance;
     
-    PGCList *copy = PGCListInit(NULL);
-    for (uint64_t i = 0; i < list->count; i++) PGCListAddObject(copy, PGCListGetNodeAtIndex(list, i)->object);
+    PGCList *copy = PGCListInitWithNodeCapacity(NULL, list->nodeCapacity);
+    if (!copy) return NULL;
+    
+    copy->cachesObjectHashes = list->cachesObjectHashes;
+    PGCListSetIndexed(copy, list->isIndexed);
+    PGCListCursor cursor = PGCListGetCursorAtIndex(list, 0);
+    PGCType object;
+    while ((object = PGCListCursorNext(&cursor))) PGCListAddObject(copy, object);
+    copy->hash = list->hash;
+    copy->hashIsValid = list->hashIsValid;
     
     return copy;
 }
@@ -157,14 +273,14 @@ bool PGCListEquals(PGCType instance1, PGCType instance2)
     
     PGCList *list1 = instance1;
     PGCList *list2 = instance2;
+    if (list1 == list2) return true;
     if (list1->count != list2->count) return false;
     
+    // Cached hashes can't be used to rule out equality, since they go stale when contained objects are mutated in place
+    PGCListCursor cursor1 = PGCListGetCursorAtIndex(list1, 0);
+    PGCListCursor cursor2 = PGCListGetCursorAtIndex(list2, 0);
     for (uint64_t i = 0; i < list1->count; i++) {
-        PGCType listObject1 = PGCListGetNodeAtIndex(list1, i)->object;
-        PGCType listObject2 = PGCListGetNodeAtIndex(list2, i)->object;
-        
-        if (PGCHash(listObject1) != PGCHash(listObject2)) return false;
-        if (!PGCEquals(listObject1, listObject2)) return false;
+        if (!PGCEquals(PGCListCursorNext(&cursor1), PGCListCursorNext(&cursor2))) return false;
     }
     
     return true;
@@ -174,7 +290,60 @@ bool PGCListEquals(PGCType instance1, PGCType instance2)
 uint64_t PGCListHash(PGCType instance)
 {
     if (!PGCObjectIsKindOfClass(instance, PGCListClass())) return 0;
-    return ((PGCList *)instance)->count;
+    PGCList *list = instance;
+
+    // As with arrays, the hash is computed lazily, cached until the list is mutated, and kept up to date when objects are appended
+    if (!list->hashIsValid) {
+        uint64_t hash = 0;
+        for (PGCListNode *node = list->head; node; node = node->next) {
+            for (uint64_t i = 0; i < node->count; i++) hash = PGCHashCombine(hash, PGCHash(node->entries[i].object));
+        }
+        
+        list->hash = hash;
+        list->hashIsValid = true;
+    }
+    
+    return list->hash;
+}
+
+
+bool PGCListEncode(PGCType instance, PGCArchiver *archiver)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCListClass())) return false;
+    PGCList *list = instance;
+    
+    PGCArchiverEncodeCount(archiver, list->count);
+    for (PGCListNode *node = list->head; node; node = node->next) {
+        for (uint64_t i = 0; i < node->count; i++) {
+            if (!PGCArchiverEncodeObject(archiver, node->entries[i].object)) return false;
+        }
+    }
+    
+    return true;
+}
+
+
+PGCType PGCListDecode(PGCClass *class, PGCUnarchiver *unarchiver)
+{
+    uint64_t count = 0;
+    if (!PGCUnarchiverDecodeCount(unarchiver, &count)) return NULL;
+    
+    PGCList *list = PGCListInit(PGCAlloc(class));
+    if (!list) return NULL;
+    
+    for (uint64_t i = 0; i < count; i++) {
+        // Claiming each decoded object keeps it out of the autorelease pool
+        PGCType object = PGCRetainAutoreleasedReturnValue(PGCUnarchiverDecodeObject(unarchiver));
+        if (!object) {
+            PGCRelease(list);
+            return NULL;
+        }
+        
+        PGCListAddObject(list, object);
+        PGCRelease(object);
+    }
+    
+    return list;
 }
 
 
@@ -194,60 +363,76 @@ bool PGCListContainsObject(PGCList *list, PGCType instance)
 
 PGCType PGCListGetObjectAtIndex(PGCList *list, uint64_t index)
 {
-    PGCListNode *node = PGCListGetNodeAtIndex(list, index);
-    return node ? PGCAutorelease(PGCRetain(node->object)) : NULL;
+    PGCListEntry *entry = PGCListGetEntryAtIndex(list, index);
+    return entry ? PGCAutorelease(PGCRetain(entry->object)) : NULL;
 }
 
 
-PGCListNode *PGCListGetNodeAtIndex(PGCList *list, uint64_t index)
+PGCListNode *PGCListGetNodeAtIndex(PGCList *list, uint64_t index, uint64_t *offset)
 {
     if (!list || index >= list->count) return NULL;
+    
+    // Indexed lists search their skip list unless the index is in the current node
+    if (list->isIndexed && !(list->current && index >= list->currentIndex && index - list->currentIndex < list->current->count)) {
+        uint64_t nodeIndex = 0;
+        PGCListNode *node = PGCListIndexFindNode(list, index, NULL, NULL, &nodeIndex);
+        if (offset) *offset = index - nodeIndex;
+        return node;
+    }
 
-    // Simple optimization: if we already have a pointer to the node we want, don't bother doing any calculating or iterating
-    if (index == 0) {
-        list->currentIndex = index;
-        list->current = list->head;
-        return list->current;
-    } else if (index == list->count - 1) {
-        list->currentIndex = index;
-        list->current = list->tail;
-        return list->current;
-    } else if (index == list->currentIndex) {
-        return list->current;
-    }
-    
-    // Otherwise we have some calculating and iterating to do
-    uint64_t distanceFromHead = index;
-    uint64_t distanceFromTail = list->count - 1 - index;
-    uint64_t distanceFromCurrent = (list->currentIndex > index) ? list->currentIndex - index : index - list->currentIndex;
-    
-    PGCListNode *iterator = NULL;
-    uint64_t distanceLeft = 0;
-    bool goForward = false;
-    
-    // Of the head, tail, and current nodes, determine which is closest to the index we want
-    if (distanceFromHead <= distanceFromTail && distanceFromHead <= distanceFromCurrent) {
-        iterator = list->head;
-        distanceLeft = distanceFromHead;
-        goForward = true;
-    } else if (distanceFromTail <= distanceFromHead && distanceFromTail <= distanceFromCurrent) {
-        iterator = list->tail;
-        distanceLeft = distanceFromTail;
+    // Start from whichever of the head, tail, and current node is closest to the index we want. Distances are measured in 
+    // objects, which for unrolled lists overestimates the number of nodes we have to visit by the same factor for each.
+    PGCListNode *node = list->head;
+    uint64_t nodeIndex = 0;
+    bool goForward = true;
+    
+    uint64_t tailIndex = list->count - list->tail->count;
+    if (list->current) {
+        if (index >= list->currentIndex) {
+            if (index - list->currentIndex <= list->count - index) {
+                node = list->current;
+                nodeIndex = list->currentIndex;
+            } else {
+                node = list->tail;
+                nodeIndex = tailIndex;
+                goForward = false;
+            }
+        } else if (list->currentIndex - index < index) {
+            node = list->current;
+            nodeIndex = list->currentIndex;
+            goForward = false;
+        }
+    } else if (list->count - index < index) {
+        node = list->tail;
+        nodeIndex = tailIndex;
         goForward = false;
-    } else {
-        iterator = list->current;
-        distanceLeft = distanceFromCurrent;
-        goForward = (index > list->currentIndex);
     }
     
-    while (distanceLeft-- > 0) {
-        iterator = goForward ? iterator->next : iterator->previous;
+    if (goForward) {
+        while (index >= nodeIndex + node->count) {
+            nodeIndex += node->count;
+            node = node->next;
+        }
+    } else {
+        while (index < nodeIndex) {
+            node = node->previous;
+            nodeIndex -= node->count;
+        }
     }
     
-    list->currentIndex = index;
-    list->current = iterator;
+    list->current = node;
+    list->currentIndex = nodeIndex;
+    
+    if (offset) *offset = index - nodeIndex;
+    return node;
+}
 
-    return list->current;
+
+PGCListEntry *PGCListGetEntryAtIndex(PGCList *list, uint64_t index)
+{
+    uint64_t offset = 0;
+    PGCListNode *node = PGCListGetNodeAtIndex(list, index, &offset);
+    return node ? &node->entries[offset] : NULL;
 }
 
 
@@ -275,10 +460,19 @@ uint64_t PGCListGetIndexOfObjectInRange(PGCList *list, PGCType instance, PGCRang
     
     uint64_t instanceHash = PGCHash(instance);
     
+    // Walk the nodes directly rather than looking each one up by index. If we cache object hashes, each entry has its object’s.
     uint64_t lastIndex = range.location + range.length;
+    uint64_t offset = 0;
+    PGCListNode *node = PGCListGetNodeAtIndex(list, range.location, &offset);
     for (uint64_t i = range.location; i < lastIndex; i++) {
-        PGCType object = PGCListGetNodeAtIndex(list, i)->object;
-        if (PGCHash(object) == instanceHash && PGCEquals(instance, object)) return i;
+        PGCListEntry *entry = &node->entries[offset];
+        uint64_t objectHash = list->cachesObjectHashes ? entry->objectHash : PGCHash(entry->object);
+        if (objectHash == instanceHash && PGCEquals(instance, entry->object)) return i;
+        
+        if (++offset == node->count) {
+            node = node->next;
+            offset = 0;
+        }
     }
     
     return PGCNotFound;
@@ -294,9 +488,10 @@ uint64_t PGCListGetIndexOfIdenticalObjectInRange(PGCList *list, PGCType instance
 {
     if (!list || !instance || list->count == 0 || range.location >= list->count || range.location + range.length > list->count) return PGCNotFound;
     
+    PGCListCursor cursor = PGCListGetCursorAtIndex(list, range.location);
     uint64_t lastIndex = range.location + range.length;
     for (uint64_t i = range.location; i < lastIndex; i++) {
-        if (PGCListGetNodeAtIndex(list, i)->object == instance) return i;   
+        if (PGCListCursorNext(&cursor) == instance) return i;
     }
     
     return PGCNotFound;
@@ -309,16 +504,141 @@ PGCList *PGCListSublistWithRange(PGCList *list, PGCRange range)
 {
     if (!list || range.location >= list->count || range.location + range.length > list->count) return NULL;
     
-    PGCList *sublist = PGCListInit(NULL);
-    uint64_t lastIndex = range.location + range.length;
-    for (uint64_t i = range.location; i < lastIndex; i++) {
-        PGCListAddObject(sublist, PGCListGetNodeAtIndex(list, i)->object);
-    }
+    PGCList *sublist = PGCListInitWithNodeCapacity(NULL, list->nodeCapacity);
+    PGCListSetIndexed(sublist, list->isIndexed);
+    PGCListCursor cursor = PGCListGetCursorAtIndex(list, range.location);
+    for (uint64_t i = 0; i < range.length; i++) PGCListAddObject(sublist, PGCListCursorNext(&cursor));
     
     return PGCAutorelease(sublist);
 }
 
 
+#pragma mark Splicing and Splitting
+
+void PGCListAppendList(PGCList *list, PGCList *otherList)
+{
+    if (!list) return;
+    PGCListSpliceListAtIndex(list, otherList, list->count);
+}
+
+
+void PGCListSpliceListAtIndex(PGCList *list, PGCList *otherList, uint64_t index)
+{
+    if (!list || !otherList || list == otherList || index > list->count || otherList->count == 0) return;
+    
+    PGCListNode *nextNode = NULL;
+    if (!PGCListSplitNodeAtIndex(list, index, &nextNode)) return;
+    PGCListNode *previousNode = nextNode ? nextNode->previous : list->tail;
+    
+    if (list->cachesObjectHashes && !otherList->cachesObjectHashes) {
+        for (PGCListNode *node = otherList->head; node; node = node->next) {
+            for (uint64_t i = 0; i < node->count; i++) node->entries[i].objectHash = PGCHash(node->entries[i].object);
+        }
+    }
+    
+    // Link the other list’s nodes in as they are, leaving the other list empty
+    otherList->head->previous = previousNode;
+    otherList->tail->next = nextNode;
+    if (previousNode) {
+        previousNode->next = otherList->head;
+    } else {
+        list->head = otherList->head;
+    }
+    
+    if (nextNode) {
+        nextNode->previous = otherList->tail;
+    } else {
+        list->tail = otherList->tail;
+    }
+    
+    list->current = otherList->head;
+    list->currentIndex = index;
+    list->count += otherList->count;
+    list->mutationCount++;
+    list->hashIsValid = false;
+    if (list->isIndexed) PGCListIndexRebuild(list);
+    
+    otherList->head = NULL;
+    otherList->tail = NULL;
+    otherList->current = NULL;
+    otherList->currentIndex = PGCNotFound;
+    otherList->count = 0;
+    otherList->indexLevelCount = 0;
+    otherList->mutationCount++;
+    otherList->hashIsValid = false;
+}
+
+
+PGCList *PGCListSplitAtIndex(PGCList *list, uint64_t index)
+{
+    if (!list || index > list->count) return NULL;
+    
+    PGCList *tailList = PGCListInitWithNodeCapacity(NULL, list->nodeCapacity);
+    if (!tailList) return NULL;
+    tailList->cachesObjectHashes = list->cachesObjectHashes;
+    PGCListSetIndexed(tailList, list->isIndexed);
+    
+    PGCListNode *node = NULL;
+    if (!PGCListSplitNodeAtIndex(list, index, &node)) {
+        PGCRelease(tailList);
+        return NULL;
+    }
+    
+    // Everything from node on moves to the new list
+    if (node) {
+        tailList->head = node;
+        tailList->tail = list->tail;
+        tailList->count = list->count - index;
+        
+        list->tail = node->previous;
+        if (list->tail) {
+            list->tail->next = NULL;
+        } else {
+            list->head = NULL;
+        }
+        
+        node->previous = NULL;
+        list->count = index;
+        list->current = list->tail;
+        list->currentIndex = list->tail ? index - list->tail->count : PGCNotFound;
+        list->mutationCount++;
+        list->hashIsValid = false;
+        
+        if (list->isIndexed) {
+            PGCListIndexRebuild(list);
+            PGCListIndexRebuild(tailList);
+        }
+    }
+    
+    return PGCAutorelease(tailList);
+}
+
+
+bool PGCListSplitNodeAtIndex(PGCList *list, uint64_t index, PGCListNode **nextNode)
+{
+    // Makes index fall on a node boundary and returns the node that starts there, which is NULL at the end of the list
+    *nextNode = NULL;
+    if (index == list->count) return true;
+    
+    uint64_t offset = 0;
+    PGCListNode *node = PGCListGetNodeAtIndex(list, index, &offset);
+    if (offset > 0) {
+        // Spliced nodes may have come from a list with a different node capacity
+        PGCListNode *newNode = PGCListNodeCreate(list, node->capacity);
+        if (!newNode) return false;
+        
+        newNode->count = node->count - (uint32_t)offset;
+        memcpy(newNode->entries, &node->entries[offset], newNode->count * sizeof(PGCListEntry));
+        node->count = (uint32_t)offset;
+        PGCListLinkNodeAfterNode(list, newNode, node);
+        node = newNode;
+    }
+    
+    *nextNode = node;
+    return true;
+}
+
+
 #pragma mark Object Addition, Replacement, and Removal
 
 void PGCListAddObject(PGCList *list, PGCType instance)
@@ -331,35 +651,106 @@ void PGCListInsertObjectAtIndex(PGCList *list, PGCType instance, uint64_t index)
 {
     if (!list || index > list->count) return;
     
-    PGCListNode *newNode = calloc(1, sizeof(PGCListNode));
-    if (!newNode) return;
-    newNode->object = PGCRetain(instance);
+    // Indexed lists need the path of skip links leading to the node so that they can update their widths
+    PGCListSkipLink *path[PGCListMaximumIndexLevelCount];
+    uint64_t pathPositions[PGCListMaximumIndexLevelCount];
+    PGCListNode *newNode = NULL;
+    uint64_t newNodeIndex = 0;
     
-    if (index == 0) {
-        if (list->head) {
-            newNode->next = list->head;
-            list->head->previous = newNode;
-        }
+    PGCListNode *node = NULL;
+    uint64_t nodeIndex = 0;
+    uint64_t offset = 0;
+    if (list->count == 0) {
+        node = newNode = PGCListNodeCreate(list, list->nodeCapacity);
+        if (!node) return;
+        PGCListLinkNodeAfterNode(list, node, NULL);
         
-        list->head = newNode;
-    } else {
-        PGCListNode *previousNode = PGCListGetNodeAtIndex(list, index - 1);
-        if (previousNode->next) {
-            newNode->next = previousNode->next;
-            newNode->next->previous = newNode;
+        for (uint64_t level = 0; level < list->indexLevelCount; level++) {
+            path[level] = &list->indexLinks[level];
+            pathPositions[level] = 0;
         }
-        
-        previousNode->next = newNode;
-        newNode->previous = previousNode;
+    } else if (list->isIndexed) {
+        node = PGCListIndexFindNode(list, index < list->count ? index : list->count - 1, path, pathPositions, &nodeIndex);
+        offset = index - nodeIndex;
+    } else if (index == list->count) {
+        node = list->tail;
+        nodeIndex = list->count - node->count;
+        offset = node->count;
+    } else {
+        node = PGCListGetNodeAtIndex(list, index, &offset);
+        nodeIndex = list->currentIndex;
     }
     
-    if (index == list->count) {
-        list->tail = newNode;
+    // If the node is full, use a neighbor with room or a new node when inserting at either end of it. Otherwise, split it in half.
+    // New nodes in indexed lists always go after the full node, where the index path found for it still covers them.
+    if (node->count == node->capacity) {
+        if (offset == node->count) {
+            PGCListNode *nextNode = node->next;
+            if (!nextNode || nextNode->count == nextNode->capacity || list->isIndexed) {
+                nextNode = newNode = PGCListNodeCreate(list, list->nodeCapacity);
+                if (!nextNode) return;
+                PGCListLinkNodeAfterNode(list, nextNode, node);
+                newNodeIndex = nodeIndex + node->count;
+            }
+            
+            nodeIndex += node->count;
+            node = nextNode;
+            offset = 0;
+        } else if (offset == 0 && !list->isIndexed) {
+            PGCListNode *previousNode = node->previous;
+            if (previousNode && previousNode->count < previousNode->capacity) {
+                nodeIndex -= previousNode->count;
+                offset = previousNode->count;
+            } else {
+                previousNode = PGCListNodeCreate(list, list->nodeCapacity);
+                if (!previousNode) return;
+                PGCListLinkNodeAfterNode(list, previousNode, node->previous);
+            }
+            
+            node = previousNode;
+        } else {
+            PGCListNode *nextNode = newNode = PGCListNodeCreate(list, node->capacity);
+            if (!nextNode) return;
+            PGCListLinkNodeAfterNode(list, nextNode, node);
+            
+            uint32_t half = node->count / 2;
+            nextNode->count = node->count - half;
+            memcpy(nextNode->entries, &node->entries[half], nextNode->count * sizeof(PGCListEntry));
+            node->count = half;
+            newNodeIndex = nodeIndex + half;
+            
+            if (offset > half) {
+                nodeIndex += half;
+                node = nextNode;
+                offset -= half;
+            } else {
+                newNodeIndex++;
+            }
+        }
     }
     
-    list->current = newNode;
-    list->currentIndex = index;
+    PGCListEntry *entry = &node->entries[offset];
+    memmove(entry + 1, entry, (node->count - offset) * sizeof(PGCListEntry));
+    entry->object = PGCRetain(instance);
+    if (list->cachesObjectHashes) entry->objectHash = PGCHash(instance);
+    
+    node->count++;
     list->count++;
+    list->mutationCount++;
+    list->current = node;
+    list->currentIndex = nodeIndex;
+    
+    if (list->isIndexed) {
+        for (uint64_t level = 0; level < list->indexLevelCount; level++) path[level]->width++;
+        if (newNode) PGCListIndexInsertNode(list, newNode, newNodeIndex, path, pathPositions);
+    }
+
+    // Appending can update our cached hash incrementally; inserting anywhere else invalidates it
+    if (list->hashIsValid && index == list->count - 1) {
+        list->hash = PGCHashCombine(list->hash, list->cachesObjectHashes ? entry->objectHash : PGCHash(instance));
+    } else {
+        list->hashIsValid = false;
+    }
 }
 
 
@@ -374,21 +765,24 @@ void PGCListExchangeValuesAtIndices(PGCList *list, uint64_t index1, uint64_t ind
     // Note that we cannot optimize for when index1 == index2 because we need to move the list’s current pointer
     if (!list || index1 >= list->count || index2 >= list->count) return;
 
-    PGCListNode *node1 = PGCListGetNodeAtIndex(list, index1);
-    PGCListNode *node2 = PGCListGetNodeAtIndex(list, index2);
+    PGCListEntry *entry1 = PGCListGetEntryAtIndex(list, index1);
+    PGCListEntry *entry2 = PGCListGetEntryAtIndex(list, index2);
     
-    PGCType node1Object = node1->object;
-    node1->object = node2->object;
-    node2->object = node1Object;
+    PGCListEntry entry = *entry1;
+    *entry1 = *entry2;
+    *entry2 = entry;
+    list->hashIsValid = false;
 }
 
 
 void PGCListReplaceObjectAtIndex(PGCList *list, PGCType instance, uint64_t index)
 {
     if (!list || index >= list->count) return;
-    PGCListNode *node = PGCListGetNodeAtIndex(list, index);
-    PGCRelease(node->object);
-    node->object = PGCRetain(instance);
+    PGCListEntry *entry = PGCListGetEntryAtIndex(list, index);
+    PGCRelease(entry->object);
+    entry->object = PGCRetain(instance);
+    if (list->cachesObjectHashes) entry->objectHash = PGCHash(instance);
+    list->hashIsValid = false;
 }
 
 
@@ -403,8 +797,19 @@ PGCType PGCListPopObject(PGCList *list)
 
 void PGCListRemoveObject(PGCList *list, PGCType instance)
 {
-    uint64_t indexOfObject; 
-    while ((indexOfObject = PGCListGetIndexOfObject(list, instance)) != PGCNotFound) PGCListRemoveObjectAtIndex(list, indexOfObject);
+    if (!list || !instance) return;
+    
+    // Retain the instance in case it is only owned by the list and is removed before we’re done comparing against it
+    PGCRetain(instance);
+    uint64_t instanceHash = PGCHash(instance);
+    
+    PGCListCursor cursor = PGCListGetCursorAtIndex(list, 0);
+    PGCType object;
+    while ((object = PGCListCursorNext(&cursor))) {
+        if (PGCHash(object) == instanceHash && PGCEquals(instance, object)) PGCListCursorRemoveObject(&cursor);
+    }
+    
+    PGCRelease(instance);
 }
 
 
@@ -412,39 +817,72 @@ void PGCListRemoveObjectAtIndex(PGCList *list, uint64_t index)
 {
     if (!list || index >= list->count) return;
     
-    PGCListNode *oldNode = NULL;
-    
-    if (index == 0) {
-        oldNode = list->head;
-        if (oldNode->next) oldNode->next->previous = NULL;
-
-        list->head = list->head->next;
-        list->current = list->head;
-        list->currentIndex = 0;
+    PGCListSkipLink *path[PGCListMaximumIndexLevelCount];
+    uint64_t pathPositions[PGCListMaximumIndexLevelCount];
+    uint64_t nodeIndex = 0;
+    uint64_t offset = 0;
+    PGCListNode *node = NULL;
+    if (list->isIndexed) {
+        node = PGCListIndexFindNode(list, index, path, pathPositions, &nodeIndex);
+        offset = index - nodeIndex;
     } else {
-        PGCListNode *previousNode = PGCListGetNodeAtIndex(list, index - 1);
-        oldNode = previousNode->next;
-        if (oldNode->next) oldNode->next->previous = previousNode;
-        previousNode->next = oldNode->next;
-        
-        // No need to update current node information in list, as that is handled in PGCListGetNodeAtIndex
+        node = PGCListGetNodeAtIndex(list, index, &offset);
+        nodeIndex = list->currentIndex;
     }
     
-    if (index == list->count - 1) list->tail = oldNode->previous;    
-    if (--list->count == 0) list->currentIndex = PGCNotFound;
+    PGCType object = node->entries[offset].object;
+    memmove(&node->entries[offset], &node->entries[offset + 1], (node->count - offset - 1) * sizeof(PGCListEntry));
+    node->count--;
+    list->count--;
+    list->mutationCount++;
+    list->hashIsValid = false;
+    
+    if (list->isIndexed) {
+        for (uint64_t level = 0; level < list->indexLevelCount; level++) path[level]->width--;
+    }
+    
+    if (node->count == 0) {
+        if (list->isIndexed) PGCListIndexRemoveNode(list, node, nodeIndex);
+        
+        // Keep pointing at a valid node, preferring the one that now holds index
+        if (node->next) {
+            list->current = node->next;
+            list->currentIndex = nodeIndex;
+        } else if (node->previous) {
+            list->current = node->previous;
+            list->currentIndex = nodeIndex - node->previous->count;
+        } else {
+            list->current = NULL;
+            list->currentIndex = PGCNotFound;
+        }
+        
+        PGCListUnlinkNode(list, node);
+        PGCListNodeDestroy(node);
+    } else if (node->next && node->count + node->next->count <= node->capacity / 2) {
+        // Merge sparse neighbors in unrolled lists so that nodes stay reasonably full
+        PGCListNode *nextNode = node->next;
+        if (list->isIndexed) PGCListIndexRemoveNode(list, nextNode, nodeIndex + node->count);
+        memcpy(&node->entries[node->count], nextNode->entries, nextNode->count * sizeof(PGCListEntry));
+        node->count += nextNode->count;
+        PGCListUnlinkNode(list, nextNode);
+        PGCListNodeDestroy(nextNode);
+    }
     
-    PGCRelease(oldNode->object);
-    free(oldNode);
+    PGCRelease(object);
 }
 
 
 void PGCListRemoveAllObjects(PGCList *list)
 {
+    if (!list) return;
+    
+    // Deferring deallocation lets the objects be deallocated within a single time slice
+    PGCObjectBeginDeferringDeallocation();
     PGCListNode *node = list->head;
     while (node) {
         PGCListNode *next = node->next;
-        PGCRelease(node->object);
-        free(node);
+        for (uint64_t i = 0; i < node->count; i++) PGCRelease(node->entries[i].object);
+        PGCListNodeDestroy(node);
         node = next;
     }
     
@@ -453,6 +891,47 @@ void PGCListRemoveAllObjects(PGCList *list)
     list->current = NULL;
     list->count = 0;
     list->currentIndex = PGCNotFound;
+    list->indexLevelCount = 0;
+    list->mutationCount++;
+    list->hashIsValid = false;
+    PGCObjectEndDeferringDeallocation();
+}
+
+
+void PGCListLinkNodeAfterNode(PGCList *list, PGCListNode *node, PGCListNode *previousNode)
+{
+    // A NULL previous node links node in as the new head
+    PGCListNode *nextNode = previousNode ? previousNode->next : list->head;
+    node->previous = previousNode;
+    node->next = nextNode;
+    
+    if (previousNode) {
+        previousNode->next = node;
+    } else {
+        list->head = node;
+    }
+    
+    if (nextNode) {
+        nextNode->previous = node;
+    } else {
+        list->tail = node;
+    }
+}
+
+
+void PGCListUnlinkNode(PGCList *list, PGCListNode *node)
+{
+    if (node->previous) {
+        node->previous->next = node->next;
+    } else {
+        list->head = node->next;
+    }
+    
+    if (node->next) {
+        node->next->previous = node->previous;
+    } else {
+        list->tail = node->previous;
+    }
 }
 
 
@@ -463,12 +942,508 @@ PGCString *PGCListJoinComponentsWithString(PGCList *list, PGCString *separator)
     if (!list) return NULL;
     PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
 
+    // Draining periodically keeps the pool from holding every description at once without paying for a drain per component
     PGCString *join = PGCStringInit(NULL);
-    for (uint64_t i = 0; i < list->count; i++) {
-        PGCStringAppendString(join, PGCDescription(PGCListGetNodeAtIndex(list, i)->object));
-        if (i != list->count - 1) PGCStringAppendString(join, separator);
+    PGCListCursor cursor = PGCListGetCursorAtIndex(list, 0);
+    PGCType object;
+    uint64_t componentCount = 0;
+    while ((object = PGCListCursorNext(&cursor))) {
+        PGCStringAppendString(join, PGCDescription(object));
+        if (PGCListCursorHasNext(&cursor)) PGCStringAppendString(join, separator);
+        if (++componentCount % PGCListJoinDrainInterval == 0) PGCAutoreleasePoolDrain(pool);
     }
     
     PGCAutoreleasePoolDestroy(pool);
     return PGCAutorelease(join);
 }
+
+
+#pragma mark Memory Management
+
+uint64_t PGCListGetNodeCapacity(PGCList *list)
+{
+    return list ? list->nodeCapacity : 0;
+}
+
+
+bool PGCListIsIndexed(PGCList *list)
+{
+    return list ? list->isIndexed : false;
+}
+
+
+void PGCListSetIndexed(PGCList *list, bool indexed)
+{
+    if (!list || list->isIndexed == indexed) return;
+    
+    // Nodes keep their skip links when indexing is turned off, so turning it back on can reuse them
+    if (!indexed) {
+        free(list->indexLinks);
+        list->indexLinks = NULL;
+        list->indexLevelCount = 0;
+        list->isIndexed = false;
+        list->mutationCount++;
+        return;
+    }
+    
+    list->indexLinks = calloc(PGCListMaximumIndexLevelCount, sizeof(PGCListSkipLink));
+    if (!list->indexLinks) return;
+    list->isIndexed = true;
+    list->mutationCount++;
+    PGCListIndexRebuild(list);
+}
+
+
+bool PGCListGetCachesObjectHashes(PGCList *list)
+{
+    return list ? list->cachesObjectHashes : false;
+}
+
+
+void PGCListSetCachesObjectHashes(PGCList *list, bool cachesObjectHashes)
+{
+    if (!list || list->cachesObjectHashes == cachesObjectHashes) return;
+    list->cachesObjectHashes = cachesObjectHashes;
+    if (cachesObjectHashes) {
+        for (PGCListNode *node = list->head; node; node = node->next) {
+            for (uint64_t i = 0; i < node->count; i++) node->entries[i].objectHash = PGCHash(node->entries[i].object);
+        }
+    }
+}
+
+
+#pragma mark Enumeration
+
+void PGCListEnumerateObjectsWithBlock(PGCList *list, PGCEnumerationOptions options, PGCIndexedEnumerationBlock block)
+{
+    if (!list || !block || list->count == 0) return;
+    
+    bool reverse = (options & PGCEnumerationReverse) != 0;
+    if (options & PGCEnumerationConcurrent) {
+        // Concurrent enumeration needs random access, so gather the objects up front
+        uint64_t count = list->count;
+        PGCType *objects = malloc(count * sizeof(PGCType));
+        if (!objects) return;
+        
+        PGCListCursor cursor = PGCListGetCursorAtIndex(list, 0);
+        for (uint64_t i = 0; i < count; i++) objects[i] = PGCListCursorNext(&cursor);
+        
+        __block bool stop = false;
+        dispatch_apply(count, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+            if (stop) return;
+            uint64_t index = reverse ? count - i - 1 : i;
+            block(objects[index], index, &stop);
+        });
+        
+        free(objects);
+        return;
+    }
+    
+    PGCListCursor cursor = PGCListGetCursorAtIndex(list, reverse ? list->count : 0);
+    bool stop = false;
+    PGCType object;
+    while (!stop && (object = reverse ? PGCListCursorPrevious(&cursor) : PGCListCursorNext(&cursor))) {
+        block(object, reverse ? cursor.index : cursor.index - 1, &stop);
+    }
+}
+
+
+#pragma mark - PGCListCursor
+
+PGCListCursor PGCListGetCursorAtIndex(PGCList *list, uint64_t index)
+{
+    PGCListCursor cursor = { NULL, NULL, 0, 0, 0, 0 };
+    if (!list || index > list->count) return cursor;
+    
+    cursor.list = list;
+    PGCListCursorSeekToIndex(&cursor, index);
+    return cursor;
+}
+
+
+bool PGCListCursorIsValid(PGCListCursor *cursor)
+{
+    return cursor && cursor->list && cursor->mutationCount == cursor->list->mutationCount;
+}
+
+
+void PGCListCursorSeekToIndex(PGCListCursor *cursor, uint64_t index)
+{
+    // A cursor positioned after the last object has no node
+    cursor->node = PGCListGetNodeAtIndex(cursor->list, index, &cursor->offset);
+    if (!cursor->node) cursor->offset = 0;
+    cursor->index = index;
+    cursor->mutationCount = cursor->list->mutationCount;
+    cursor->lastMove = 0;
+}
+
+
+uint64_t PGCListCursorGetIndex(PGCListCursor *cursor)
+{
+    return PGCListCursorIsValid(cursor) ? cursor->index : PGCNotFound;
+}
+
+
+bool PGCListCursorHasNext(PGCListCursor *cursor)
+{
+    return PGCListCursorIsValid(cursor) && cursor->node;
+}
+
+
+bool PGCListCursorHasPrevious(PGCListCursor *cursor)
+{
+    return PGCListCursorIsValid(cursor) && cursor->index > 0;
+}
+
+
+PGCType PGCListCursorNext(PGCListCursor *cursor)
+{
+    if (!PGCListCursorIsValid(cursor) || !cursor->node) return NULL;
+    
+    PGCListNode *node = cursor->node;
+    PGCType object = node->entries[cursor->offset].object;
+    cursor->index++;
+    if (++cursor->offset == node->count) {
+        cursor->node = node->next;
+        cursor->offset = 0;
+    }
+    
+    cursor->lastMove = 1;
+    return object;
+}
+
+
+PGCType PGCListCursorPrevious(PGCListCursor *cursor)
+{
+    if (!PGCListCursorIsValid(cursor) || cursor->index == 0) return NULL;
+    
+    if (cursor->node && cursor->offset > 0) {
+        cursor->offset--;
+    } else {
+        cursor->node = cursor->node ? cursor->node->previous : cursor->list->tail;
+        cursor->offset = cursor->node->count - 1;
+    }
+    
+    cursor->index--;
+    cursor->lastMove = -1;
+    return cursor->node->entries[cursor->offset].object;
+}
+
+
+void PGCListCursorInsertObject(PGCListCursor *cursor, PGCType instance)
+{
+    if (!PGCListCursorIsValid(cursor)) return;
+    PGCList *list = cursor->list;
+    
+    // Point the list’s cached node at the cursor’s so that finding the insertion point doesn’t require a walk
+    if (cursor->node) {
+        list->current = cursor->node;
+        list->currentIndex = cursor->index - cursor->offset;
+    }
+    
+    uint64_t count = list->count;
+    PGCListInsertObjectAtIndex(list, instance, cursor->index);
+    PGCListCursorSeekToIndex(cursor, list->count > count ? cursor->index + 1 : cursor->index);
+}
+
+
+bool PGCListCursorRemoveObject(PGCListCursor *cursor)
+{
+    if (!PGCListCursorIsValid(cursor) || cursor->lastMove == 0) return false;
+    PGCList *list = cursor->list;
+    
+    // Remove the object most recently returned by Next or Previous
+    uint64_t index = cursor->lastMove > 0 ? cursor->index - 1 : cursor->index;
+    if (cursor->node) {
+        list->current = cursor->node;
+        list->currentIndex = cursor->index - cursor->offset;
+    }
+    
+    PGCListRemoveObjectAtIndex(list, index);
+    PGCListCursorSeekToIndex(cursor, index);
+    return true;
+}
+
+
+#pragma mark - Index
+
+PGCListNode *PGCListIndexFindNode(PGCList *list, uint64_t index, PGCListSkipLink **path, uint64_t *pathPositions, uint64_t *nodeIndex)
+{
+    // At each level, advance to the last node that starts at or before index, recording where we left the level if asked
+    PGCListNode *node = NULL;
+    PGCListSkipLink *links = list->indexLinks;
+    uint64_t position = 0;
+    for (uint64_t level = list->indexLevelCount; level-- > 0; ) {
+        while (links[level].next && position + links[level].width <= index) {
+            position += links[level].width;
+            node = links[level].next;
+            links = PGCListNodeGetSkipLinks(node);
+        }
+        
+        if (path) {
+            path[level] = &links[level];
+            pathPositions[level] = position;
+        }
+    }
+    
+    // Finish on the base list, which is usually only a few nodes away
+    if (!node) node = list->head;
+    while (node && index >= position + node->count) {
+        position += node->count;
+        node = node->next;
+    }
+    
+    if (node) {
+        list->current = node;
+        list->currentIndex = position;
+    }
+    
+    *nodeIndex = position;
+    return node;
+}
+
+
+void PGCListIndexInsertNode(PGCList *list, PGCListNode *node, uint64_t nodeIndex, PGCListSkipLink **path, uint64_t *pathPositions)
+{
+    // path must lead to the node that node was linked in after, and its widths must already count node’s objects
+    for (uint64_t level = list->indexLevelCount; level < node->height; level++) {
+        list->indexLinks[level].next = NULL;
+        list->indexLinks[level].width = list->count;
+        path[level] = &list->indexLinks[level];
+        pathPositions[level] = 0;
+    }
+    
+    if (node->height > list->indexLevelCount) list->indexLevelCount = node->height;
+    
+    PGCListSkipLink *links = PGCListNodeGetSkipLinks(node);
+    for (uint64_t level = 0; level < node->height; level++) {
+        PGCListSkipLink *link = path[level];
+        links[level].next = link->next;
+        links[level].width = pathPositions[level] + link->width - nodeIndex;
+        link->next = node;
+        link->width = nodeIndex - pathPositions[level];
+    }
+}
+
+
+void PGCListIndexRemoveNode(PGCList *list, PGCListNode *node, uint64_t nodeIndex)
+{
+    if (node->height == 0) return;
+    
+    // Find the last links before node at each level. Every node before node has objects, so those all start before nodeIndex.
+    PGCListSkipLink *path[PGCListMaximumIndexLevelCount];
+    uint64_t pathPositions[PGCListMaximumIndexLevelCount];
+    if (nodeIndex > 0) {
+        uint64_t previousNodeIndex = 0;
+        PGCListIndexFindNode(list, nodeIndex - 1, path, pathPositions, &previousNodeIndex);
+    } else {
+        for (uint64_t level = 0; level < list->indexLevelCount; level++) path[level] = &list->indexLinks[level];
+    }
+    
+    PGCListSkipLink *links = PGCListNodeGetSkipLinks(node);
+    for (uint64_t level = 0; level < node->height; level++) {
+        path[level]->next = links[level].next;
+        path[level]->width += links[level].width;
+    }
+    
+    while (list->indexLevelCount > 0 && !list->indexLinks[list->indexLevelCount - 1].next) list->indexLevelCount--;
+}
+
+
+void PGCListIndexRebuild(PGCList *list)
+{
+    PGCListSkipLink *lastLinks[PGCListMaximumIndexLevelCount];
+    uint64_t lastPositions[PGCListMaximumIndexLevelCount];
+    for (uint64_t level = 0; level < PGCListMaximumIndexLevelCount; level++) {
+        lastLinks[level] = &list->indexLinks[level];
+        lastPositions[level] = 0;
+    }
+    
+    uint64_t levelCount = 0;
+    uint64_t position = 0;
+    for (PGCListNode *node = list->head; node; node = node->next) {
+        // Nodes that came from unindexed lists have no room for skip links, so replace them with ones that do
+        if (!node->isIndexed) {
+            PGCListNode *indexedNode = PGCListNodeCreate(list, node->capacity);
+            if (indexedNode) {
+                indexedNode->count = node->count;
+                memcpy(indexedNode->entries, node->entries, node->count * sizeof(PGCListEntry));
+                PGCListLinkNodeAfterNode(list, indexedNode, node);
+                PGCListUnlinkNode(list, node);
+                PGCListNodeDestroy(node);
+                node = indexedNode;
+                
+                // Cursors may point into the node that was just destroyed
+                list->mutationCount++;
+            }
+        }
+        
+        PGCListSkipLink *links = PGCListNodeGetSkipLinks(node);
+        for (uint64_t level = 0; level < node->height; level++) {
+            lastLinks[level]->next = node;
+            lastLinks[level]->width = position - lastPositions[level];
+            lastLinks[level] = &links[level];
+            lastPositions[level] = position;
+        }
+        
+        if (node->height > levelCount) levelCount = node->height;
+        position += node->count;
+    }
+    
+    for (uint64_t level = 0; level < levelCount; level++) {
+        lastLinks[level]->next = NULL;
+        lastLinks[level]->width = position - lastPositions[level];
+    }
+    
+    list->indexLevelCount = levelCount;
+    list->current = NULL;
+    list->currentIndex = PGCNotFound;
+}
+
+
+uint64_t PGCListIndexRandomHeight(PGCList *list)
+{
+    // Each level has about a quarter of the nodes of the level below it
+    uint64_t bits = list->randomState;
+    bits ^= bits << 13;
+    bits ^= bits >> 7;
+    bits ^= bits << 17;
+    list->randomState = bits;
+    
+    uint64_t height = 0;
+    while ((bits & 3) == 0 && height < PGCListMaximumIndexLevelCount) {
+        height++;
+        bits >>= 2;
+    }
+    
+    return height;
+}
+
+
+#pragma mark - Node Pool
+
+PGCListNode *PGCListNodeCreate(PGCList *list, uint64_t capacity)
+{
+    uint64_t height = list->isIndexed ? PGCListIndexRandomHeight(list) : 0;
+    
+    PGCListNode *node = NULL;
+    if (capacity > 1 || height > 0) {
+        node = malloc(sizeof(PGCListNode) + capacity * sizeof(PGCListEntry) + height * sizeof(PGCListSkipLink));
+        if (!node) return NULL;
+    } else {
+        if (!PGCListThreadFreeNodes && !PGCListNodePoolRefill()) return NULL;
+        node = PGCListThreadFreeNodes;
+        PGCListThreadFreeNodes = node->next;
+        PGCListThreadFreeNodeCount--;
+    }
+    
+    node->previous = NULL;
+    node->next = NULL;
+    node->count = 0;
+    node->capacity = (uint16_t)capacity;
+    node->height = (uint8_t)height;
+    node->isIndexed = list->isIndexed;
+    return node;
+}
+
+
+void PGCListNodeDestroy(PGCListNode *node)
+{
+    if (node->capacity > 1 || node->height > 0) {
+        free(node);
+        return;
+    }
+    
+    PGCListNodePoolRegisterThread();
+    node->next = PGCListThreadFreeNodes;
+    PGCListThreadFreeNodes = node;
+    if (++PGCListThreadFreeNodeCount < PGCListMaximumThreadFreeNodeCount) return;
+    
+    // Keep the most recently freed nodes, which are most likely to be in cache, and share the rest
+    PGCListNode *lastKeptNode = PGCListThreadFreeNodes;
+    for (uint64_t i = 1; i < PGCListNodeChunkCount; i++) lastKeptNode = lastKeptNode->next;
+    PGCListNode *sharedNodes = lastKeptNode->next;
+    lastKeptNode->next = NULL;
+    
+    PGCListNodePoolShareNodes(sharedNodes, PGCListThreadFreeNodeCount - PGCListNodeChunkCount);
+    PGCListThreadFreeNodeCount = PGCListNodeChunkCount;
+}
+
+
+PGCListSkipLink *PGCListNodeGetSkipLinks(PGCListNode *node)
+{
+    return (PGCListSkipLink *)&node->entries[node->capacity];
+}
+
+
+bool PGCListNodePoolRefill(void)
+{
+    PGCListNodePoolRegisterThread();
+    
+    // Take a batch of shared free nodes if there are any, and allocate a new chunk otherwise. Chunks are never freed, but as
+    // excess free nodes are shared between threads, the number of chunks is bounded by the peak number of nodes in use plus
+    // each thread’s capped free list.
+    pthread_mutex_lock(&PGCListSharedFreeNodesMutex);
+    PGCListNode *batch = PGCListSharedFreeNodeBatches;
+    if (batch) PGCListSharedFreeNodeBatches = batch->previous;
+    pthread_mutex_unlock(&PGCListSharedFreeNodesMutex);
+    
+    if (batch) {
+        PGCListThreadFreeNodes = batch;
+        PGCListThreadFreeNodeCount = batch->count;
+        return true;
+    }
+    
+    size_t nodeSize = sizeof(PGCListNode) + sizeof(PGCListEntry);
+    char *chunk = malloc(PGCListNodeChunkCount * nodeSize);
+    if (!chunk) return false;
+    
+    for (uint64_t i = 0; i < PGCListNodeChunkCount; i++) {
+        PGCListNode *node = (PGCListNode *)(chunk + i * nodeSize);
+        node->next = i + 1 < PGCListNodeChunkCount ? (PGCListNode *)(chunk + (i + 1) * nodeSize) : NULL;
+    }
+    
+    PGCListThreadFreeNodes = (PGCListNode *)chunk;
+    PGCListThreadFreeNodeCount = PGCListNodeChunkCount;
+    return true;
+}
+
+
+void PGCListNodePoolRegisterThread(void)
+{
+    // Register for a callback when this thread exits so that its free nodes can be reclaimed. Threads that only free nodes
+    // need this as much as threads that allocate them.
+    if (PGCListThreadIsRegistered) return;
+    pthread_once(&PGCListNodePoolOnce, PGCListNodePoolCreateKey);
+    pthread_setspecific(PGCListNodePoolKey, &PGCListThreadIsRegistered);
+    PGCListThreadIsRegistered = true;
+}
+
+
+void PGCListNodePoolShareNodes(PGCListNode *nodes, uint64_t count)
+{
+    nodes->count = (uint32_t)count;
+    pthread_mutex_lock(&PGCListSharedFreeNodesMutex);
+    nodes->previous = PGCListSharedFreeNodeBatches;
+    PGCListSharedFreeNodeBatches = nodes;
+    pthread_mutex_unlock(&PGCListSharedFreeNodesMutex);
+}
+
+
+void PGCListNodePoolCreateKey(void)
+{
+    pthread_key_create(&PGCListNodePoolKey, PGCListNodePoolThreadDidExit);
+}
+
+
+void PGCListNodePoolThreadDidExit(void *value)
+{
+    PGCListNode *freeNodes = PGCListThreadFreeNodes;
+    uint64_t freeNodeCount = PGCListThreadFreeNodeCount;
+    PGCListThreadFreeNodes = NULL;
+    PGCListThreadFreeNodeCount = 0;
+    
+    // Destructors for other thread-specific data may still free nodes after this runs, in which case the thread registers again
+    PGCListThreadIsRegistered = false;
+    if (freeNodes) PGCListNodePoolShareNodes(freeNodes, freeNodeCount);
+}
@@ -34,6 +34,16 @@
 
 typedef struct _PGCList PGCList;
 
+typedef struct _PGCListCursor PGCListCursor;
+struct _PGCListCursor {
+    PGCList *list;
+    struct _PGCListNode *node;
+    uint64_t offset;
+    uint64_t index;
+    uint64_t mutationCount;
+    int64_t lastMove;
+};
+
 extern PGCClass *PGCListClass(void);
 extern PGCList *PGCListInstance(void);
 extern PGCList *PGCListWithObjects(PGCType object1, ...);
@@ -41,12 +51,15 @@ extern PGCList *PGCListWithObjects(PGCType object1, ...);
 #pragma mark Basic Functions
 
 extern PGCList *PGCListInit(PGCList *list);
+extern PGCList *PGCListInitWithNodeCapacity(PGCList *list, uint64_t nodeCapacity);
 extern PGCList *PGCListInitWithObjects(PGCList *list, PGCType object1, ...);
 
 extern PGCType PGCListCopy(PGCType instance);
 extern PGCString *PGCListDescription(PGCType instance);
 extern bool PGCListEquals(PGCType instance1, PGCType instance2);
 extern uint64_t PGCListHash(PGCType instance);
+extern bool PGCListEncode(PGCType instance, PGCArchiver *archiver);
+extern PGCType PGCListDecode(PGCClass *class, PGCUnarchiver *unarchiver);
 
 #pragma mark Accessors
 
@@ -66,6 +79,12 @@ extern uint64_t PGCListGetIndexOfIdenticalObjectInRange(PGCList *list, PGCType i
 
 extern PGCList *PGCListSublistWithRange(PGCList *list, PGCRange range);
 
+#pragma mark Splicing and Splitting
+
+extern void PGCListAppendList(PGCList *list, PGCList *otherList);
+extern void PGCListSpliceListAtIndex(PGCList *list, PGCList *otherList, uint64_t index);
+extern PGCList *PGCListSplitAtIndex(PGCList *list, uint64_t index);
+
 #pragma mark Object Addition, Replacement, and Removal
 
 extern void PGCListAddObject(PGCList *list, PGCType instance);
@@ -85,4 +104,33 @@ extern void PGCListRemoveAllObjects(PGCList *list);
 
 extern PGCString *PGCListJoinComponentsWithString(PGCList *list, PGCString *separator);
 
+#pragma mark Memory Management
+
+extern uint64_t PGCListGetNodeCapacity(PGCList *list);
+
+extern bool PGCListIsIndexed(PGCList *list);
+extern void PGCListSetIndexed(PGCList *list, bool indexed);
+
+// Hashes are cached when objects are added, so an object mutated afterwards can no longer be found by searches. Only
+// cache hashes for lists whose objects won’t change while they’re in the list.
+extern bool PGCListGetCachesObjectHashes(PGCList *list);
+extern void PGCListSetCachesObjectHashes(PGCList *list, bool cachesObjectHashes);
+
+#pragma mark Enumeration
+
+extern void PGCListEnumerateObjectsWithBlock(PGCList *list, PGCEnumerationOptions options, PGCIndexedEnumerationBlock block);
+
+#pragma mark - PGCListCursor
+
+extern PGCListCursor PGCListGetCursorAtIndex(PGCList *list, uint64_t index);
+extern uint64_t PGCListCursorGetIndex(PGCListCursor *cursor);
+extern bool PGCListCursorHasNext(PGCListCursor *cursor);
+extern bool PGCListCursorHasPrevious(PGCListCursor *cursor);
+
+extern PGCType PGCListCursorNext(PGCListCursor *cursor);
+extern PGCType PGCListCursorPrevious(PGCListCursor *cursor);
+
+extern void PGCListCursorInsertObject(PGCListCursor *cursor, PGCType instance);
+extern bool PGCListCursorRemoveObject(PGCListCursor *cursor);
+
 #endif
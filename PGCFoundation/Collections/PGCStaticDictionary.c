@@ -0,0 +1,507 @@
+//
+//  PGCStaticDictionary.c
+//  PGCFoundation
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <PGCFoundation/PGCStaticDictionary.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+struct _PGCStaticDictionary {
+    PGCObject super;
+    uint64_t count;
+    uint64_t hash;
+
+    // The first tableCount keys are stored at the slots given by a minimal perfect hash function, with their objects at the
+    // same indexes in objects. Each key’s hash selects a bucket, and the seed stored for that bucket determines the key’s slot.
+    // Keys whose hashes are identical to one in the table can’t be given a slot of their own, so they follow the table, and
+    // their hashes are kept in overflowKeyHashes. The keys, objects, overflow hashes, and seeds share a single allocation.
+    uint64_t tableCount;
+    uint64_t bucketCount;
+    uint32_t *seeds;
+    uint64_t *overflowKeyHashes;
+    PGCType *keys;
+    PGCType *objects;
+};
+
+
+typedef struct _PGCStaticDictionaryBuilder {
+    PGCArray *keys;
+    uint64_t count;
+    uint64_t *keyHashes;
+
+    uint64_t bucketCount;
+    uint64_t *bucketStarts;
+    uint64_t *bucketSizes;
+    uint64_t *bucketKeyIndexes;
+    uint64_t *bucketOrder;
+    uint32_t *seeds;
+
+    uint64_t *slotKeyIndexes;
+    bool *slotIsOccupied;
+    uint64_t *slots;
+
+    uint64_t overflowCount;
+    uint64_t *overflowKeyIndexes;
+} PGCStaticDictionaryBuilder;
+
+
+#pragma mark Private Global Constants
+
+// Larger buckets use less memory for seeds, but take longer to place when the dictionary is built
+static const uint64_t PGCStaticDictionaryAverageBucketSize = 4;
+
+
+#pragma mark Private Function Interfaces
+
+void PGCStaticDictionaryDealloc(PGCType instance);
+PGCStaticDictionary *PGCStaticDictionaryInitWithObjectsAndKeysCopyingKeys(PGCStaticDictionary *staticDictionary, PGCArray *objects, PGCArray *keys,
+                                                                          bool copiesKeys);
+bool PGCStaticDictionaryBuildWithObjectsAndKeys(PGCStaticDictionary *staticDictionary, PGCArray *objects, PGCArray *keys, bool copiesKeys);
+bool PGCStaticDictionaryBuilderInit(PGCStaticDictionaryBuilder *builder, PGCArray *keys);
+void PGCStaticDictionaryBuilderDestroy(PGCStaticDictionaryBuilder *builder);
+bool PGCStaticDictionaryBuilderGroupKeys(PGCStaticDictionaryBuilder *builder);
+bool PGCStaticDictionaryBuilderPlaceBuckets(PGCStaticDictionaryBuilder *builder);
+bool PGCStaticDictionaryBuilderPlaceBucket(PGCStaticDictionaryBuilder *builder, uint64_t bucket);
+uint64_t PGCStaticDictionaryGetKeyHash(PGCType key);
+uint64_t PGCStaticDictionaryGetSlot(uint64_t keyHash, uint32_t seed, uint64_t count);
+uint64_t PGCStaticDictionaryGetIndexOfKey(PGCStaticDictionary *staticDictionary, PGCType key);
+
+
+#pragma mark -
+
+PGCClass *PGCStaticDictionaryClass(void)
+{
+    static PGCClass *staticDictionaryClass = NULL;
+    if (!staticDictionaryClass) {
+        PGCClassFunctions functions = { PGCStaticDictionaryCopy, PGCStaticDictionaryDealloc, PGCStaticDictionaryDescription,
+                                        PGCStaticDictionaryEquals, PGCStaticDictionaryHash, NULL, NULL };
+        staticDictionaryClass = PGCClassCreate("PGCStaticDictionary", PGCObjectClass(), functions, sizeof(PGCStaticDictionary));
+    }
+    return staticDictionaryClass;
+}
+
+
+PGCStaticDictionary *PGCStaticDictionaryInstanceWithDictionary(PGCDictionary *dictionary)
+{
+    return PGCAutorelease(PGCStaticDictionaryInitWithDictionary(NULL, dictionary));
+}
+
+
+PGCStaticDictionary *PGCStaticDictionaryInstanceWithObjectsAndKeys(PGCArray *objects, PGCArray *keys)
+{
+    return PGCAutorelease(PGCStaticDictionaryInitWithObjectsAndKeys(NULL, objects, keys));
+}
+
+
+#pragma mark Basic Functions
+
+PGCStaticDictionary *PGCStaticDictionaryInitWithDictionary(PGCStaticDictionary *staticDictionary, PGCDictionary *dictionary)
+{
+    if (!PGCObjectIsKindOfClass(dictionary, PGCDictionaryClass())) return NULL;
+    
+    // A dictionary returns its keys and objects in the same order, and its keys are already copies that no one else can modify
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+    staticDictionary = PGCStaticDictionaryInitWithObjectsAndKeysCopyingKeys(staticDictionary, PGCDictionaryGetAllObjects(dictionary),
+                                                                            PGCDictionaryGetAllKeys(dictionary), false);
+    PGCAutoreleasePoolDestroy(pool);
+    return staticDictionary;
+}
+
+
+PGCStaticDictionary *PGCStaticDictionaryInitWithObjectsAndKeys(PGCStaticDictionary *staticDictionary, PGCArray *objects, PGCArray *keys)
+{
+    return PGCStaticDictionaryInitWithObjectsAndKeysCopyingKeys(staticDictionary, objects, keys, true);
+}
+
+
+PGCStaticDictionary *PGCStaticDictionaryInitWithObjectsAndKeysCopyingKeys(PGCStaticDictionary *staticDictionary, PGCArray *objects, PGCArray *keys,
+                                                                          bool copiesKeys)
+{
+    if (!objects || !keys || PGCArrayGetCount(objects) != PGCArrayGetCount(keys)) return NULL;
+    if (!staticDictionary && (staticDictionary = PGCAlloc(PGCStaticDictionaryClass())) == NULL) return NULL;
+    PGCObjectInit(&staticDictionary->super);
+    
+    staticDictionary->count = 0;
+    staticDictionary->hash = 0;
+    staticDictionary->tableCount = 0;
+    staticDictionary->bucketCount = 0;
+    staticDictionary->seeds = NULL;
+    staticDictionary->overflowKeyHashes = NULL;
+    staticDictionary->keys = NULL;
+    staticDictionary->objects = NULL;
+    
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+    bool built = PGCStaticDictionaryBuildWithObjectsAndKeys(staticDictionary, objects, keys, copiesKeys);
+    PGCAutoreleasePoolDestroy(pool);
+    
+    if (!built) {
+        PGCRelease(staticDictionary);
+        return NULL;
+    }
+    
+    return staticDictionary;
+}
+
+
+void PGCStaticDictionaryDealloc(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCStaticDictionaryClass())) return;
+    PGCStaticDictionary *staticDictionary = instance;
+    
+    if (staticDictionary->keys) {
+        for (uint64_t i = 0; i < staticDictionary->count; i++) {
+            PGCRelease(staticDictionary->keys[i]);
+            PGCRelease(staticDictionary->objects[i]);
+        }
+        
+        free(staticDictionary->keys);
+    }
+    
+    PGCSuperclassDealloc(staticDictionary);
+}
+
+
+PGCType PGCStaticDictionaryCopy(PGCType instance)
+{
+    // Static dictionaries are immutable, so they are their own copies
+    return PGCObjectIsKindOfClass(instance, PGCStaticDictionaryClass()) ? PGCRetain(instance) : NULL;
+}
+
+
+PGCString *PGCStaticDictionaryDescription(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCStaticDictionaryClass())) return NULL;
+    PGCStaticDictionary *staticDictionary = instance;
+    
+    PGCString *description = PGCStringInstanceWithCString("{");
+    for (uint64_t i = 0; i < staticDictionary->count; i++) {
+        PGCStringAppendFormat(description, i == 0 ? "%s = %s" : ", %s = %s", PGCDescriptionCString(staticDictionary->keys[i]),
+                              PGCDescriptionCString(staticDictionary->objects[i]));
+    }
+    
+    PGCStringAppendFormat(description, "}");
+    return description;
+}
+
+
+bool PGCStaticDictionaryEquals(PGCType instance1, PGCType instance2)
+{
+    if (!PGCObjectIsKindOfClass(instance1, PGCStaticDictionaryClass()) || !PGCObjectIsKindOfClass(instance2, PGCStaticDictionaryClass())) {
+        return false;
+    }
+    
+    PGCStaticDictionary *staticDictionary1 = instance1;
+    PGCStaticDictionary *staticDictionary2 = instance2;
+    if (staticDictionary1 == staticDictionary2) return true;
+    if (staticDictionary1->count != staticDictionary2->count || staticDictionary1->hash != staticDictionary2->hash) return false;
+    
+    for (uint64_t i = 0; i < staticDictionary1->count; i++) {
+        uint64_t index2 = PGCStaticDictionaryGetIndexOfKey(staticDictionary2, staticDictionary1->keys[i]);
+        if (index2 == PGCNotFound || !PGCEquals(staticDictionary1->objects[i], staticDictionary2->objects[index2])) return false;
+    }
+    
+    return true;
+}
+
+
+uint64_t PGCStaticDictionaryHash(PGCType instance)
+{
+    // The hash is the same as that of the dictionary the static dictionary was built from
+    return PGCObjectIsKindOfClass(instance, PGCStaticDictionaryClass()) ? ((PGCStaticDictionary *)instance)->hash : 0;
+}
+
+
+#pragma mark Accessors
+
+uint64_t PGCStaticDictionaryGetCount(PGCStaticDictionary *staticDictionary)
+{
+    return staticDictionary ? staticDictionary->count : 0;
+}
+
+
+PGCType PGCStaticDictionaryGetObjectForKey(PGCStaticDictionary *staticDictionary, PGCType key)
+{
+    uint64_t index = PGCStaticDictionaryGetIndexOfKey(staticDictionary, key);
+    return index != PGCNotFound ? PGCAutorelease(PGCRetain(staticDictionary->objects[index])) : NULL;
+}
+
+
+bool PGCStaticDictionaryContainsKey(PGCStaticDictionary *staticDictionary, PGCType key)
+{
+    return PGCStaticDictionaryGetIndexOfKey(staticDictionary, key) != PGCNotFound;
+}
+
+
+PGCArray *PGCStaticDictionaryGetAllKeys(PGCStaticDictionary *staticDictionary)
+{
+    if (!staticDictionary) return NULL;
+    PGCArray *allKeys = PGCArrayInitWithInitialCapacity(NULL, staticDictionary->count);
+    for (uint64_t i = 0; allKeys && i < staticDictionary->count; i++) PGCArrayAddObject(allKeys, staticDictionary->keys[i]);
+    return PGCAutorelease(allKeys);
+}
+
+
+PGCArray *PGCStaticDictionaryGetAllObjects(PGCStaticDictionary *staticDictionary)
+{
+    if (!staticDictionary) return NULL;
+    PGCArray *allObjects = PGCArrayInitWithInitialCapacity(NULL, staticDictionary->count);
+    for (uint64_t i = 0; allObjects && i < staticDictionary->count; i++) PGCArrayAddObject(allObjects, staticDictionary->objects[i]);
+    return PGCAutorelease(allObjects);
+}
+
+
+uint64_t PGCStaticDictionaryGetIndexOfKey(PGCStaticDictionary *staticDictionary, PGCType key)
+{
+    if (!staticDictionary || !key || staticDictionary->count == 0) return PGCNotFound;
+    
+    // Every key in the table maps to a distinct slot, so a lookup is usually one probe and one equality check
+    uint64_t keyHash = PGCStaticDictionaryGetKeyHash(key);
+    uint32_t seed = staticDictionary->seeds[keyHash % staticDictionary->bucketCount];
+    uint64_t index = PGCStaticDictionaryGetSlot(keyHash, seed, staticDictionary->tableCount);
+    if (PGCEquals(staticDictionary->keys[index], key)) return index;
+    
+    for (uint64_t i = staticDictionary->tableCount; i < staticDictionary->count; i++) {
+        if (staticDictionary->overflowKeyHashes[i - staticDictionary->tableCount] == keyHash && PGCEquals(staticDictionary->keys[i], key)) {
+            return i;
+        }
+    }
+    
+    return PGCNotFound;
+}
+
+
+#pragma mark Perfect Hashing
+
+bool PGCStaticDictionaryBuildWithObjectsAndKeys(PGCStaticDictionary *staticDictionary, PGCArray *objects, PGCArray *keys, bool copiesKeys)
+{
+    if (PGCArrayGetCount(keys) == 0) return true;
+
+    PGCStaticDictionaryBuilder builder;
+    bool placed = PGCStaticDictionaryBuilderInit(&builder, keys) && PGCStaticDictionaryBuilderGroupKeys(&builder) &&
+                  PGCStaticDictionaryBuilderPlaceBuckets(&builder);
+    
+    uint64_t tableCount = builder.count;
+    uint64_t count = tableCount + builder.overflowCount;
+    PGCType *table = placed ? calloc(2 * count * sizeof(PGCType) + builder.overflowCount * sizeof(uint64_t) +
+                                     builder.bucketCount * sizeof(uint32_t), 1) : NULL;
+    if (!table) {
+        PGCStaticDictionaryBuilderDestroy(&builder);
+        return false;
+    }
+    
+    staticDictionary->count = count;
+    staticDictionary->tableCount = tableCount;
+    staticDictionary->bucketCount = builder.bucketCount;
+    staticDictionary->keys = table;
+    staticDictionary->objects = &table[count];
+    staticDictionary->overflowKeyHashes = (uint64_t *)&table[2 * count];
+    staticDictionary->seeds = (uint32_t *)&staticDictionary->overflowKeyHashes[builder.overflowCount];
+    memcpy(staticDictionary->seeds, builder.seeds, builder.bucketCount * sizeof(uint32_t));
+    
+    // Like PGCDictionary’s, our hash is the sum of the mixed hashes of our key-object pairs
+    bool filled = true;
+    for (uint64_t i = 0; filled && i < count; i++) {
+        uint64_t keyIndex = i < tableCount ? builder.slotKeyIndexes[i] : builder.overflowKeyIndexes[i - tableCount];
+        if (i >= tableCount) staticDictionary->overflowKeyHashes[i - tableCount] = builder.keyHashes[keyIndex];
+        
+        PGCType key = PGCArrayGetObjectAtIndex(keys, keyIndex);
+        PGCType object = PGCArrayGetObjectAtIndex(objects, keyIndex);
+        staticDictionary->keys[i] = copiesKeys ? PGCCopy(key) : PGCRetain(key);
+        staticDictionary->objects[i] = PGCRetain(object);
+        staticDictionary->hash += PGCHashMix(PGCHashCombine(PGCHash(key), PGCHash(object)));
+        filled = staticDictionary->keys[i] && staticDictionary->objects[i];
+    }
+    
+    PGCStaticDictionaryBuilderDestroy(&builder);
+    return filled;
+}
+
+
+bool PGCStaticDictionaryBuilderInit(PGCStaticDictionaryBuilder *builder, PGCArray *keys)
+{
+    uint64_t count = PGCArrayGetCount(keys);
+    uint64_t bucketCount = (count + PGCStaticDictionaryAverageBucketSize - 1) / PGCStaticDictionaryAverageBucketSize;
+
+    builder->keys = keys;
+    builder->count = count;
+    builder->keyHashes = malloc(count * sizeof(uint64_t));
+    builder->bucketCount = bucketCount;
+    builder->bucketStarts = calloc(bucketCount + 1, sizeof(uint64_t));
+    builder->bucketSizes = malloc(bucketCount * sizeof(uint64_t));
+    builder->bucketKeyIndexes = malloc(count * sizeof(uint64_t));
+    builder->bucketOrder = malloc(bucketCount * sizeof(uint64_t));
+    builder->seeds = calloc(bucketCount, sizeof(uint32_t));
+    builder->slotKeyIndexes = malloc(count * sizeof(uint64_t));
+    builder->slotIsOccupied = calloc(count, sizeof(bool));
+    builder->slots = NULL;
+    builder->overflowCount = 0;
+    builder->overflowKeyIndexes = malloc(count * sizeof(uint64_t));
+    
+    return builder->keyHashes && builder->bucketStarts && builder->bucketSizes && builder->bucketKeyIndexes && builder->bucketOrder &&
+           builder->seeds && builder->slotKeyIndexes && builder->slotIsOccupied && builder->overflowKeyIndexes;
+}
+
+
+void PGCStaticDictionaryBuilderDestroy(PGCStaticDictionaryBuilder *builder)
+{
+    free(builder->keyHashes);
+    free(builder->bucketStarts);
+    free(builder->bucketSizes);
+    free(builder->bucketKeyIndexes);
+    free(builder->bucketOrder);
+    free(builder->seeds);
+    free(builder->slotKeyIndexes);
+    free(builder->slotIsOccupied);
+    free(builder->slots);
+    free(builder->overflowKeyIndexes);
+}
+
+
+bool PGCStaticDictionaryBuilderGroupKeys(PGCStaticDictionaryBuilder *builder)
+{
+    // Count the keys in each bucket, then turn the counts into the index at which each bucket’s keys start
+    uint64_t bucketCount = builder->bucketCount;
+    for (uint64_t i = 0; i < builder->count; i++) {
+        builder->keyHashes[i] = PGCStaticDictionaryGetKeyHash(PGCArrayGetObjectAtIndex(builder->keys, i));
+        builder->bucketStarts[builder->keyHashes[i] % bucketCount + 1]++;
+    }
+    
+    for (uint64_t i = 0; i < bucketCount; i++) builder->bucketStarts[i + 1] += builder->bucketStarts[i];
+    
+    // Group the key indexes by bucket. Each bucket’s start is advanced as it’s filled, and then shifted back into place.
+    for (uint64_t i = 0; i < builder->count; i++) {
+        builder->bucketKeyIndexes[builder->bucketStarts[builder->keyHashes[i] % bucketCount]++] = i;
+    }
+    
+    memmove(&builder->bucketStarts[1], &builder->bucketStarts[0], bucketCount * sizeof(uint64_t));
+    builder->bucketStarts[0] = 0;
+    
+    // Drop duplicate keys, keeping the last of each like PGCDictionarySetObjectForKey would. Distinct keys whose hashes are
+    // identical always land in the same slot, so all but the first of them are set aside in the overflow.
+    uint64_t uniqueCount = 0;
+    uint64_t maximumBucketSize = 0;
+    for (uint64_t i = 0; i < bucketCount; i++) {
+        uint64_t *keyIndexes = &builder->bucketKeyIndexes[builder->bucketStarts[i]];
+        uint64_t size = builder->bucketStarts[i + 1] - builder->bucketStarts[i];
+        uint64_t keptCount = 0;
+        for (uint64_t j = 0; j < size; j++) {
+            uint64_t keyHash = builder->keyHashes[keyIndexes[j]];
+            bool isSuperseded = false;
+            for (uint64_t k = j + 1; !isSuperseded && k < size; k++) {
+                isSuperseded = keyHash == builder->keyHashes[keyIndexes[k]] &&
+                               PGCEquals(PGCArrayGetObjectAtIndex(builder->keys, keyIndexes[j]), PGCArrayGetObjectAtIndex(builder->keys, keyIndexes[k]));
+            }
+            
+            if (isSuperseded) continue;
+            
+            bool isOverflow = false;
+            for (uint64_t k = 0; !isOverflow && k < keptCount; k++) isOverflow = keyHash == builder->keyHashes[keyIndexes[k]];
+            
+            if (isOverflow) {
+                builder->overflowKeyIndexes[builder->overflowCount++] = keyIndexes[j];
+            } else {
+                keyIndexes[keptCount++] = keyIndexes[j];
+            }
+        }
+        
+        builder->bucketSizes[i] = keptCount;
+        uniqueCount += keptCount;
+        if (keptCount > maximumBucketSize) maximumBucketSize = keptCount;
+    }
+    
+    builder->count = uniqueCount;
+    
+    // Order the buckets from largest to smallest with a counting sort on their sizes
+    uint64_t *sizeStarts = calloc(maximumBucketSize + 2, sizeof(uint64_t));
+    builder->slots = malloc(maximumBucketSize * sizeof(uint64_t));
+    if (!sizeStarts || !builder->slots) {
+        free(sizeStarts);
+        return false;
+    }
+    
+    for (uint64_t i = 0; i < bucketCount; i++) sizeStarts[maximumBucketSize - builder->bucketSizes[i] + 1]++;
+    for (uint64_t i = 0; i <= maximumBucketSize; i++) sizeStarts[i + 1] += sizeStarts[i];
+    for (uint64_t i = 0; i < bucketCount; i++) builder->bucketOrder[sizeStarts[maximumBucketSize - builder->bucketSizes[i]]++] = i;
+    
+    free(sizeStarts);
+    return true;
+}
+
+
+bool PGCStaticDictionaryBuilderPlaceBuckets(PGCStaticDictionaryBuilder *builder)
+{
+    // This uses the hash, displace, and compress (CHD) algorithm. Keys are distributed into buckets by their hashes, and the
+    // buckets are placed from largest to smallest. Placing a bucket means finding a seed that sends each of its keys to a free
+    // slot. Large buckets are placed while most slots are still free, and by the time the table is nearly full, almost all of
+    // the remaining buckets have a single key.
+    for (uint64_t i = 0; i < builder->bucketCount; i++) {
+        if (!PGCStaticDictionaryBuilderPlaceBucket(builder, builder->bucketOrder[i])) return false;
+    }
+    
+    return true;
+}
+
+
+bool PGCStaticDictionaryBuilderPlaceBucket(PGCStaticDictionaryBuilder *builder, uint64_t bucket)
+{
+    uint64_t *keyIndexes = &builder->bucketKeyIndexes[builder->bucketStarts[bucket]];
+    uint64_t size = builder->bucketSizes[bucket];
+    if (size == 0) return true;
+    
+    for (uint64_t seed = 0; seed <= UINT32_MAX; seed++) {
+        // Tentatively occupy each key’s slot, giving them all back if any of them is already taken
+        uint64_t placedCount = 0;
+        while (placedCount < size) {
+            uint64_t slot = PGCStaticDictionaryGetSlot(builder->keyHashes[keyIndexes[placedCount]], (uint32_t)seed, builder->count);
+            if (builder->slotIsOccupied[slot]) break;
+            builder->slotIsOccupied[slot] = true;
+            builder->slots[placedCount++] = slot;
+        }
+        
+        if (placedCount == size) {
+            builder->seeds[bucket] = (uint32_t)seed;
+            for (uint64_t i = 0; i < size; i++) builder->slotKeyIndexes[builder->slots[i]] = keyIndexes[i];
+            return true;
+        }
+        
+        for (uint64_t i = 0; i < placedCount; i++) builder->slotIsOccupied[builder->slots[i]] = false;
+    }
+    
+    return false;
+}
+
+
+uint64_t PGCStaticDictionaryGetKeyHash(PGCType key)
+{
+    // Mix the key’s hash so that keys with sequential hashes, like integers, are spread over the buckets
+    return PGCHashMix(PGCHash(key));
+}
+
+
+uint64_t PGCStaticDictionaryGetSlot(uint64_t keyHash, uint32_t seed, uint64_t count)
+{
+    return PGCHashMix(keyHash ^ ((seed + 1) * 0x9E3779B97F4A7C15ULL)) % count;
+}
@@ -0,0 +1,59 @@
+//
+//  PGCStaticDictionary.h
+//  PGCFoundation
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef PGCSTATICDICTIONARY_H
+#define PGCSTATICDICTIONARY_H
+
+#include <PGCFoundation/PGCObject.h>
+#include <PGCFoundation/PGCArray.h>
+#include <PGCFoundation/PGCDictionary.h>
+
+typedef struct _PGCStaticDictionary PGCStaticDictionary;
+
+extern PGCClass *PGCStaticDictionaryClass(void);
+extern PGCStaticDictionary *PGCStaticDictionaryInstanceWithDictionary(PGCDictionary *dictionary);
+extern PGCStaticDictionary *PGCStaticDictionaryInstanceWithObjectsAndKeys(PGCArray *objects, PGCArray *keys);
+
+#pragma mark Basic Functions
+
+extern PGCStaticDictionary *PGCStaticDictionaryInitWithDictionary(PGCStaticDictionary *staticDictionary, PGCDictionary *dictionary);
+extern PGCStaticDictionary *PGCStaticDictionaryInitWithObjectsAndKeys(PGCStaticDictionary *staticDictionary, PGCArray *objects, PGCArray *keys);
+
+extern PGCType PGCStaticDictionaryCopy(PGCType instance);
+extern PGCString *PGCStaticDictionaryDescription(PGCType instance);
+extern bool PGCStaticDictionaryEquals(PGCType instance1, PGCType instance2);
+extern uint64_t PGCStaticDictionaryHash(PGCType instance);
+
+#pragma mark Accessors
+
+extern uint64_t PGCStaticDictionaryGetCount(PGCStaticDictionary *staticDictionary);
+extern PGCType PGCStaticDictionaryGetObjectForKey(PGCStaticDictionary *staticDictionary, PGCType key);
+extern bool PGCStaticDictionaryContainsKey(PGCStaticDictionary *staticDictionary, PGCType key);
+
+extern PGCArray *PGCStaticDictionaryGetAllKeys(PGCStaticDictionary *staticDictionary);
+extern PGCArray *PGCStaticDictionaryGetAllObjects(PGCStaticDictionary *staticDictionary);
+
+#endif
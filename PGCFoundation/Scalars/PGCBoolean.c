@@ -26,6 +26,7 @@
 
 #include <PGCFoundation/PGCBoolean.h>
 #include <PGCFoundation/PGCString.h>
+#include <PGCFoundation/PGCArchiver.h>
 
 #include <string.h>
 
@@ -82,7 +83,8 @@ PGCClass *PGCBooleanClass(void)
 {
     static PGCClass *booleanClass = NULL;
     if (!booleanClass) {
-        PGCClassFunctions functions = { PGCBooleanCopy, PGCBooleanDealloc, PGCBooleanDescription, PGCBooleanEquals, PGCBooleanHash, PGCBooleanRelease, PGCBooleanRetain };
+        PGCClassFunctions functions = { PGCBooleanCopy, PGCBooleanDealloc, PGCBooleanDescription, PGCBooleanEquals, PGCBooleanHash,
+                                        PGCBooleanRelease, PGCBooleanRetain, PGCBooleanEncode, PGCBooleanDecode };
         booleanClass = PGCClassCreate("PGCBoolean", PGCObjectClass(), functions, sizeof(PGCBoolean));
     }
     return booleanClass;
@@ -160,6 +162,22 @@ uint64_t PGCBooleanHash(PGCType instance)
 }
 
 
+bool PGCBooleanEncode(PGCType instance, PGCArchiver *archiver)
+{
+    if (instance != PGCBooleanTrue() && instance != PGCBooleanFalse()) return false;
+    PGCArchiverEncodeUnsignedInteger(archiver, instance == PGCBooleanTrue());
+    return true;
+}
+
+
+PGCType PGCBooleanDecode(PGCClass *class, PGCUnarchiver *unarchiver)
+{
+    uint64_t value = 0;
+    if (!PGCUnarchiverDecodeUnsignedInteger(unarchiver, &value) || value > 1) return NULL;
+    return PGCRetain(value ? PGCBooleanTrue() : PGCBooleanFalse());
+}
+
+
 void PGCBooleanRelease(PGCType instance)
 {
 }
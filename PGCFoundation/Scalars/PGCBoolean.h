@@ -107,6 +107,23 @@ extern bool PGCBooleanEquals(PGCType instance1, PGCType instance2);
  */
 extern uint64_t PGCBooleanHash(PGCType instance);
 
+/*!
+ @abstract Encodes the specified PGCBoolean object using the specified archiver.
+ @param instance The PGCBoolean object to encode.
+ @param archiver The archiver to which the object is written.
+ @result Whether the object was encoded; returns false if instance is NULL or not a PGCBoolean object.
+ @discussion The value is archived as a one-byte varint.
+ */
+extern bool PGCBooleanEncode(PGCType instance, PGCArchiver *archiver);
+
+/*!
+ @abstract Decodes a PGCBoolean object from the specified unarchiver.
+ @param class The class of the object being decoded.
+ @param unarchiver The unarchiver from which the object is read.
+ @result The decoded PGCBoolean object, i.e., either PGCBooleanTrue() or PGCBooleanFalse(); returns NULL if the object could not be decoded.
+ */
+extern PGCType PGCBooleanDecode(PGCClass *class, PGCUnarchiver *unarchiver);
+
 
 #pragma mark Accessors
 
@@ -26,7 +26,9 @@
 
 #include <PGCFoundation/PGCCharacter.h>
 #include <PGCFoundation/PGCString.h>
+#include <PGCFoundation/PGCArchiver.h>
 
+#include <limits.h>
 #include <stdio.h>
 
 /*!
@@ -45,7 +47,8 @@ PGCClass *PGCCharacterClass(void)
 {
     static PGCClass *characterClass = NULL;
     if (!characterClass) {
-        PGCClassFunctions functions = { PGCCharacterCopy, NULL, PGCCharacterDescription, PGCCharacterEquals, PGCCharacterHash, NULL, NULL };
+        PGCClassFunctions functions = { PGCCharacterCopy, NULL, PGCCharacterDescription, PGCCharacterEquals, PGCCharacterHash,
+                                        NULL, NULL, PGCCharacterEncode, PGCCharacterDecode };
         characterClass = PGCClassCreate("PGCCharacter", PGCObjectClass(), functions, sizeof(PGCCharacter));
     }
     return characterClass;
@@ -96,6 +99,22 @@ uint64_t PGCCharacterHash(PGCType instance)
 }
 
 
+bool PGCCharacterEncode(PGCType instance, PGCArchiver *archiver)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCCharacterClass())) return false;
+    PGCArchiverEncodeUnsignedInteger(archiver, (unsigned char)((PGCCharacter *)instance)->value);
+    return true;
+}
+
+
+PGCType PGCCharacterDecode(PGCClass *class, PGCUnarchiver *unarchiver)
+{
+    uint64_t value = 0;
+    if (!PGCUnarchiverDecodeUnsignedInteger(unarchiver, &value) || value > UCHAR_MAX) return NULL;
+    return PGCCharacterInitWithValue(PGCAlloc(class), (char)value);
+}
+
+
 #pragma mark Accessors
 
 char PGCCharacterGetValue(PGCCharacter *character)
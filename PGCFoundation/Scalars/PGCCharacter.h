@@ -106,6 +106,23 @@ extern bool PGCCharacterEquals(PGCType instance1, PGCType instance2);
  */
 extern uint64_t PGCCharacterHash(PGCType instance);
 
+/*!
+ @abstract Encodes the specified PGCCharacter object using the specified archiver.
+ @param instance The PGCCharacter object to encode.
+ @param archiver The archiver to which the object is written.
+ @result Whether the object was encoded; returns false if instance is NULL or not a PGCCharacter object.
+ @discussion The character is archived as an unsigned varint, so ASCII characters take a single byte.
+ */
+extern bool PGCCharacterEncode(PGCType instance, PGCArchiver *archiver);
+
+/*!
+ @abstract Decodes a PGCCharacter object from the specified unarchiver.
+ @param class The class of the object being decoded.
+ @param unarchiver The unarchiver from which the object is read.
+ @result A newly decoded PGCCharacter object with a retain count of 1; returns NULL if the object could not be decoded.
+ */
+extern PGCType PGCCharacterDecode(PGCClass *class, PGCUnarchiver *unarchiver);
+
 
 #pragma mark Accessors
 
@@ -26,6 +26,7 @@
 
 #include <PGCFoundation/PGCDecimal.h>
 #include <PGCFoundation/PGCString.h>
+#include <PGCFoundation/PGCArchiver.h>
 
 #include <stdio.h>
 
@@ -44,7 +45,8 @@ PGCClass *PGCDecimalClass(void)
 {
     static PGCClass *decimalClass = NULL;
     if (!decimalClass) {
-        PGCClassFunctions functions = { PGCDecimalCopy, NULL, PGCDecimalDescription, PGCDecimalEquals, PGCDecimalHash, NULL, NULL };
+        PGCClassFunctions functions = { PGCDecimalCopy, NULL, PGCDecimalDescription, PGCDecimalEquals, PGCDecimalHash,
+                                        NULL, NULL, PGCDecimalEncode, PGCDecimalDecode };
         decimalClass = PGCClassCreate("PGCDecimal", PGCObjectClass(), functions, sizeof(PGCDecimal));
     }
     return decimalClass;
@@ -98,6 +100,22 @@ uint64_t PGCDecimalHash(PGCType instance)
 }
 
 
+bool PGCDecimalEncode(PGCType instance, PGCArchiver *archiver)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCDecimalClass())) return false;
+    PGCArchiverEncodeDecimal(archiver, ((PGCDecimal *)instance)->value);
+    return true;
+}
+
+
+PGCType PGCDecimalDecode(PGCClass *class, PGCUnarchiver *unarchiver)
+{
+    double value = 0.0;
+    if (!PGCUnarchiverDecodeDecimal(unarchiver, &value)) return NULL;
+    return PGCDecimalInitWithValue(PGCAlloc(class), value);
+}
+
+
 #pragma mark Accessors
 
 double PGCDecimalGetValue(PGCDecimal *decimal)
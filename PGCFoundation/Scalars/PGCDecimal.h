@@ -106,6 +106,23 @@ extern bool PGCDecimalEquals(PGCType instance1, PGCType instance2);
  */
 extern uint64_t PGCDecimalHash(PGCType instance);
 
+/*!
+ @abstract Encodes the specified PGCDecimal object using the specified archiver.
+ @param instance The PGCDecimal object to encode.
+ @param archiver The archiver to which the object is written.
+ @result Whether the object was encoded; returns false if instance is NULL or not a PGCDecimal object.
+ @discussion The value is archived as its 8 IEEE 754 bytes, so it decodes to exactly the same value.
+ */
+extern bool PGCDecimalEncode(PGCType instance, PGCArchiver *archiver);
+
+/*!
+ @abstract Decodes a PGCDecimal object from the specified unarchiver.
+ @param class The class of the object being decoded.
+ @param unarchiver The unarchiver from which the object is read.
+ @result A newly decoded PGCDecimal object with a retain count of 1; returns NULL if the object could not be decoded.
+ */
+extern PGCType PGCDecimalDecode(PGCClass *class, PGCUnarchiver *unarchiver);
+
 
 #pragma mark Accessors
 
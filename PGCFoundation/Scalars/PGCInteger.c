@@ -26,6 +26,7 @@
 
 #include <PGCFoundation/PGCInteger.h>
 #include <PGCFoundation/PGCString.h>
+#include <PGCFoundation/PGCArchiver.h>
 
 #include <stdio.h>
 
@@ -50,7 +51,8 @@ PGCClass *PGCIntegerClass(void)
 {
     static PGCClass *integerClass = NULL;
     if (!integerClass) {
-        PGCClassFunctions functions = { PGCIntegerCopy, NULL, PGCIntegerDescription, PGCIntegerEquals, PGCIntegerHash, NULL, NULL };
+        PGCClassFunctions functions = { PGCIntegerCopy, NULL, PGCIntegerDescription, PGCIntegerEquals, PGCIntegerHash,
+                                        NULL, NULL, PGCIntegerEncode, PGCIntegerDecode };
         integerClass = PGCClassCreate("PGCInteger", PGCObjectClass(), functions, sizeof(PGCInteger));
     }
     return integerClass;
@@ -145,8 +147,51 @@ uint64_t PGCIntegerHash(PGCType instance)
 }
 
 
+bool PGCIntegerEncode(PGCType instance, PGCArchiver *archiver)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCIntegerClass())) return false;
+    PGCInteger *integer = instance;
+    
+    PGCArchiverEncodeUnsignedInteger(archiver, integer->isSigned);
+    if (integer->isSigned) {
+        PGCArchiverEncodeSignedInteger(archiver, integer->value.signedValue);
+    } else {
+        PGCArchiverEncodeUnsignedInteger(archiver, integer->value.unsignedValue);
+    }
+    
+    return true;
+}
+
+
+PGCType PGCIntegerDecode(PGCClass *class, PGCUnarchiver *unarchiver)
+{
+    uint64_t isSigned = 0;
+    if (!PGCUnarchiverDecodeUnsignedInteger(unarchiver, &isSigned) || isSigned > 1) return NULL;
+    
+    if (isSigned) {
+        int64_t value = 0;
+        return PGCUnarchiverDecodeSignedInteger(unarchiver, &value) ? PGCIntegerInitWithSignedValue(PGCAlloc(class), value) : NULL;
+    } else {
+        uint64_t value = 0;
+        return PGCUnarchiverDecodeUnsignedInteger(unarchiver, &value) ? PGCIntegerInitWithUnsignedValue(PGCAlloc(class), value) : NULL;
+    }
+}
+
+
 #pragma mark Accessors
 
+bool PGCIntegerIsSigned(PGCInteger *integer)
+{
+    return integer ? integer->isSigned : false;
+}
+
+
+bool PGCIntegerIsUnsigned(PGCInteger *integer)
+{
+    return integer ? !integer->isSigned : false;
+}
+
+
 int64_t PGCIntegerGetSignedValue(PGCInteger *integer)
 {
     return integer ? integer->value.signedValue : 0;
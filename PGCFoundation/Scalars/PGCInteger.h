@@ -128,6 +128,23 @@ extern bool PGCIntegerEquals(PGCType instance1, PGCType instance2);
  */
 extern uint64_t PGCIntegerHash(PGCType instance);
 
+/*!
+ @abstract Encodes the specified PGCInteger object using the specified archiver.
+ @param instance The PGCInteger object to encode.
+ @param archiver The archiver to which the object is written.
+ @result Whether the object was encoded; returns false if instance is NULL or not a PGCInteger object.
+ @discussion Whether the integer is signed is archived along with its value. Signed values are zigzag-encoded, so integers with small magnitudes take very little space regardless of their sign.
+ */
+extern bool PGCIntegerEncode(PGCType instance, PGCArchiver *archiver);
+
+/*!
+ @abstract Decodes a PGCInteger object from the specified unarchiver.
+ @param class The class of the object being decoded.
+ @param unarchiver The unarchiver from which the object is read.
+ @result A newly decoded PGCInteger object with a retain count of 1; returns NULL if the object could not be decoded.
+ */
+extern PGCType PGCIntegerDecode(PGCClass *class, PGCUnarchiver *unarchiver);
+
 
 #pragma mark Accessors
 
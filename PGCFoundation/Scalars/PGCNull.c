@@ -26,6 +26,7 @@
 
 #include <PGCFoundation/PGCNull.h>
 #include <PGCFoundation/PGCString.h>
+#include <PGCFoundation/PGCArchiver.h>
 
 #include <string.h>
 
@@ -72,7 +73,8 @@ PGCClass *PGCNullClass(void)
 {
     static PGCClass *nullClass = NULL;
     if (!nullClass) {
-        PGCClassFunctions functions = { PGCNullCopy, PGCNullDealloc, PGCNullDescription, PGCNullEquals, PGCNullHash, PGCNullRelease, PGCNullRetain };
+        PGCClassFunctions functions = { PGCNullCopy, PGCNullDealloc, PGCNullDescription, PGCNullEquals, PGCNullHash,
+                                        PGCNullRelease, PGCNullRetain, PGCNullEncode, PGCNullDecode };
         nullClass = PGCClassCreate("PGCNull", PGCObjectClass(), functions, sizeof(PGCNull));
     }
     return nullClass;
@@ -121,6 +123,19 @@ uint64_t PGCNullHash(PGCType instance)
 }
 
 
+bool PGCNullEncode(PGCType instance, PGCArchiver *archiver)
+{
+    // The null object has no contents; its class reference is all that needs to be archived
+    return instance == PGCNullInstance();
+}
+
+
+PGCType PGCNullDecode(PGCClass *class, PGCUnarchiver *unarchiver)
+{
+    return unarchiver ? PGCRetain(PGCNullInstance()) : NULL;
+}
+
+
 void PGCNullRelease(PGCType instance)
 {
 }
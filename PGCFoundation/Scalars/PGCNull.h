@@ -96,4 +96,21 @@ extern bool PGCNullEquals(PGCType instance1, PGCType instance2);
  */
 extern uint64_t PGCNullHash(PGCType instance);
 
+/*!
+ @abstract Encodes the specified PGCNull object using the specified archiver.
+ @param instance The PGCNull object to encode.
+ @param archiver The archiver to which the object is written.
+ @result Whether the object was encoded; returns false if instance is NULL or not a PGCNull object.
+ @discussion Nothing beyond the object’s class is archived, as there is only one PGCNull object.
+ */
+extern bool PGCNullEncode(PGCType instance, PGCArchiver *archiver);
+
+/*!
+ @abstract Decodes a PGCNull object from the specified unarchiver.
+ @param class The class of the object being decoded.
+ @param unarchiver The unarchiver from which the object is read.
+ @result The PGCNull object; returns NULL if the object could not be decoded.
+ */
+extern PGCType PGCNullDecode(PGCClass *class, PGCUnarchiver *unarchiver);
+
 #endif
@@ -25,6 +25,7 @@
 //
 
 #include <PGCFoundation/PGCString.h>
+#include <PGCFoundation/PGCArchiver.h>
 
 #include <ctype.h>
 #include <string.h>
@@ -56,7 +57,8 @@ PGCClass *PGCStringClass(void)
 {
     static PGCClass *stringClass = NULL;
     if (!stringClass) {
-        PGCClassFunctions functions = { PGCStringCopy, PGCStringDealloc, PGCStringDescription, PGCStringEquals, PGCStringHash, NULL, NULL };
+        PGCClassFunctions functions = { PGCStringCopy, PGCStringDealloc, PGCStringDescription, PGCStringEquals, PGCStringHash,
+                                        NULL, NULL, PGCStringEncode, PGCStringDecode };
         stringClass = PGCClassCreate("PGCString", PGCObjectClass(), functions, sizeof(PGCString));
     }
     return stringClass;
@@ -206,6 +208,21 @@ uint64_t PGCStringHash(PGCType instance)
 }
 
 
+bool PGCStringEncode(PGCType instance, PGCArchiver *archiver)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCStringClass())) return false;
+    PGCArchiverEncodeCString(archiver, ((PGCString *)instance)->buffer);
+    return true;
+}
+
+
+PGCType PGCStringDecode(PGCClass *class, PGCUnarchiver *unarchiver)
+{
+    const char *cString = PGCUnarchiverDecodeCString(unarchiver);
+    return cString ? PGCStringInitWithCString(PGCAlloc(class), cString) : NULL;
+}
+
+
 void PGCStringReallocateBuffer(PGCString *string, uint64_t minimumLength)
 {
     if (!string || minimumLength <= string->length) return;
@@ -385,6 +402,20 @@ void PGCStringAppendString(PGCString *string, PGCString *appendString)
 }
 
 
+void PGCStringAppendBytes(PGCString *string, const char *bytes, uint64_t length)
+{
+    if (!string || (!bytes && length > 0)) return;
+    
+    uint64_t minimumStringLength = string->length + length;
+    PGCStringReallocateBuffer(string, minimumStringLength);
+    if (string->capacity <= minimumStringLength) return;
+    
+    memcpy(&string->buffer[string->length], bytes, length);
+    string->length = minimumStringLength;
+    string->buffer[string->length] = '\0';
+}
+
+
 void PGCStringAppendFormat(PGCString *string, const char *format, ...)
 {
     if (!string || !format) return;
@@ -395,6 +426,7 @@ void PGCStringAppendFormat(PGCString *string, const char *format, ...)
     va_end(arguments);
     
     PGCStringAppendString(string, formattedString);
+    PGCRelease(formattedString);
 }
 
 
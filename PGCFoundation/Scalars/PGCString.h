@@ -47,6 +47,8 @@ extern PGCType PGCStringCopy(PGCType instance);
 extern PGCString *PGCStringDescription(PGCType instance);
 extern bool PGCStringEquals(PGCType instance1, PGCType instance2);
 extern uint64_t PGCStringHash(PGCType instance);
+extern bool PGCStringEncode(PGCType instance, PGCArchiver *archiver);
+extern PGCType PGCStringDecode(PGCClass *class, PGCUnarchiver *unarchiver);
 
 #pragma mark Accessors
 
@@ -81,6 +83,7 @@ extern void PGCStringReplaceCharactersInRangeWithString(PGCString *string, PGCRa
 extern void PGCStringPrependString(PGCString *string, PGCString *prependString);
 extern void PGCStringInsertStringAtIndex(PGCString *string, PGCString *insertString, uint64_t index);
 extern void PGCStringAppendString(PGCString *string, PGCString *appendString);
+extern void PGCStringAppendBytes(PGCString *string, const char *bytes, uint64_t length);
 extern void PGCStringAppendFormat(PGCString *string, const char *format, ...);
 
 // PGCStringRemoveCharactersInRange
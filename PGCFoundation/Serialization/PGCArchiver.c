@@ -0,0 +1,633 @@
+//
+//  PGCArchiver.c
+//  PGCFoundation
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <PGCFoundation/PGCArchiver.h>
+
+#include <PGCFoundation/PGCArray.h>
+#include <PGCFoundation/PGCBoolean.h>
+#include <PGCFoundation/PGCCharacter.h>
+#include <PGCFoundation/PGCDecimal.h>
+#include <PGCFoundation/PGCDictionary.h>
+#include <PGCFoundation/PGCInteger.h>
+#include <PGCFoundation/PGCList.h>
+#include <PGCFoundation/PGCNull.h>
+
+#include <string.h>
+
+// Archives begin with a magic number and a version, which are followed by the root object. Each object is written as a reference
+// to its class followed by whatever its class’s Encode function writes. The first time a class appears in an archive, it is 
+// written as 0 followed by the class’s name; afterwards, it is written as its index in the archive’s class table plus 1. C strings
+// are deduplicated the same way: the first occurrence is written as 0 followed by its length, characters, and a NUL terminator, 
+// and each subsequent occurrence is written as its index in the archive’s string table plus 1.
+//
+// Unsigned integers, counts, and lengths are written as LEB128 varints, signed integers are zigzag-encoded so that small negative
+// values stay small, and decimals are written as their 8 IEEE 754 bytes in little-endian order.
+typedef struct _PGCArchiverStringEntry {
+    uint64_t hash;
+    uint64_t offset;
+    uint64_t length;
+    uint64_t reference;
+} PGCArchiverStringEntry;
+
+
+struct _PGCArchiver {
+    PGCObject super;
+    uint8_t *bytes;
+    uint64_t length;
+    uint64_t capacity;
+    
+    PGCClass **classes;
+    uint64_t classCount;
+    uint64_t classCapacity;
+    
+    // An open-addressed hash table of the strings written so far. A slot whose reference is 0 is empty.
+    PGCArchiverStringEntry *strings;
+    uint64_t stringCount;
+    uint64_t stringCapacity;
+    
+    uint64_t depth;
+    bool hasFailed;
+};
+
+
+struct _PGCUnarchiver {
+    PGCObject super;
+    uint8_t *bytes;
+    uint64_t length;
+    uint64_t position;
+    
+    PGCClass **classes;
+    uint64_t classCount;
+    uint64_t classCapacity;
+    
+    // Decoded strings point directly into bytes
+    const char **strings;
+    uint64_t stringCount;
+    uint64_t stringCapacity;
+    
+    uint64_t depth;
+    bool hasFailed;
+};
+
+
+#pragma mark Private Global Constants
+
+static const char PGCArchiverMagic[6] = { 'P', 'G', 'C', 'A', 'R', 'C' };
+static const uint64_t PGCArchiverVersion = 1;
+static const uint64_t PGCArchiverInitialCapacity = 4096;
+static const uint64_t PGCArchiverInitialStringCapacity = 64;
+static const uint64_t PGCArchiverMaximumDepth = 1024;
+
+
+#pragma mark Private Function Interfaces
+
+void PGCArchiverDealloc(PGCType instance);
+uint8_t *PGCArchiverReserveBytes(PGCArchiver *archiver, uint64_t length);
+bool PGCArchiverEncodeClass(PGCArchiver *archiver, PGCClass *class);
+bool PGCArchiverGrowStringTable(PGCArchiver *archiver);
+
+void PGCUnarchiverDealloc(PGCType instance);
+PGCClass *PGCUnarchiverDecodeClass(PGCUnarchiver *unarchiver);
+
+
+#pragma mark - PGCArchiver
+
+PGCClass *PGCArchiverClass(void)
+{
+    static PGCClass *archiverClass = NULL;
+    if (!archiverClass) {
+        PGCClassFunctions functions = { NULL, PGCArchiverDealloc, NULL, NULL, NULL, NULL, NULL };
+        archiverClass = PGCClassCreate("PGCArchiver", PGCObjectClass(), functions, sizeof(PGCArchiver));
+    }
+    return archiverClass;
+}
+
+
+PGCArchiver *PGCArchiverInstance(void)
+{
+    return PGCAutorelease(PGCArchiverInit(NULL));
+}
+
+
+#pragma mark Basic Functions
+
+PGCArchiver *PGCArchiverInit(PGCArchiver *archiver)
+{
+    if (!archiver && (archiver = PGCAlloc(PGCArchiverClass())) == NULL) return NULL;
+    PGCObjectInit(&archiver->super);
+    
+    archiver->bytes = malloc(PGCArchiverInitialCapacity);
+    archiver->strings = calloc(PGCArchiverInitialStringCapacity, sizeof(PGCArchiverStringEntry));
+    if (!archiver->bytes || !archiver->strings) {
+        PGCRelease(archiver);
+        return NULL;
+    }
+    
+    archiver->capacity = PGCArchiverInitialCapacity;
+    archiver->stringCapacity = PGCArchiverInitialStringCapacity;
+    
+    memcpy(archiver->bytes, PGCArchiverMagic, sizeof(PGCArchiverMagic));
+    archiver->length = sizeof(PGCArchiverMagic);
+    PGCArchiverEncodeUnsignedInteger(archiver, PGCArchiverVersion);
+    
+    return archiver;
+}
+
+
+void PGCArchiverDealloc(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCArchiverClass())) return;
+    PGCArchiver *archiver = instance;
+    
+    free(archiver->bytes);
+    free(archiver->classes);
+    free(archiver->strings);
+    
+    PGCSuperclassDealloc(archiver);
+}
+
+
+#pragma mark Accessors
+
+const void *PGCArchiverGetBytes(PGCArchiver *archiver)
+{
+    return archiver && !archiver->hasFailed ? archiver->bytes : NULL;
+}
+
+
+uint64_t PGCArchiverGetLength(PGCArchiver *archiver)
+{
+    return archiver && !archiver->hasFailed ? archiver->length : 0;
+}
+
+
+#pragma mark Encoding
+
+bool PGCArchiverEncodeObject(PGCArchiver *archiver, PGCType object)
+{
+    if (!archiver || archiver->hasFailed) return false;
+    
+    PGCClass *class = PGCObjectGetClass(object);
+    PGCEncodeFunction *encode = PGCClassGetEncodeFunction(class);
+    if (!encode || !PGCClassGetDecodeFunction(class)) {
+        archiver->hasFailed = true;
+        return false;
+    }
+    
+    // Limiting the depth keeps an object that contains itself from recursing forever
+    if (archiver->depth >= PGCArchiverMaximumDepth || !PGCArchiverEncodeClass(archiver, class)) {
+        archiver->hasFailed = true;
+        return false;
+    }
+    
+    archiver->depth++;
+    if (!encode(object, archiver)) archiver->hasFailed = true;
+    archiver->depth--;
+    
+    return !archiver->hasFailed;
+}
+
+
+void PGCArchiverEncodeUnsignedInteger(PGCArchiver *archiver, uint64_t value)
+{
+    uint8_t *bytes = PGCArchiverReserveBytes(archiver, 10);
+    if (!bytes) return;
+    
+    uint64_t length = 0;
+    while (value >= 0x80) {
+        bytes[length++] = (uint8_t)value | 0x80;
+        value >>= 7;
+    }
+    
+    bytes[length++] = (uint8_t)value;
+    archiver->length += length;
+}
+
+
+void PGCArchiverEncodeSignedInteger(PGCArchiver *archiver, int64_t value)
+{
+    PGCArchiverEncodeUnsignedInteger(archiver, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+
+void PGCArchiverEncodeDecimal(PGCArchiver *archiver, double value)
+{
+    uint8_t *bytes = PGCArchiverReserveBytes(archiver, sizeof(double));
+    if (!bytes) return;
+    
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(double));
+    for (uint64_t i = 0; i < sizeof(double); i++) bytes[i] = (uint8_t)(bits >> (8 * i));
+    archiver->length += sizeof(double);
+}
+
+
+void PGCArchiverEncodeCount(PGCArchiver *archiver, uint64_t count)
+{
+    PGCArchiverEncodeUnsignedInteger(archiver, count);
+}
+
+
+void PGCArchiverEncodeBytes(PGCArchiver *archiver, const void *bytes, uint64_t length)
+{
+    PGCArchiverEncodeUnsignedInteger(archiver, length);
+    
+    uint8_t *destination = PGCArchiverReserveBytes(archiver, length);
+    if (!destination) return;
+    
+    if (length > 0) memcpy(destination, bytes, length);
+    archiver->length += length;
+}
+
+
+void PGCArchiverEncodeCString(PGCArchiver *archiver, const char *cString)
+{
+    if (!archiver || archiver->hasFailed) return;
+    if (!cString) {
+        archiver->hasFailed = true;
+        return;
+    }
+    
+    uint64_t length = strlen(cString);
+    uint64_t hash = PGCHashBytes(cString, length);
+    
+    // Look the string up in our table. If we’ve already written it, we only need to write its reference.
+    uint64_t mask = archiver->stringCapacity - 1;
+    uint64_t slot = hash & mask;
+    while (archiver->strings[slot].reference) {
+        PGCArchiverStringEntry *entry = &archiver->strings[slot];
+        if (entry->hash == hash && entry->length == length && memcmp(archiver->bytes + entry->offset, cString, length) == 0) {
+            PGCArchiverEncodeUnsignedInteger(archiver, entry->reference);
+            return;
+        }
+        
+        slot = (slot + 1) & mask;
+    }
+    
+    PGCArchiverEncodeUnsignedInteger(archiver, 0);
+    PGCArchiverEncodeUnsignedInteger(archiver, length);
+    uint8_t *bytes = PGCArchiverReserveBytes(archiver, length + 1);
+    if (!bytes) return;
+    
+    memcpy(bytes, cString, length + 1);
+    archiver->strings[slot].hash = hash;
+    archiver->strings[slot].offset = archiver->length;
+    archiver->strings[slot].length = length;
+    archiver->strings[slot].reference = ++archiver->stringCount;
+    archiver->length += length + 1;
+    
+    // Keep the table at most half full so that probe sequences stay short
+    if (archiver->stringCount * 2 > archiver->stringCapacity && !PGCArchiverGrowStringTable(archiver)) archiver->hasFailed = true;
+}
+
+
+#pragma mark Private Functions
+
+uint8_t *PGCArchiverReserveBytes(PGCArchiver *archiver, uint64_t length)
+{
+    if (!archiver || archiver->hasFailed) return NULL;
+    
+    if (archiver->capacity - archiver->length < length) {
+        uint64_t capacity = archiver->capacity * 2;
+        while (capacity - archiver->length < length) capacity *= 2;
+        
+        uint8_t *bytes = realloc(archiver->bytes, capacity);
+        if (!bytes) {
+            archiver->hasFailed = true;
+            return NULL;
+        }
+        
+        archiver->bytes = bytes;
+        archiver->capacity = capacity;
+    }
+    
+    return archiver->bytes + archiver->length;
+}
+
+
+bool PGCArchiverEncodeClass(PGCArchiver *archiver, PGCClass *class)
+{
+    // Archives rarely contain more than a handful of classes, so a linear search is fastest
+    for (uint64_t i = 0; i < archiver->classCount; i++) {
+        if (archiver->classes[i] == class) {
+            PGCArchiverEncodeUnsignedInteger(archiver, i + 1);
+            return true;
+        }
+    }
+    
+    if (archiver->classCount == archiver->classCapacity) {
+        uint64_t capacity = archiver->classCapacity ? archiver->classCapacity * 2 : 16;
+        PGCClass **classes = realloc(archiver->classes, capacity * sizeof(PGCClass *));
+        if (!classes) return false;
+        
+        archiver->classes = classes;
+        archiver->classCapacity = capacity;
+    }
+    
+    archiver->classes[archiver->classCount++] = class;
+    PGCArchiverEncodeUnsignedInteger(archiver, 0);
+    PGCArchiverEncodeCString(archiver, PGCClassGetName(class));
+    return !archiver->hasFailed;
+}
+
+
+bool PGCArchiverGrowStringTable(PGCArchiver *archiver)
+{
+    uint64_t capacity = archiver->stringCapacity * 2;
+    PGCArchiverStringEntry *strings = calloc(capacity, sizeof(PGCArchiverStringEntry));
+    if (!strings) return false;
+    
+    uint64_t mask = capacity - 1;
+    for (uint64_t i = 0; i < archiver->stringCapacity; i++) {
+        if (!archiver->strings[i].reference) continue;
+        
+        uint64_t slot = archiver->strings[i].hash & mask;
+        while (strings[slot].reference) slot = (slot + 1) & mask;
+        strings[slot] = archiver->strings[i];
+    }
+    
+    free(archiver->strings);
+    archiver->strings = strings;
+    archiver->stringCapacity = capacity;
+    return true;
+}
+
+
+#pragma mark - PGCUnarchiver
+
+PGCClass *PGCUnarchiverClass(void)
+{
+    static PGCClass *unarchiverClass = NULL;
+    if (!unarchiverClass) {
+        PGCClassFunctions functions = { NULL, PGCUnarchiverDealloc, NULL, NULL, NULL, NULL, NULL };
+        unarchiverClass = PGCClassCreate("PGCUnarchiver", PGCObjectClass(), functions, sizeof(PGCUnarchiver));
+    }
+    return unarchiverClass;
+}
+
+
+PGCUnarchiver *PGCUnarchiverInstanceWithBytes(const void *bytes, uint64_t length)
+{
+    return PGCAutorelease(PGCUnarchiverInitWithBytes(NULL, bytes, length));
+}
+
+
+#pragma mark Basic Functions
+
+PGCUnarchiver *PGCUnarchiverInitWithBytes(PGCUnarchiver *unarchiver, const void *bytes, uint64_t length)
+{
+    if (!unarchiver && (unarchiver = PGCAlloc(PGCUnarchiverClass())) == NULL) return NULL;
+    PGCObjectInit(&unarchiver->super);
+    
+    if (!bytes || length < sizeof(PGCArchiverMagic) || memcmp(bytes, PGCArchiverMagic, sizeof(PGCArchiverMagic)) != 0) {
+        PGCRelease(unarchiver);
+        return NULL;
+    }
+    
+    // We keep our own copy of the archive so that decoded C strings can point directly into it
+    unarchiver->bytes = malloc(length);
+    if (!unarchiver->bytes) {
+        PGCRelease(unarchiver);
+        return NULL;
+    }
+    
+    memcpy(unarchiver->bytes, bytes, length);
+    unarchiver->length = length;
+    unarchiver->position = sizeof(PGCArchiverMagic);
+    
+    uint64_t version = 0;
+    if (!PGCUnarchiverDecodeUnsignedInteger(unarchiver, &version) || version != PGCArchiverVersion) {
+        PGCRelease(unarchiver);
+        return NULL;
+    }
+    
+    // Archives refer to classes by name, so make sure that the classes that can be archived by default have been created
+    PGCArrayClass();
+    PGCBooleanClass();
+    PGCCharacterClass();
+    PGCDecimalClass();
+    PGCDictionaryClass();
+    PGCIntegerClass();
+    PGCListClass();
+    PGCNullClass();
+    PGCStringClass();
+    
+    return unarchiver;
+}
+
+
+void PGCUnarchiverDealloc(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCUnarchiverClass())) return;
+    PGCUnarchiver *unarchiver = instance;
+    
+    free(unarchiver->bytes);
+    free(unarchiver->classes);
+    free(unarchiver->strings);
+    
+    PGCSuperclassDealloc(unarchiver);
+}
+
+
+#pragma mark Accessors
+
+bool PGCUnarchiverIsAtEnd(PGCUnarchiver *unarchiver)
+{
+    return unarchiver ? unarchiver->position == unarchiver->length : true;
+}
+
+
+bool PGCUnarchiverHasFailed(PGCUnarchiver *unarchiver)
+{
+    return unarchiver ? unarchiver->hasFailed : true;
+}
+
+
+#pragma mark Decoding
+
+PGCType PGCUnarchiverDecodeObject(PGCUnarchiver *unarchiver)
+{
+    if (!unarchiver || unarchiver->hasFailed) return NULL;
+    
+    PGCClass *class = PGCUnarchiverDecodeClass(unarchiver);
+    if (!class || unarchiver->depth >= PGCArchiverMaximumDepth) {
+        unarchiver->hasFailed = true;
+        return NULL;
+    }
+    
+    unarchiver->depth++;
+    PGCType object = PGCClassGetDecodeFunction(class)(class, unarchiver);
+    unarchiver->depth--;
+    
+    if (!object || unarchiver->hasFailed) {
+        PGCRelease(object);
+        unarchiver->hasFailed = true;
+        return NULL;
+    }
+    
+    return PGCAutorelease(object);
+}
+
+
+bool PGCUnarchiverDecodeUnsignedInteger(PGCUnarchiver *unarchiver, uint64_t *value)
+{
+    if (!unarchiver || unarchiver->hasFailed) return false;
+    
+    uint64_t result = 0;
+    for (uint64_t shift = 0; shift < 64 && unarchiver->position < unarchiver->length; shift += 7) {
+        uint8_t byte = unarchiver->bytes[unarchiver->position++];
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            if (value) *value = result;
+            return true;
+        }
+    }
+    
+    unarchiver->hasFailed = true;
+    return false;
+}
+
+
+bool PGCUnarchiverDecodeSignedInteger(PGCUnarchiver *unarchiver, int64_t *value)
+{
+    uint64_t zigzag = 0;
+    if (!PGCUnarchiverDecodeUnsignedInteger(unarchiver, &zigzag)) return false;
+    if (value) *value = (int64_t)((zigzag >> 1) ^ -(zigzag & 1));
+    return true;
+}
+
+
+bool PGCUnarchiverDecodeDecimal(PGCUnarchiver *unarchiver, double *value)
+{
+    if (!unarchiver || unarchiver->hasFailed) return false;
+    if (unarchiver->length - unarchiver->position < sizeof(double)) {
+        unarchiver->hasFailed = true;
+        return false;
+    }
+    
+    uint64_t bits = 0;
+    for (uint64_t i = 0; i < sizeof(double); i++) bits |= (uint64_t)unarchiver->bytes[unarchiver->position + i] << (8 * i);
+    unarchiver->position += sizeof(double);
+    
+    if (value) memcpy(value, &bits, sizeof(double));
+    return true;
+}
+
+
+bool PGCUnarchiverDecodeCount(PGCUnarchiver *unarchiver, uint64_t *count)
+{
+    // Every element takes at least one byte, so a count larger than the rest of the archive must be corrupt. Checking this here
+    // lets Decode functions safely preallocate storage for the elements.
+    uint64_t result = 0;
+    if (!PGCUnarchiverDecodeUnsignedInteger(unarchiver, &result)) return false;
+    if (result > unarchiver->length - unarchiver->position) {
+        unarchiver->hasFailed = true;
+        return false;
+    }
+    
+    if (count) *count = result;
+    return true;
+}
+
+
+const void *PGCUnarchiverDecodeBytes(PGCUnarchiver *unarchiver, uint64_t *length)
+{
+    uint64_t byteCount = 0;
+    if (!PGCUnarchiverDecodeCount(unarchiver, &byteCount)) return NULL;
+    
+    const void *bytes = unarchiver->bytes + unarchiver->position;
+    unarchiver->position += byteCount;
+    
+    if (length) *length = byteCount;
+    return bytes;
+}
+
+
+const char *PGCUnarchiverDecodeCString(PGCUnarchiver *unarchiver)
+{
+    uint64_t reference = 0;
+    if (!PGCUnarchiverDecodeUnsignedInteger(unarchiver, &reference)) return NULL;
+    
+    if (reference > 0) {
+        if (reference > unarchiver->stringCount) {
+            unarchiver->hasFailed = true;
+            return NULL;
+        }
+        
+        return unarchiver->strings[reference - 1];
+    }
+    
+    // The string must be followed by its NUL terminator and must not contain any other NULs
+    uint64_t length = 0;
+    if (!PGCUnarchiverDecodeCount(unarchiver, &length)) return NULL;
+    
+    const char *cString = (const char *)unarchiver->bytes + unarchiver->position;
+    if (length == unarchiver->length - unarchiver->position || cString[length] != '\0' || memchr(cString, '\0', length)) {
+        unarchiver->hasFailed = true;
+        return NULL;
+    }
+    
+    if (unarchiver->stringCount == unarchiver->stringCapacity) {
+        uint64_t capacity = unarchiver->stringCapacity ? unarchiver->stringCapacity * 2 : PGCArchiverInitialStringCapacity;
+        const char **strings = realloc(unarchiver->strings, capacity * sizeof(const char *));
+        if (!strings) {
+            unarchiver->hasFailed = true;
+            return NULL;
+        }
+        
+        unarchiver->strings = strings;
+        unarchiver->stringCapacity = capacity;
+    }
+    
+    unarchiver->strings[unarchiver->stringCount++] = cString;
+    unarchiver->position += length + 1;
+    return cString;
+}
+
+
+#pragma mark Private Functions
+
+PGCClass *PGCUnarchiverDecodeClass(PGCUnarchiver *unarchiver)
+{
+    uint64_t reference = 0;
+    if (!PGCUnarchiverDecodeUnsignedInteger(unarchiver, &reference)) return NULL;
+    if (reference > 0) return reference <= unarchiver->classCount ? unarchiver->classes[reference - 1] : NULL;
+    
+    PGCClass *class = PGCClassGetClassWithName(PGCUnarchiverDecodeCString(unarchiver));
+    if (!class || !PGCClassGetDecodeFunction(class)) return NULL;
+    
+    if (unarchiver->classCount == unarchiver->classCapacity) {
+        uint64_t capacity = unarchiver->classCapacity ? unarchiver->classCapacity * 2 : 16;
+        PGCClass **classes = realloc(unarchiver->classes, capacity * sizeof(PGCClass *));
+        if (!classes) return NULL;
+        
+        unarchiver->classes = classes;
+        unarchiver->classCapacity = capacity;
+    }
+    
+    unarchiver->classes[unarchiver->classCount++] = class;
+    return class;
+}
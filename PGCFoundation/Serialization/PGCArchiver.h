@@ -0,0 +1,81 @@
+//
+//  PGCArchiver.h
+//  PGCFoundation
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef PGCARCHIVER_H
+#define PGCARCHIVER_H
+
+#include <PGCFoundation/PGCObject.h>
+#include <PGCFoundation/PGCString.h>
+
+#pragma mark - PGCArchiver
+
+extern PGCClass *PGCArchiverClass(void);
+extern PGCArchiver *PGCArchiverInstance(void);
+
+#pragma mark Basic Functions
+
+extern PGCArchiver *PGCArchiverInit(PGCArchiver *archiver);
+
+#pragma mark Accessors
+
+extern const void *PGCArchiverGetBytes(PGCArchiver *archiver);
+extern uint64_t PGCArchiverGetLength(PGCArchiver *archiver);
+
+#pragma mark Encoding
+
+extern bool PGCArchiverEncodeObject(PGCArchiver *archiver, PGCType object);
+extern void PGCArchiverEncodeUnsignedInteger(PGCArchiver *archiver, uint64_t value);
+extern void PGCArchiverEncodeSignedInteger(PGCArchiver *archiver, int64_t value);
+extern void PGCArchiverEncodeDecimal(PGCArchiver *archiver, double value);
+extern void PGCArchiverEncodeCount(PGCArchiver *archiver, uint64_t count);
+extern void PGCArchiverEncodeBytes(PGCArchiver *archiver, const void *bytes, uint64_t length);
+extern void PGCArchiverEncodeCString(PGCArchiver *archiver, const char *cString);
+
+#pragma mark - PGCUnarchiver
+
+extern PGCClass *PGCUnarchiverClass(void);
+extern PGCUnarchiver *PGCUnarchiverInstanceWithBytes(const void *bytes, uint64_t length);
+
+#pragma mark Basic Functions
+
+extern PGCUnarchiver *PGCUnarchiverInitWithBytes(PGCUnarchiver *unarchiver, const void *bytes, uint64_t length);
+
+#pragma mark Accessors
+
+extern bool PGCUnarchiverIsAtEnd(PGCUnarchiver *unarchiver);
+extern bool PGCUnarchiverHasFailed(PGCUnarchiver *unarchiver);
+
+#pragma mark Decoding
+
+extern PGCType PGCUnarchiverDecodeObject(PGCUnarchiver *unarchiver);
+extern bool PGCUnarchiverDecodeUnsignedInteger(PGCUnarchiver *unarchiver, uint64_t *value);
+extern bool PGCUnarchiverDecodeSignedInteger(PGCUnarchiver *unarchiver, int64_t *value);
+extern bool PGCUnarchiverDecodeDecimal(PGCUnarchiver *unarchiver, double *value);
+extern bool PGCUnarchiverDecodeCount(PGCUnarchiver *unarchiver, uint64_t *count);
+extern const void *PGCUnarchiverDecodeBytes(PGCUnarchiver *unarchiver, uint64_t *length);
+extern const char *PGCUnarchiverDecodeCString(PGCUnarchiver *unarchiver);
+
+#endif
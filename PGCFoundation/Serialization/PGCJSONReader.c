@@ -0,0 +1,998 @@
+//
+//  PGCJSONReader.c
+//  PGCFoundation
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <PGCFoundation/PGCJSONReader.h>
+
+#include <PGCFoundation/PGCArray.h>
+#include <PGCFoundation/PGCBoolean.h>
+#include <PGCFoundation/PGCDecimal.h>
+#include <PGCFoundation/PGCDictionary.h>
+#include <PGCFoundation/PGCInteger.h>
+#include <PGCFoundation/PGCNull.h>
+#include <PGCFoundation/PGCString.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+// The reader is a push parser. Input can be fed to it in chunks of any size, and it tokenizes as much of the input as it can,
+// invoking a callback for each token. A token that is split across chunks is kept in the reader’s buffer until the rest of it
+// arrives, so the memory used while reading is proportional to the largest token rather than the size of the document. When
+// no callbacks are specified, the reader uses its own callbacks to build PGCFoundation objects.
+enum {
+    PGCJSONReaderStateValue,
+    PGCJSONReaderStateArrayValueOrEnd,
+    PGCJSONReaderStateArrayCommaOrEnd,
+    PGCJSONReaderStateObjectKeyOrEnd,
+    PGCJSONReaderStateObjectKey,
+    PGCJSONReaderStateObjectColon,
+    PGCJSONReaderStateObjectCommaOrEnd,
+    PGCJSONReaderStateDone
+};
+
+
+enum {
+    PGCJSONReaderResultFailed,
+    PGCJSONReaderResultSucceeded,
+    PGCJSONReaderResultNeedsMoreInput
+};
+
+
+typedef struct _PGCJSONReaderInternedKey {
+    uint64_t hash;
+    PGCString *key;
+} PGCJSONReaderInternedKey;
+
+
+struct _PGCJSONReader {
+    PGCObject super;
+    PGCJSONReaderCallbacks callbacks;
+    void *context;
+    
+    // Bytes before position have already been tokenized. The rest begin with the next token.
+    uint8_t *buffer;
+    uint64_t length;
+    uint64_t capacity;
+    uint64_t position;
+    uint64_t discardedLength;
+    
+    uint64_t state;
+    uint64_t depth;
+    bool *containerIsObject;
+    
+    // A string that is split across chunks resumes scanning at stringResumeOffset bytes past its opening quote. If the string
+    // has escape sequences, the unescaped characters before that point are in scratch.
+    uint64_t stringResumeOffset;
+    bool stringHasEscapes;
+    char *scratch;
+    uint64_t scratchLength;
+    uint64_t scratchCapacity;
+    
+    bool hasFailed;
+    bool isFinished;
+    
+    // Object building state. Values are kept on a stack until their container ends, at which point the container is created
+    // with exactly the right capacity. Keys are interned so that repeated keys share a single string.
+    PGCType *values;
+    uint64_t valueCount;
+    uint64_t valueCapacity;
+    uint64_t *containerStarts;
+    PGCJSONReaderInternedKey *internedKeys;
+    uint64_t internedKeyCount;
+    uint64_t internedKeyCapacity;
+    PGCType rootObject;
+};
+
+
+#pragma mark Private Global Constants
+
+static const uint64_t PGCJSONReaderMaximumDepth = 1024;
+static const uint64_t PGCJSONReaderInitialCapacity = 65536;
+static const uint64_t PGCJSONReaderFileChunkLength = 65536;
+static const uint64_t PGCJSONReaderMaximumInternedKeyCount = 4096;
+static const double PGCJSONReaderPowersOf10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 
+                                                  1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+
+#pragma mark Private Function Interfaces
+
+void PGCJSONReaderDealloc(PGCType instance);
+bool PGCJSONReaderReserveCapacity(PGCJSONReader *reader, uint64_t length);
+bool PGCJSONReaderTokenize(PGCJSONReader *reader, bool isFinal);
+uint64_t PGCJSONReaderReadValue(PGCJSONReader *reader, bool isFinal);
+uint64_t PGCJSONReaderReadKey(PGCJSONReader *reader);
+uint64_t PGCJSONReaderBeginContainer(PGCJSONReader *reader, bool isObject);
+uint64_t PGCJSONReaderEndContainer(PGCJSONReader *reader, bool isObject);
+void PGCJSONReaderCompleteValue(PGCJSONReader *reader);
+uint64_t PGCJSONReaderReadString(PGCJSONReader *reader, const char **string, uint64_t *length);
+uint64_t PGCJSONReaderReadEscapeSequence(PGCJSONReader *reader, uint64_t index, uint64_t *escapeLength);
+uint64_t PGCJSONReaderReadLiteral(PGCJSONReader *reader);
+uint64_t PGCJSONReaderReadNumber(PGCJSONReader *reader, bool isFinal);
+bool PGCJSONReaderAppendToScratch(PGCJSONReader *reader, const void *bytes, uint64_t length);
+int64_t PGCJSONReaderGetHexValue(const uint8_t *bytes);
+uint64_t PGCJSONReaderSkipWhitespace(const uint8_t *bytes, uint64_t position, uint64_t end);
+uint64_t PGCJSONReaderScanString(const uint8_t *bytes, uint64_t length);
+
+bool PGCJSONReaderBuildContainer(void *context);
+bool PGCJSONReaderBuildArray(void *context);
+bool PGCJSONReaderBuildObject(void *context);
+bool PGCJSONReaderBuildKey(void *context, const char *key, uint64_t length);
+bool PGCJSONReaderBuildString(void *context, const char *string, uint64_t length);
+bool PGCJSONReaderBuildSignedInteger(void *context, int64_t value);
+bool PGCJSONReaderBuildUnsignedInteger(void *context, uint64_t value);
+bool PGCJSONReaderBuildDecimal(void *context, double value);
+bool PGCJSONReaderBuildBoolean(void *context, bool value);
+bool PGCJSONReaderBuildNull(void *context);
+bool PGCJSONReaderBuildPushValue(PGCJSONReader *reader, PGCType value);
+
+
+#pragma mark -
+
+PGCClass *PGCJSONReaderClass(void)
+{
+    static PGCClass *readerClass = NULL;
+    if (!readerClass) {
+        PGCClassFunctions functions = { NULL, PGCJSONReaderDealloc, NULL, NULL, NULL, NULL, NULL };
+        readerClass = PGCClassCreate("PGCJSONReader", PGCObjectClass(), functions, sizeof(PGCJSONReader));
+    }
+    return readerClass;
+}
+
+
+PGCJSONReader *PGCJSONReaderInstance(void)
+{
+    return PGCAutorelease(PGCJSONReaderInit(NULL));
+}
+
+
+PGCJSONReader *PGCJSONReaderInstanceWithCallbacks(PGCJSONReaderCallbacks callbacks, void *context)
+{
+    return PGCAutorelease(PGCJSONReaderInitWithCallbacks(NULL, callbacks, context));
+}
+
+
+PGCType PGCJSONReaderObjectWithBytes(const void *bytes, uint64_t length)
+{
+    PGCJSONReader *reader = PGCJSONReaderInit(NULL);
+    PGCType object = NULL;
+    if (PGCJSONReaderReadBytes(reader, bytes, length) && PGCJSONReaderFinish(reader)) {
+        object = PGCAutorelease(PGCRetain(PGCJSONReaderGetRootObject(reader)));
+    }
+    
+    PGCRelease(reader);
+    return object;
+}
+
+
+PGCType PGCJSONReaderObjectWithCString(const char *cString)
+{
+    return cString ? PGCJSONReaderObjectWithBytes(cString, strlen(cString)) : NULL;
+}
+
+
+#pragma mark Basic Functions
+
+PGCJSONReader *PGCJSONReaderInit(PGCJSONReader *reader)
+{
+    PGCJSONReaderCallbacks callbacks = { PGCJSONReaderBuildContainer, PGCJSONReaderBuildArray, PGCJSONReaderBuildContainer,
+                                         PGCJSONReaderBuildObject, PGCJSONReaderBuildKey, PGCJSONReaderBuildString, 
+                                         PGCJSONReaderBuildSignedInteger, PGCJSONReaderBuildUnsignedInteger, 
+                                         PGCJSONReaderBuildDecimal, PGCJSONReaderBuildBoolean, PGCJSONReaderBuildNull };
+    reader = PGCJSONReaderInitWithCallbacks(reader, callbacks, NULL);
+    if (!reader) return NULL;
+    
+    reader->context = reader;
+    reader->containerStarts = malloc(PGCJSONReaderMaximumDepth * sizeof(uint64_t));
+    if (!reader->containerStarts) {
+        PGCRelease(reader);
+        return NULL;
+    }
+    
+    return reader;
+}
+
+
+PGCJSONReader *PGCJSONReaderInitWithCallbacks(PGCJSONReader *reader, PGCJSONReaderCallbacks callbacks, void *context)
+{
+    if (!reader && (reader = PGCAlloc(PGCJSONReaderClass())) == NULL) return NULL;
+    PGCObjectInit(&reader->super);
+    
+    reader->callbacks = callbacks;
+    reader->context = context;
+    reader->state = PGCJSONReaderStateValue;
+    
+    reader->containerIsObject = malloc(PGCJSONReaderMaximumDepth * sizeof(bool));
+    if (!reader->containerIsObject) {
+        PGCRelease(reader);
+        return NULL;
+    }
+    
+    return reader;
+}
+
+
+void PGCJSONReaderDealloc(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCJSONReaderClass())) return;
+    PGCJSONReader *reader = instance;
+    
+    free(reader->buffer);
+    free(reader->containerIsObject);
+    free(reader->scratch);
+    
+    for (uint64_t i = 0; i < reader->valueCount; i++) PGCRelease(reader->values[i]);
+    free(reader->values);
+    free(reader->containerStarts);
+    
+    for (uint64_t i = 0; i < reader->internedKeyCapacity; i++) PGCRelease(reader->internedKeys[i].key);
+    free(reader->internedKeys);
+    PGCRelease(reader->rootObject);
+    
+    PGCSuperclassDealloc(reader);
+}
+
+
+#pragma mark Reading
+
+bool PGCJSONReaderReadBytes(PGCJSONReader *reader, const void *bytes, uint64_t length)
+{
+    if (!reader || reader->hasFailed || reader->isFinished) return false;
+    if (length == 0) return true;
+    if (!bytes || !PGCJSONReaderReserveCapacity(reader, length)) {
+        reader->hasFailed = true;
+        return false;
+    }
+    
+    memcpy(reader->buffer + reader->length, bytes, length);
+    reader->length += length;
+    return PGCJSONReaderTokenize(reader, false);
+}
+
+
+bool PGCJSONReaderReadFile(PGCJSONReader *reader, FILE *file)
+{
+    if (!reader || reader->hasFailed || reader->isFinished) return false;
+    if (!file) {
+        reader->hasFailed = true;
+        return false;
+    }
+    
+    // Read directly into our buffer to avoid copying each chunk
+    while (!feof(file)) {
+        if (!PGCJSONReaderReserveCapacity(reader, PGCJSONReaderFileChunkLength)) {
+            reader->hasFailed = true;
+            return false;
+        }
+        
+        size_t readLength = fread(reader->buffer + reader->length, 1, PGCJSONReaderFileChunkLength, file);
+        if (ferror(file)) {
+            reader->hasFailed = true;
+            return false;
+        }
+        
+        reader->length += readLength;
+        if (readLength > 0 && !PGCJSONReaderTokenize(reader, false)) return false;
+    }
+    
+    return true;
+}
+
+
+bool PGCJSONReaderFinish(PGCJSONReader *reader)
+{
+    if (!reader || reader->hasFailed) return false;
+    if (reader->isFinished) return true;
+    
+    reader->isFinished = true;
+    if (!PGCJSONReaderTokenize(reader, true)) return false;
+    
+    // Anything left over is an incomplete token
+    if (reader->state != PGCJSONReaderStateDone || reader->position != reader->length) {
+        reader->hasFailed = true;
+        return false;
+    }
+    
+    return true;
+}
+
+
+#pragma mark Accessors
+
+PGCType PGCJSONReaderGetRootObject(PGCJSONReader *reader)
+{
+    return reader && reader->isFinished && !reader->hasFailed ? reader->rootObject : NULL;
+}
+
+
+bool PGCJSONReaderHasFailed(PGCJSONReader *reader)
+{
+    return reader ? reader->hasFailed : true;
+}
+
+
+uint64_t PGCJSONReaderGetOffset(PGCJSONReader *reader)
+{
+    return reader ? reader->discardedLength + reader->position : 0;
+}
+
+
+#pragma mark Private Functions
+
+bool PGCJSONReaderReserveCapacity(PGCJSONReader *reader, uint64_t length)
+{
+    // Move the unconsumed bytes to the front of the buffer. This is usually no more than a partial token.
+    if (reader->position > 0) {
+        reader->length -= reader->position;
+        memmove(reader->buffer, reader->buffer + reader->position, reader->length);
+        reader->discardedLength += reader->position;
+        reader->position = 0;
+    }
+    
+    if (reader->capacity - reader->length >= length) return true;
+    
+    uint64_t capacity = reader->capacity ? reader->capacity : PGCJSONReaderInitialCapacity;
+    while (capacity - reader->length < length) capacity *= 2;
+    
+    uint8_t *buffer = realloc(reader->buffer, capacity);
+    if (!buffer) return false;
+    
+    reader->buffer = buffer;
+    reader->capacity = capacity;
+    return true;
+}
+
+
+bool PGCJSONReaderTokenize(PGCJSONReader *reader, bool isFinal)
+{
+    while (!reader->hasFailed) {
+        reader->position = PGCJSONReaderSkipWhitespace(reader->buffer, reader->position, reader->length);
+        if (reader->position == reader->length) return true;
+        
+        uint64_t tokenStart = reader->position;
+        uint8_t character = reader->buffer[reader->position];
+        uint64_t result = PGCJSONReaderResultFailed;
+        switch (reader->state) {
+            case PGCJSONReaderStateValue:
+                result = PGCJSONReaderReadValue(reader, isFinal);
+                break;
+            case PGCJSONReaderStateArrayValueOrEnd:
+                result = character == ']' ? PGCJSONReaderEndContainer(reader, false) : PGCJSONReaderReadValue(reader, isFinal);
+                break;
+            case PGCJSONReaderStateArrayCommaOrEnd:
+                if (character == ',') {
+                    reader->state = PGCJSONReaderStateValue;
+                    reader->position++;
+                    result = PGCJSONReaderResultSucceeded;
+                } else if (character == ']') {
+                    result = PGCJSONReaderEndContainer(reader, false);
+                }
+                break;
+            case PGCJSONReaderStateObjectKeyOrEnd:
+                result = character == '}' ? PGCJSONReaderEndContainer(reader, true) : PGCJSONReaderReadKey(reader);
+                break;
+            case PGCJSONReaderStateObjectKey:
+                result = PGCJSONReaderReadKey(reader);
+                break;
+            case PGCJSONReaderStateObjectColon:
+                if (character == ':') {
+                    reader->state = PGCJSONReaderStateValue;
+                    reader->position++;
+                    result = PGCJSONReaderResultSucceeded;
+                }
+                break;
+            case PGCJSONReaderStateObjectCommaOrEnd:
+                if (character == ',') {
+                    reader->state = PGCJSONReaderStateObjectKey;
+                    reader->position++;
+                    result = PGCJSONReaderResultSucceeded;
+                } else if (character == '}') {
+                    result = PGCJSONReaderEndContainer(reader, true);
+                }
+                break;
+        }
+        
+        if (result == PGCJSONReaderResultNeedsMoreInput && !isFinal) return true;
+        if (result != PGCJSONReaderResultSucceeded) {
+            // Leave the offset at the start of the offending token
+            reader->position = tokenStart;
+            reader->hasFailed = true;
+        }
+    }
+    
+    return false;
+}
+
+
+uint64_t PGCJSONReaderReadValue(PGCJSONReader *reader, bool isFinal)
+{
+    uint8_t character = reader->buffer[reader->position];
+    switch (character) {
+        case '{':
+            return PGCJSONReaderBeginContainer(reader, true);
+        case '[':
+            return PGCJSONReaderBeginContainer(reader, false);
+        case '"': {
+            const char *string = NULL;
+            uint64_t length = 0;
+            uint64_t result = PGCJSONReaderReadString(reader, &string, &length);
+            if (result != PGCJSONReaderResultSucceeded) return result;
+            if (reader->callbacks.string && !reader->callbacks.string(reader->context, string, length)) return PGCJSONReaderResultFailed;
+            PGCJSONReaderCompleteValue(reader);
+            return PGCJSONReaderResultSucceeded;
+        }
+        case 't':
+        case 'f':
+        case 'n':
+            return PGCJSONReaderReadLiteral(reader);
+        default:
+            if (character == '-' || (character >= '0' && character <= '9')) return PGCJSONReaderReadNumber(reader, isFinal);
+            return PGCJSONReaderResultFailed;
+    }
+}
+
+
+uint64_t PGCJSONReaderReadKey(PGCJSONReader *reader)
+{
+    if (reader->buffer[reader->position] != '"') return PGCJSONReaderResultFailed;
+    
+    const char *key = NULL;
+    uint64_t length = 0;
+    uint64_t result = PGCJSONReaderReadString(reader, &key, &length);
+    if (result != PGCJSONReaderResultSucceeded) return result;
+    if (reader->callbacks.key && !reader->callbacks.key(reader->context, key, length)) return PGCJSONReaderResultFailed;
+    
+    reader->state = PGCJSONReaderStateObjectColon;
+    return PGCJSONReaderResultSucceeded;
+}
+
+
+uint64_t PGCJSONReaderBeginContainer(PGCJSONReader *reader, bool isObject)
+{
+    if (reader->depth == PGCJSONReaderMaximumDepth) return PGCJSONReaderResultFailed;
+    
+    reader->containerIsObject[reader->depth++] = isObject;
+    reader->position++;
+    reader->state = isObject ? PGCJSONReaderStateObjectKeyOrEnd : PGCJSONReaderStateArrayValueOrEnd;
+    
+    bool (*callback)(void *) = isObject ? reader->callbacks.beginObject : reader->callbacks.beginArray;
+    return !callback || callback(reader->context) ? PGCJSONReaderResultSucceeded : PGCJSONReaderResultFailed;
+}
+
+
+uint64_t PGCJSONReaderEndContainer(PGCJSONReader *reader, bool isObject)
+{
+    reader->depth--;
+    reader->position++;
+    
+    bool (*callback)(void *) = isObject ? reader->callbacks.endObject : reader->callbacks.endArray;
+    if (callback && !callback(reader->context)) return PGCJSONReaderResultFailed;
+    
+    PGCJSONReaderCompleteValue(reader);
+    return PGCJSONReaderResultSucceeded;
+}
+
+
+void PGCJSONReaderCompleteValue(PGCJSONReader *reader)
+{
+    if (reader->depth == 0) {
+        reader->state = PGCJSONReaderStateDone;
+    } else {
+        reader->state = reader->containerIsObject[reader->depth - 1] ? PGCJSONReaderStateObjectCommaOrEnd : PGCJSONReaderStateArrayCommaOrEnd;
+    }
+}
+
+
+uint64_t PGCJSONReaderReadString(PGCJSONReader *reader, const char **string, uint64_t *length)
+{
+    uint64_t start = reader->position;
+    uint64_t index = start + (reader->stringResumeOffset ? reader->stringResumeOffset : 1);
+    if (!reader->stringResumeOffset) {
+        reader->stringHasEscapes = false;
+        reader->scratchLength = 0;
+    }
+    
+    while (true) {
+        uint64_t plainLength = PGCJSONReaderScanString(reader->buffer + index, reader->length - index);
+        if (reader->stringHasEscapes && !PGCJSONReaderAppendToScratch(reader, reader->buffer + index, plainLength)) {
+            return PGCJSONReaderResultFailed;
+        }
+        
+        index += plainLength;
+        if (index == reader->length) {
+            reader->stringResumeOffset = index - start;
+            return PGCJSONReaderResultNeedsMoreInput;
+        }
+        
+        uint8_t character = reader->buffer[index];
+        if (character == '"') break;
+        if (character < 0x20) return PGCJSONReaderResultFailed;
+        
+        // We have a backslash. From here on, the string is built in scratch.
+        if (!reader->stringHasEscapes) {
+            reader->stringHasEscapes = true;
+            if (!PGCJSONReaderAppendToScratch(reader, reader->buffer + start + 1, index - start - 1)) return PGCJSONReaderResultFailed;
+        }
+        
+        uint64_t escapeLength = 0;
+        uint64_t result = PGCJSONReaderReadEscapeSequence(reader, index, &escapeLength);
+        if (result == PGCJSONReaderResultNeedsMoreInput) reader->stringResumeOffset = index - start;
+        if (result != PGCJSONReaderResultSucceeded) return result;
+        index += escapeLength;
+    }
+    
+    // Strings without escapes are passed to callbacks in place, with a NUL written over their closing quote
+    if (reader->stringHasEscapes) {
+        if (!PGCJSONReaderAppendToScratch(reader, "", 1)) return PGCJSONReaderResultFailed;
+        *string = reader->scratch;
+        *length = reader->scratchLength - 1;
+    } else {
+        reader->buffer[index] = '\0';
+        *string = (const char *)reader->buffer + start + 1;
+        *length = index - start - 1;
+    }
+    
+    reader->stringResumeOffset = 0;
+    reader->position = index + 1;
+    return PGCJSONReaderResultSucceeded;
+}
+
+
+uint64_t PGCJSONReaderReadEscapeSequence(PGCJSONReader *reader, uint64_t index, uint64_t *escapeLength)
+{
+    const uint8_t *bytes = reader->buffer + index;
+    uint64_t availableLength = reader->length - index;
+    if (availableLength < 2) return PGCJSONReaderResultNeedsMoreInput;
+    
+    char character = '\0';
+    switch (bytes[1]) {
+        case '"': character = '"'; break;
+        case '\\': character = '\\'; break;
+        case '/': character = '/'; break;
+        case 'b': character = '\b'; break;
+        case 'f': character = '\f'; break;
+        case 'n': character = '\n'; break;
+        case 'r': character = '\r'; break;
+        case 't': character = '\t'; break;
+        case 'u': break;
+        default: return PGCJSONReaderResultFailed;
+    }
+    
+    if (character) {
+        *escapeLength = 2;
+        return PGCJSONReaderAppendToScratch(reader, &character, 1) ? PGCJSONReaderResultSucceeded : PGCJSONReaderResultFailed;
+    }
+    
+    if (availableLength < 6) return PGCJSONReaderResultNeedsMoreInput;
+    int64_t codePoint = PGCJSONReaderGetHexValue(bytes + 2);
+    *escapeLength = 6;
+    
+    // Characters outside the Basic Multilingual Plane are escaped as a UTF-16 surrogate pair. PGCStrings are C strings, so they
+    // can’t contain NUL characters.
+    if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+        if (availableLength < 12) return PGCJSONReaderResultNeedsMoreInput;
+        if (bytes[6] != '\\' || bytes[7] != 'u') return PGCJSONReaderResultFailed;
+        
+        int64_t lowSurrogate = PGCJSONReaderGetHexValue(bytes + 8);
+        if (lowSurrogate < 0xDC00 || lowSurrogate > 0xDFFF) return PGCJSONReaderResultFailed;
+        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+        *escapeLength = 12;
+    } else if (codePoint <= 0 || (codePoint >= 0xDC00 && codePoint <= 0xDFFF)) {
+        return PGCJSONReaderResultFailed;
+    }
+    
+    uint8_t utf8[4];
+    uint64_t utf8Length = 0;
+    if (codePoint < 0x80) {
+        utf8[utf8Length++] = (uint8_t)codePoint;
+    } else if (codePoint < 0x800) {
+        utf8[utf8Length++] = (uint8_t)(0xC0 | (codePoint >> 6));
+        utf8[utf8Length++] = (uint8_t)(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        utf8[utf8Length++] = (uint8_t)(0xE0 | (codePoint >> 12));
+        utf8[utf8Length++] = (uint8_t)(0x80 | ((codePoint >> 6) & 0x3F));
+        utf8[utf8Length++] = (uint8_t)(0x80 | (codePoint & 0x3F));
+    } else {
+        utf8[utf8Length++] = (uint8_t)(0xF0 | (codePoint >> 18));
+        utf8[utf8Length++] = (uint8_t)(0x80 | ((codePoint >> 12) & 0x3F));
+        utf8[utf8Length++] = (uint8_t)(0x80 | ((codePoint >> 6) & 0x3F));
+        utf8[utf8Length++] = (uint8_t)(0x80 | (codePoint & 0x3F));
+    }
+    
+    return PGCJSONReaderAppendToScratch(reader, utf8, utf8Length) ? PGCJSONReaderResultSucceeded : PGCJSONReaderResultFailed;
+}
+
+
+uint64_t PGCJSONReaderReadLiteral(PGCJSONReader *reader)
+{
+    const uint8_t *bytes = reader->buffer + reader->position;
+    const char *literal = bytes[0] == 't' ? "true" : (bytes[0] == 'f' ? "false" : "null");
+    uint64_t literalLength = strlen(literal);
+    uint64_t availableLength = reader->length - reader->position;
+    
+    if (memcmp(bytes, literal, availableLength < literalLength ? availableLength : literalLength) != 0) return PGCJSONReaderResultFailed;
+    if (availableLength < literalLength) return PGCJSONReaderResultNeedsMoreInput;
+    reader->position += literalLength;
+    
+    bool succeeded = true;
+    if (bytes[0] == 'n') {
+        succeeded = !reader->callbacks.null || reader->callbacks.null(reader->context);
+    } else {
+        succeeded = !reader->callbacks.boolean || reader->callbacks.boolean(reader->context, bytes[0] == 't');
+    }
+    
+    if (!succeeded) return PGCJSONReaderResultFailed;
+    PGCJSONReaderCompleteValue(reader);
+    return PGCJSONReaderResultSucceeded;
+}
+
+
+uint64_t PGCJSONReaderReadNumber(PGCJSONReader *reader, bool isFinal)
+{
+    // Find the end of the number. Unless this is the last of the input, a number that runs to the end of the buffer may continue
+    // in the next chunk.
+    uint64_t end = reader->position;
+    while (end < reader->length) {
+        uint8_t character = reader->buffer[end];
+        if ((character < '0' || character > '9') && character != '-' && character != '+' && character != '.' && (character | 0x20) != 'e') {
+            break;
+        }
+        end++;
+    }
+
+    if (end == reader->length && !isFinal) return PGCJSONReaderResultNeedsMoreInput;
+    
+    const uint8_t *bytes = reader->buffer + reader->position;
+    const uint8_t *numberEnd = reader->buffer + end;
+    
+    bool isNegative = *bytes == '-';
+    if (isNegative) bytes++;
+    if (bytes == numberEnd || *bytes < '0' || *bytes > '9') return PGCJSONReaderResultFailed;
+    
+    // Accumulate up to 19 significant digits in mantissa and track the decimal exponent. Any digits beyond that only matter 
+    // to strtod.
+    uint64_t mantissa = 0;
+    int64_t exponent = 0;
+    bool isTruncated = false;
+    bool isInteger = true;
+    
+    if (*bytes == '0') {
+        bytes++;
+    } else {
+        for (; bytes < numberEnd && *bytes >= '0' && *bytes <= '9'; bytes++) {
+            if (mantissa < 1844674407370955161ULL || (mantissa == 1844674407370955161ULL && *bytes <= '5')) {
+                mantissa = mantissa * 10 + (*bytes - '0');
+            } else {
+                isTruncated = true;
+                exponent++;
+            }
+        }
+    }
+    
+    if (bytes < numberEnd && *bytes == '.') {
+        isInteger = false;
+        bytes++;
+        if (bytes == numberEnd || *bytes < '0' || *bytes > '9') return PGCJSONReaderResultFailed;
+        for (; bytes < numberEnd && *bytes >= '0' && *bytes <= '9'; bytes++) {
+            if (mantissa < 1844674407370955161ULL) {
+                mantissa = mantissa * 10 + (*bytes - '0');
+                exponent--;
+            } else {
+                isTruncated = true;
+            }
+        }
+    }
+    
+    if (bytes < numberEnd && (*bytes == 'e' || *bytes == 'E')) {
+        isInteger = false;
+        bytes++;
+        bool exponentIsNegative = bytes < numberEnd && *bytes == '-';
+        if (bytes < numberEnd && (*bytes == '-' || *bytes == '+')) bytes++;
+        if (bytes == numberEnd || *bytes < '0' || *bytes > '9') return PGCJSONReaderResultFailed;
+        
+        int64_t explicitExponent = 0;
+        for (; bytes < numberEnd && *bytes >= '0' && *bytes <= '9'; bytes++) {
+            if (explicitExponent < 100000) explicitExponent = explicitExponent * 10 + (*bytes - '0');
+        }
+        
+        exponent += exponentIsNegative ? -explicitExponent : explicitExponent;
+    }
+    
+    if (bytes != numberEnd) return PGCJSONReaderResultFailed;
+    
+    bool succeeded = true;
+    if (isInteger && !isTruncated && (!isNegative || mantissa <= (uint64_t)INT64_MAX + 1)) {
+        if (isNegative || mantissa <= INT64_MAX) {
+            int64_t value = isNegative ? (int64_t)(0 - mantissa) : (int64_t)mantissa;
+            succeeded = !reader->callbacks.signedInteger || reader->callbacks.signedInteger(reader->context, value);
+        } else {
+            succeeded = !reader->callbacks.unsignedInteger || reader->callbacks.unsignedInteger(reader->context, mantissa);
+        }
+    } else {
+        // When the mantissa and the power of 10 are both exactly representable, a single multiplication or division gives a 
+        // correctly rounded result. Otherwise, fall back to strtod.
+        double value = 0.0;
+        if (!isTruncated && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+            value = exponent < 0 ? mantissa / PGCJSONReaderPowersOf10[-exponent] : mantissa * PGCJSONReaderPowersOf10[exponent];
+            if (isNegative) value = -value;
+        } else {
+            reader->scratchLength = 0;
+            if (!PGCJSONReaderAppendToScratch(reader, reader->buffer + reader->position, end - reader->position) ||
+                !PGCJSONReaderAppendToScratch(reader, "", 1)) {
+                return PGCJSONReaderResultFailed;
+            }
+            
+            value = strtod(reader->scratch, NULL);
+        }
+        
+        succeeded = !reader->callbacks.decimal || reader->callbacks.decimal(reader->context, value);
+    }
+    
+    if (!succeeded) return PGCJSONReaderResultFailed;
+    reader->position = end;
+    PGCJSONReaderCompleteValue(reader);
+    return PGCJSONReaderResultSucceeded;
+}
+
+
+bool PGCJSONReaderAppendToScratch(PGCJSONReader *reader, const void *bytes, uint64_t length)
+{
+    if (reader->scratchCapacity - reader->scratchLength < length) {
+        uint64_t capacity = reader->scratchCapacity ? reader->scratchCapacity : 256;
+        while (capacity - reader->scratchLength < length) capacity *= 2;
+        
+        char *scratch = realloc(reader->scratch, capacity);
+        if (!scratch) return false;
+        
+        reader->scratch = scratch;
+        reader->scratchCapacity = capacity;
+    }
+    
+    if (length > 0) memcpy(reader->scratch + reader->scratchLength, bytes, length);
+    reader->scratchLength += length;
+    return true;
+}
+
+
+int64_t PGCJSONReaderGetHexValue(const uint8_t *bytes)
+{
+    int64_t value = 0;
+    for (uint64_t i = 0; i < 4; i++) {
+        uint8_t character = bytes[i];
+        int64_t digit = -1;
+        if (character >= '0' && character <= '9') digit = character - '0';
+        else if (character >= 'a' && character <= 'f') digit = character - 'a' + 10;
+        else if (character >= 'A' && character <= 'F') digit = character - 'A' + 10;
+        
+        if (digit < 0) return -1;
+        value = value * 16 + digit;
+    }
+    
+    return value;
+}
+
+
+uint64_t PGCJSONReaderSkipWhitespace(const uint8_t *bytes, uint64_t position, uint64_t end)
+{
+    // Minified JSON has no whitespace between tokens, so check the first byte before doing anything more expensive
+    if (position == end || (bytes[position] != ' ' && bytes[position] != '\n' && bytes[position] != '\t' && bytes[position] != '\r')) {
+        return position;
+    }
+    
+#if defined(__x86_64__)
+    // Indentation in pretty-printed JSON can be long, so check 16 bytes at a time
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i carriageReturn = _mm_set1_epi8('\r');
+    for (; position + 16 <= end; position += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(bytes + position));
+        __m128i whitespace = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, newline)),
+                                          _mm_or_si128(_mm_cmpeq_epi8(chunk, tab), _mm_cmpeq_epi8(chunk, carriageReturn)));
+        int mask = ~_mm_movemask_epi8(whitespace) & 0xFFFF;
+        if (mask) return position + __builtin_ctz(mask);
+    }
+#endif
+    
+    while (position < end && (bytes[position] == ' ' || bytes[position] == '\n' || bytes[position] == '\t' || bytes[position] == '\r')) {
+        position++;
+    }
+    
+    return position;
+}
+
+
+uint64_t PGCJSONReaderScanString(const uint8_t *bytes, uint64_t length)
+{
+    // Returns the number of bytes before the first quote, backslash, or control character. Everything else in a string is 
+    // copied verbatim.
+    uint64_t i = 0;
+#if defined(__x86_64__)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i lastControlCharacter = _mm_set1_epi8(0x1F);
+    for (; i + 16 <= length; i += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(bytes + i));
+        
+        // SSE2 has no unsigned byte comparison, but a byte is at most 0x1F exactly when max(byte, 0x1F) is 0x1F
+        __m128i isControlCharacter = _mm_cmpeq_epi8(_mm_max_epu8(chunk, lastControlCharacter), lastControlCharacter);
+        __m128i isSpecial = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)), isControlCharacter);
+        int mask = _mm_movemask_epi8(isSpecial);
+        if (mask) return i + __builtin_ctz(mask);
+    }
+#endif
+    
+    while (i < length && bytes[i] != '"' && bytes[i] != '\\' && bytes[i] >= 0x20) i++;
+    return i;
+}
+
+
+#pragma mark Object Building
+
+bool PGCJSONReaderBuildContainer(void *context)
+{
+    PGCJSONReader *reader = context;
+    reader->containerStarts[reader->depth - 1] = reader->valueCount;
+    return true;
+}
+
+
+bool PGCJSONReaderBuildArray(void *context)
+{
+    // The reader has already popped the array, so its start is just past the top of the container stack
+    PGCJSONReader *reader = context;
+    uint64_t start = reader->containerStarts[reader->depth];
+    uint64_t count = reader->valueCount - start;
+    
+    PGCArray *array = PGCArrayInitWithInitialCapacity(NULL, count);
+    if (!array) return false;
+    
+    for (uint64_t i = start; i < reader->valueCount; i++) {
+        PGCArrayAddObject(array, reader->values[i]);
+        PGCRelease(reader->values[i]);
+    }
+    
+    reader->valueCount = start;
+    return PGCJSONReaderBuildPushValue(reader, array);
+}
+
+
+bool PGCJSONReaderBuildObject(void *context)
+{
+    PGCJSONReader *reader = context;
+    uint64_t start = reader->containerStarts[reader->depth];
+    
+    PGCDictionary *dictionary = PGCDictionaryInit(NULL);
+    if (!dictionary) return false;
+    
+    // Values alternate between keys and objects
+    for (uint64_t i = start; i < reader->valueCount; i += 2) {
+        PGCDictionarySetObjectForKey(dictionary, reader->values[i + 1], reader->values[i]);
+        PGCRelease(reader->values[i]);
+        PGCRelease(reader->values[i + 1]);
+    }
+    
+    reader->valueCount = start;
+    return PGCJSONReaderBuildPushValue(reader, dictionary);
+}
+
+
+bool PGCJSONReaderBuildKey(void *context, const char *key, uint64_t length)
+{
+    PGCJSONReader *reader = context;
+    
+    if (!reader->internedKeys) {
+        reader->internedKeys = calloc(PGCJSONReaderMaximumInternedKeyCount * 2, sizeof(PGCJSONReaderInternedKey));
+        if (!reader->internedKeys) return false;
+        reader->internedKeyCapacity = PGCJSONReaderMaximumInternedKeyCount * 2;
+    }
+    
+    // The table is never more than half full, so there is always an empty slot to end the probe sequence
+    uint64_t hash = PGCHashBytes(key, length);
+    uint64_t mask = reader->internedKeyCapacity - 1;
+    uint64_t slot = hash & mask;
+    for (; reader->internedKeys[slot].key; slot = (slot + 1) & mask) {
+        PGCJSONReaderInternedKey *internedKey = &reader->internedKeys[slot];
+        if (internedKey->hash == hash && PGCStringGetLength(internedKey->key) == length && 
+            memcmp(PGCStringGetCString(internedKey->key), key, length) == 0) {
+            return PGCJSONReaderBuildPushValue(reader, PGCRetain(internedKey->key));
+        }
+    }
+    
+    PGCString *string = PGCStringInitWithCString(NULL, key);
+    if (string && reader->internedKeyCount < PGCJSONReaderMaximumInternedKeyCount) {
+        reader->internedKeys[slot].hash = hash;
+        reader->internedKeys[slot].key = PGCRetain(string);
+        reader->internedKeyCount++;
+    }
+    
+    return PGCJSONReaderBuildPushValue(reader, string);
+}
+
+
+bool PGCJSONReaderBuildString(void *context, const char *string, uint64_t length)
+{
+    return PGCJSONReaderBuildPushValue(context, PGCStringInitWithCString(NULL, string));
+}
+
+
+bool PGCJSONReaderBuildSignedInteger(void *context, int64_t value)
+{
+    return PGCJSONReaderBuildPushValue(context, PGCIntegerInitWithSignedValue(NULL, value));
+}
+
+
+bool PGCJSONReaderBuildUnsignedInteger(void *context, uint64_t value)
+{
+    return PGCJSONReaderBuildPushValue(context, PGCIntegerInitWithUnsignedValue(NULL, value));
+}
+
+
+bool PGCJSONReaderBuildDecimal(void *context, double value)
+{
+    return PGCJSONReaderBuildPushValue(context, PGCDecimalInitWithValue(NULL, value));
+}
+
+
+bool PGCJSONReaderBuildBoolean(void *context, bool value)
+{
+    return PGCJSONReaderBuildPushValue(context, PGCRetain(value ? PGCBooleanTrue() : PGCBooleanFalse()));
+}
+
+
+bool PGCJSONReaderBuildNull(void *context)
+{
+    return PGCJSONReaderBuildPushValue(context, PGCRetain(PGCNullInstance()));
+}
+
+
+bool PGCJSONReaderBuildPushValue(PGCJSONReader *reader, PGCType value)
+{
+    // Takes ownership of value
+    if (!value) return false;
+    
+    if (reader->depth == 0) {
+        reader->rootObject = value;
+        return true;
+    }
+    
+    if (reader->valueCount == reader->valueCapacity) {
+        uint64_t capacity = reader->valueCapacity ? reader->valueCapacity * 2 : 256;
+        PGCType *values = realloc(reader->values, capacity * sizeof(PGCType));
+        if (!values) {
+            PGCRelease(value);
+            return false;
+        }
+        
+        reader->values = values;
+        reader->valueCapacity = capacity;
+    }
+    
+    reader->values[reader->valueCount++] = value;
+    return true;
+}
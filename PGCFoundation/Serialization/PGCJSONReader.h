@@ -0,0 +1,75 @@
+//
+//  PGCJSONReader.h
+//  PGCFoundation
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef PGCJSONREADER_H
+#define PGCJSONREADER_H
+
+#include <PGCFoundation/PGCObject.h>
+
+#include <stdio.h>
+
+typedef struct _PGCJSONReader PGCJSONReader;
+
+typedef struct _PGCJSONReaderCallbacks PGCJSONReaderCallbacks;
+struct _PGCJSONReaderCallbacks {
+    bool (*beginArray)(void *context);
+    bool (*endArray)(void *context);
+    bool (*beginObject)(void *context);
+    bool (*endObject)(void *context);
+    bool (*key)(void *context, const char *key, uint64_t length);
+    bool (*string)(void *context, const char *string, uint64_t length);
+    bool (*signedInteger)(void *context, int64_t value);
+    bool (*unsignedInteger)(void *context, uint64_t value);
+    bool (*decimal)(void *context, double value);
+    bool (*boolean)(void *context, bool value);
+    bool (*null)(void *context);
+};
+
+extern PGCClass *PGCJSONReaderClass(void);
+extern PGCJSONReader *PGCJSONReaderInstance(void);
+extern PGCJSONReader *PGCJSONReaderInstanceWithCallbacks(PGCJSONReaderCallbacks callbacks, void *context);
+
+extern PGCType PGCJSONReaderObjectWithBytes(const void *bytes, uint64_t length);
+extern PGCType PGCJSONReaderObjectWithCString(const char *cString);
+
+#pragma mark Basic Functions
+
+extern PGCJSONReader *PGCJSONReaderInit(PGCJSONReader *reader);
+extern PGCJSONReader *PGCJSONReaderInitWithCallbacks(PGCJSONReader *reader, PGCJSONReaderCallbacks callbacks, void *context);
+
+#pragma mark Reading
+
+extern bool PGCJSONReaderReadBytes(PGCJSONReader *reader, const void *bytes, uint64_t length);
+extern bool PGCJSONReaderReadFile(PGCJSONReader *reader, FILE *file);
+extern bool PGCJSONReaderFinish(PGCJSONReader *reader);
+
+#pragma mark Accessors
+
+extern PGCType PGCJSONReaderGetRootObject(PGCJSONReader *reader);
+extern bool PGCJSONReaderHasFailed(PGCJSONReader *reader);
+extern uint64_t PGCJSONReaderGetOffset(PGCJSONReader *reader);
+
+#endif
@@ -0,0 +1,686 @@
+//
+//  PGCJSONWriter.c
+//  PGCFoundation
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <PGCFoundation/PGCJSONWriter.h>
+
+#include <PGCFoundation/PGCArray.h>
+#include <PGCFoundation/PGCBoolean.h>
+#include <PGCFoundation/PGCCharacter.h>
+#include <PGCFoundation/PGCDecimal.h>
+#include <PGCFoundation/PGCDecimalArray.h>
+#include <PGCFoundation/PGCDictionary.h>
+#include <PGCFoundation/PGCInteger.h>
+#include <PGCFoundation/PGCIntegerArray.h>
+#include <PGCFoundation/PGCList.h>
+#include <PGCFoundation/PGCNull.h>
+#include <PGCFoundation/PGCStaticDictionary.h>
+
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+// Output is accumulated in a fixed-size buffer and handed to the sink whenever the buffer fills up, so the cost of appending to
+// a string or making a system call is paid once per buffer rather than once per token.
+enum {
+    PGCJSONWriterSinkString,
+    PGCJSONWriterSinkFile,
+    PGCJSONWriterSinkFileDescriptor
+};
+
+
+struct _PGCJSONWriter {
+    PGCObject super;
+    PGCJSONWriterOptions options;
+    
+    uint64_t sink;
+    PGCString *string;
+    FILE *file;
+    int fileDescriptor;
+    
+    char *buffer;
+    uint64_t bufferLength;
+    uint64_t flushedLength;
+    uint64_t depth;
+    uint64_t objectCount;
+    
+    PGCType *entries;
+    uint64_t entryCount;
+    uint64_t entryCapacity;
+    bool hasFailed;
+};
+
+
+#pragma mark Private Global Constants
+
+static const uint64_t PGCJSONWriterBufferCapacity = 65536;
+static const uint64_t PGCJSONWriterMaximumDepth = 1024;
+static const char PGCJSONWriterIndentation[] = "                                                                ";
+static const uint64_t PGCJSONWriterIndentationWidth = 4;
+static const char PGCJSONWriterHexDigits[] = "0123456789abcdef";
+static const double PGCJSONWriterMaximumExactInteger = 9007199254740992.0;
+static const double PGCJSONWriterPowersOf10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 
+                                                  1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+static const char PGCJSONWriterDigitPairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                                              "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                                              "8081828384858687888990919293949596979899";
+
+
+#pragma mark Private Function Interfaces
+
+PGCJSONWriter *PGCJSONWriterInit(PGCJSONWriter *writer, uint64_t sink, PGCJSONWriterOptions options);
+void PGCJSONWriterDealloc(PGCType instance);
+bool PGCJSONWriterWriteToSink(PGCJSONWriter *writer, const char *bytes, uint64_t length);
+void PGCJSONWriterWriteBytes(PGCJSONWriter *writer, const char *bytes, uint64_t length);
+void PGCJSONWriterWriteByte(PGCJSONWriter *writer, char byte);
+void PGCJSONWriterWriteNewline(PGCJSONWriter *writer);
+void PGCJSONWriterWriteValue(PGCJSONWriter *writer, PGCType object);
+void PGCJSONWriterWriteString(PGCJSONWriter *writer, const char *string, uint64_t length);
+void PGCJSONWriterWriteKey(PGCJSONWriter *writer, PGCType key);
+void PGCJSONWriterWriteUnsignedInteger(PGCJSONWriter *writer, uint64_t value, bool isNegative);
+void PGCJSONWriterWriteSignedInteger(PGCJSONWriter *writer, int64_t value);
+void PGCJSONWriterWriteDecimal(PGCJSONWriter *writer, double value);
+char *PGCJSONWriterFormatUnsignedInteger(uint64_t value, char *end);
+bool PGCJSONWriterReserveEntries(PGCJSONWriter *writer, uint64_t count);
+bool PGCJSONWriterBeginContainer(PGCJSONWriter *writer, char character);
+void PGCJSONWriterWriteSeparator(PGCJSONWriter *writer, uint64_t index);
+void PGCJSONWriterEndContainer(PGCJSONWriter *writer, char character, uint64_t count);
+uint64_t PGCJSONWriterScanString(const char *bytes, uint64_t length);
+
+
+#pragma mark -
+
+PGCClass *PGCJSONWriterClass(void)
+{
+    static PGCClass *writerClass = NULL;
+    if (!writerClass) {
+        PGCClassFunctions functions = { NULL, PGCJSONWriterDealloc, NULL, NULL, NULL, NULL, NULL };
+        writerClass = PGCClassCreate("PGCJSONWriter", PGCObjectClass(), functions, sizeof(PGCJSONWriter));
+    }
+    return writerClass;
+}
+
+
+PGCJSONWriter *PGCJSONWriterInstanceWithString(PGCString *string, PGCJSONWriterOptions options)
+{
+    return PGCAutorelease(PGCJSONWriterInitWithString(NULL, string, options));
+}
+
+
+PGCJSONWriter *PGCJSONWriterInstanceWithFile(FILE *file, PGCJSONWriterOptions options)
+{
+    return PGCAutorelease(PGCJSONWriterInitWithFile(NULL, file, options));
+}
+
+
+PGCJSONWriter *PGCJSONWriterInstanceWithFileDescriptor(int fileDescriptor, PGCJSONWriterOptions options)
+{
+    return PGCAutorelease(PGCJSONWriterInitWithFileDescriptor(NULL, fileDescriptor, options));
+}
+
+
+PGCString *PGCJSONWriterStringWithObject(PGCType object, PGCJSONWriterOptions options)
+{
+    PGCString *string = PGCStringInit(NULL);
+    PGCJSONWriter *writer = PGCJSONWriterInitWithString(NULL, string, options);
+    bool succeeded = PGCJSONWriterWriteObject(writer, object) && PGCJSONWriterFlush(writer);
+    
+    PGCRelease(writer);
+    if (!succeeded) {
+        PGCRelease(string);
+        return NULL;
+    }
+    
+    return PGCAutorelease(string);
+}
+
+
+#pragma mark Basic Functions
+
+PGCJSONWriter *PGCJSONWriterInitWithString(PGCJSONWriter *writer, PGCString *string, PGCJSONWriterOptions options)
+{
+    if (!string) return NULL;
+    writer = PGCJSONWriterInit(writer, PGCJSONWriterSinkString, options);
+    if (writer) writer->string = PGCRetain(string);
+    return writer;
+}
+
+
+PGCJSONWriter *PGCJSONWriterInitWithFile(PGCJSONWriter *writer, FILE *file, PGCJSONWriterOptions options)
+{
+    if (!file) return NULL;
+    writer = PGCJSONWriterInit(writer, PGCJSONWriterSinkFile, options);
+    if (writer) writer->file = file;
+    return writer;
+}
+
+
+PGCJSONWriter *PGCJSONWriterInitWithFileDescriptor(PGCJSONWriter *writer, int fileDescriptor, PGCJSONWriterOptions options)
+{
+    if (fileDescriptor < 0) return NULL;
+    writer = PGCJSONWriterInit(writer, PGCJSONWriterSinkFileDescriptor, options);
+    if (writer) writer->fileDescriptor = fileDescriptor;
+    return writer;
+}
+
+
+PGCJSONWriter *PGCJSONWriterInit(PGCJSONWriter *writer, uint64_t sink, PGCJSONWriterOptions options)
+{
+    if (!writer && (writer = PGCAlloc(PGCJSONWriterClass())) == NULL) return NULL;
+    PGCObjectInit(&writer->super);
+    
+    writer->sink = sink;
+    writer->options = options;
+    writer->fileDescriptor = -1;
+    
+    writer->buffer = malloc(PGCJSONWriterBufferCapacity);
+    if (!writer->buffer) {
+        PGCRelease(writer);
+        return NULL;
+    }
+    
+    return writer;
+}
+
+
+void PGCJSONWriterDealloc(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCJSONWriterClass())) return;
+    PGCJSONWriter *writer = instance;
+    
+    // Flush whatever is still buffered. Dealloc has no way to report a failure to the caller, so log it instead. Writers that had
+    // already failed reported it when their writes returned false.
+    if (!writer->hasFailed && writer->bufferLength > 0 && !PGCJSONWriterFlush(writer)) {
+        fprintf(stderr, "PGCJSONWriter: %llu bytes of buffered output were lost when the writer was deallocated\n", writer->bufferLength);
+    }
+    
+    free(writer->buffer);
+    free(writer->entries);
+    PGCRelease(writer->string);
+    
+    PGCSuperclassDealloc(writer);
+}
+
+
+#pragma mark Writing
+
+bool PGCJSONWriterWriteObject(PGCJSONWriter *writer, PGCType object)
+{
+    if (!writer || !object || writer->hasFailed) return false;
+    
+    // Consecutive objects are separated by newlines so that the output can be read back one object at a time
+    if (writer->objectCount++ > 0) PGCJSONWriterWriteByte(writer, '\n');
+    
+    PGCJSONWriterWriteValue(writer, object);
+    return !writer->hasFailed;
+}
+
+
+bool PGCJSONWriterFlush(PGCJSONWriter *writer)
+{
+    // Output is buffered until the buffer fills or this is called. Writers flush when they’re deallocated, but only this reports
+    // whether the output was actually written.
+    if (!writer || writer->hasFailed) return false;
+    if (writer->bufferLength > 0 && !PGCJSONWriterWriteToSink(writer, writer->buffer, writer->bufferLength)) return false;
+    
+    writer->flushedLength += writer->bufferLength;
+    writer->bufferLength = 0;
+    if (writer->sink == PGCJSONWriterSinkFile && fflush(writer->file) != 0) writer->hasFailed = true;
+    return !writer->hasFailed;
+}
+
+
+#pragma mark Accessors
+
+bool PGCJSONWriterHasFailed(PGCJSONWriter *writer)
+{
+    return writer ? writer->hasFailed : true;
+}
+
+
+uint64_t PGCJSONWriterGetLength(PGCJSONWriter *writer)
+{
+    return writer ? writer->flushedLength + writer->bufferLength : 0;
+}
+
+
+#pragma mark Private Functions
+
+bool PGCJSONWriterWriteToSink(PGCJSONWriter *writer, const char *bytes, uint64_t length)
+{
+    switch (writer->sink) {
+        case PGCJSONWriterSinkString: {
+            uint64_t expectedLength = PGCStringGetLength(writer->string) + length;
+            PGCStringAppendBytes(writer->string, bytes, length);
+            if (PGCStringGetLength(writer->string) != expectedLength) writer->hasFailed = true;
+            break;
+        }
+        case PGCJSONWriterSinkFile:
+            if (fwrite(bytes, 1, length, writer->file) != length) writer->hasFailed = true;
+            break;
+        case PGCJSONWriterSinkFileDescriptor:
+            while (length > 0) {
+                ssize_t writtenLength = write(writer->fileDescriptor, bytes, length);
+                if (writtenLength < 0 && errno == EINTR) continue;
+                if (writtenLength <= 0) {
+                    writer->hasFailed = true;
+                    break;
+                }
+                
+                bytes += writtenLength;
+                length -= writtenLength;
+            }
+            break;
+    }
+    
+    return !writer->hasFailed;
+}
+
+
+void PGCJSONWriterWriteBytes(PGCJSONWriter *writer, const char *bytes, uint64_t length)
+{
+    if (length <= PGCJSONWriterBufferCapacity - writer->bufferLength) {
+        memcpy(writer->buffer + writer->bufferLength, bytes, length);
+        writer->bufferLength += length;
+        return;
+    }
+    
+    // Runs that don’t fit in the buffer go straight to the sink after whatever is already buffered
+    if (!PGCJSONWriterFlush(writer)) return;
+    if (length >= PGCJSONWriterBufferCapacity) {
+        if (PGCJSONWriterWriteToSink(writer, bytes, length)) writer->flushedLength += length;
+        return;
+    }
+    
+    memcpy(writer->buffer, bytes, length);
+    writer->bufferLength = length;
+}
+
+
+void PGCJSONWriterWriteByte(PGCJSONWriter *writer, char byte)
+{
+    if (writer->bufferLength == PGCJSONWriterBufferCapacity && !PGCJSONWriterFlush(writer)) return;
+    writer->buffer[writer->bufferLength++] = byte;
+}
+
+
+void PGCJSONWriterWriteNewline(PGCJSONWriter *writer)
+{
+    PGCJSONWriterWriteByte(writer, '\n');
+    
+    uint64_t indentationLength = writer->depth * PGCJSONWriterIndentationWidth;
+    while (indentationLength > 0) {
+        uint64_t length = indentationLength < sizeof(PGCJSONWriterIndentation) - 1 ? indentationLength : sizeof(PGCJSONWriterIndentation) - 1;
+        PGCJSONWriterWriteBytes(writer, PGCJSONWriterIndentation, length);
+        indentationLength -= length;
+    }
+}
+
+
+void PGCJSONWriterWriteValue(PGCJSONWriter *writer, PGCType object)
+{
+    if (writer->hasFailed) return;
+    
+    if (PGCObjectIsKindOfClass(object, PGCStringClass())) {
+        PGCJSONWriterWriteString(writer, PGCStringGetCString(object), PGCStringGetLength(object));
+    } else if (PGCObjectIsKindOfClass(object, PGCIntegerClass())) {
+        if (PGCIntegerIsSigned(object)) {
+            PGCJSONWriterWriteSignedInteger(writer, PGCIntegerGetSignedValue(object));
+        } else {
+            PGCJSONWriterWriteUnsignedInteger(writer, PGCIntegerGetUnsignedValue(object), false);
+        }
+    } else if (PGCObjectIsKindOfClass(object, PGCDecimalClass())) {
+        PGCJSONWriterWriteDecimal(writer, PGCDecimalGetValue(object));
+    } else if (PGCObjectIsKindOfClass(object, PGCBooleanClass())) {
+        if (PGCBooleanGetValue(object)) {
+            PGCJSONWriterWriteBytes(writer, "true", 4);
+        } else {
+            PGCJSONWriterWriteBytes(writer, "false", 5);
+        }
+    } else if (PGCObjectIsKindOfClass(object, PGCNullClass())) {
+        PGCJSONWriterWriteBytes(writer, "null", 4);
+    } else if (PGCObjectIsKindOfClass(object, PGCCharacterClass())) {
+        // A lone byte of 0x80 or more isn’t valid UTF-8, so characters outside ASCII are written as the code point with their value
+        uint8_t character = (uint8_t)PGCCharacterGetValue(object);
+        if (character < 0x80) {
+            PGCJSONWriterWriteString(writer, (const char *)&character, 1);
+        } else {
+            char escape[8] = { '"', '\\', 'u', '0', '0', PGCJSONWriterHexDigits[character >> 4], PGCJSONWriterHexDigits[character & 0xF],
+                               '"' };
+            PGCJSONWriterWriteBytes(writer, escape, 8);
+        }
+    } else if (PGCObjectIsKindOfClass(object, PGCArrayClass())) {
+        if (!PGCJSONWriterBeginContainer(writer, '[')) return;
+        
+        uint64_t count = PGCArrayGetCount(object);
+        const PGCType *objects = PGCArrayGetObjects(object);
+        for (uint64_t i = 0; i < count && !writer->hasFailed; i++) {
+            PGCJSONWriterWriteSeparator(writer, i);
+            PGCJSONWriterWriteValue(writer, objects[i]);
+        }
+        
+        PGCJSONWriterEndContainer(writer, ']', count);
+    } else if (PGCObjectIsKindOfClass(object, PGCDictionaryClass())) {
+        if (!PGCJSONWriterBeginContainer(writer, '{')) return;
+        
+        // Entries are gathered onto a stack shared by all nesting levels. Index into it rather than holding pointers, as nested
+        // dictionaries may reallocate it.
+        uint64_t count = PGCDictionaryGetCount(object);
+        uint64_t start = writer->entryCount;
+        if (!PGCJSONWriterReserveEntries(writer, 2 * count)) return;
+        if (count > 0) PGCDictionaryGetKeysAndObjects(object, writer->entries + start, writer->entries + start + count);
+        writer->entryCount += 2 * count;
+        
+        for (uint64_t i = 0; i < count && !writer->hasFailed; i++) {
+            PGCJSONWriterWriteSeparator(writer, i);
+            PGCJSONWriterWriteKey(writer, writer->entries[start + i]);
+            PGCJSONWriterWriteValue(writer, writer->entries[start + count + i]);
+        }
+        
+        writer->entryCount = start;
+        PGCJSONWriterEndContainer(writer, '}', count);
+    } else if (PGCObjectIsKindOfClass(object, PGCStaticDictionaryClass())) {
+        if (!PGCJSONWriterBeginContainer(writer, '{')) return;
+        
+        PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+        PGCArray *keys = PGCStaticDictionaryGetAllKeys(object);
+        PGCArray *objects = PGCStaticDictionaryGetAllObjects(object);
+        uint64_t count = PGCArrayGetCount(keys);
+        for (uint64_t i = 0; i < count && !writer->hasFailed; i++) {
+            PGCJSONWriterWriteSeparator(writer, i);
+            PGCJSONWriterWriteKey(writer, PGCArrayGetObjects(keys)[i]);
+            PGCJSONWriterWriteValue(writer, PGCArrayGetObjects(objects)[i]);
+        }
+        PGCAutoreleasePoolDestroy(pool);
+        
+        PGCJSONWriterEndContainer(writer, '}', count);
+    } else if (PGCObjectIsKindOfClass(object, PGCListClass())) {
+        if (!PGCJSONWriterBeginContainer(writer, '[')) return;
+        
+        PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+        uint64_t count = PGCListGetCount(object);
+        for (uint64_t i = 0; i < count && !writer->hasFailed; i++) {
+            PGCJSONWriterWriteSeparator(writer, i);
+            PGCJSONWriterWriteValue(writer, PGCListGetObjectAtIndex(object, i));
+        }
+        PGCAutoreleasePoolDestroy(pool);
+        
+        PGCJSONWriterEndContainer(writer, ']', count);
+    } else if (PGCObjectIsKindOfClass(object, PGCIntegerArrayClass())) {
+        if (!PGCJSONWriterBeginContainer(writer, '[')) return;
+        
+        uint64_t count = PGCIntegerArrayGetCount(object);
+        const int64_t *values = PGCIntegerArrayGetValues(object);
+        for (uint64_t i = 0; i < count && !writer->hasFailed; i++) {
+            PGCJSONWriterWriteSeparator(writer, i);
+            PGCJSONWriterWriteSignedInteger(writer, values[i]);
+        }
+        
+        PGCJSONWriterEndContainer(writer, ']', count);
+    } else if (PGCObjectIsKindOfClass(object, PGCDecimalArrayClass())) {
+        if (!PGCJSONWriterBeginContainer(writer, '[')) return;
+        
+        uint64_t count = PGCDecimalArrayGetCount(object);
+        const double *values = PGCDecimalArrayGetValues(object);
+        for (uint64_t i = 0; i < count && !writer->hasFailed; i++) {
+            PGCJSONWriterWriteSeparator(writer, i);
+            PGCJSONWriterWriteDecimal(writer, values[i]);
+        }
+        
+        PGCJSONWriterEndContainer(writer, ']', count);
+    } else {
+        // Other objects have no JSON representation
+        writer->hasFailed = true;
+    }
+}
+
+
+void PGCJSONWriterWriteString(PGCJSONWriter *writer, const char *string, uint64_t length)
+{
+    PGCJSONWriterWriteByte(writer, '"');
+    
+    while (length > 0) {
+        uint64_t plainLength = PGCJSONWriterScanString(string, length);
+        PGCJSONWriterWriteBytes(writer, string, plainLength);
+        string += plainLength;
+        length -= plainLength;
+        if (length == 0) break;
+        
+        char escape[6] = { '\\', '\0' };
+        uint64_t escapeLength = 2;
+        switch (*string) {
+            case '"': escape[1] = '"'; break;
+            case '\\': escape[1] = '\\'; break;
+            case '\b': escape[1] = 'b'; break;
+            case '\f': escape[1] = 'f'; break;
+            case '\n': escape[1] = 'n'; break;
+            case '\r': escape[1] = 'r'; break;
+            case '\t': escape[1] = 't'; break;
+            default:
+                escape[1] = 'u';
+                escape[2] = '0';
+                escape[3] = '0';
+                escape[4] = PGCJSONWriterHexDigits[(uint8_t)*string >> 4];
+                escape[5] = PGCJSONWriterHexDigits[*string & 0xF];
+                escapeLength = 6;
+                break;
+        }
+        
+        PGCJSONWriterWriteBytes(writer, escape, escapeLength);
+        string++;
+        length--;
+    }
+    
+    PGCJSONWriterWriteByte(writer, '"');
+}
+
+
+void PGCJSONWriterWriteKey(PGCJSONWriter *writer, PGCType key)
+{
+    // JSON object keys must be strings
+    if (!PGCObjectIsKindOfClass(key, PGCStringClass())) {
+        writer->hasFailed = true;
+        return;
+    }
+    
+    PGCJSONWriterWriteString(writer, PGCStringGetCString(key), PGCStringGetLength(key));
+    if (writer->options & PGCJSONWriterPrettyPrinted) {
+        PGCJSONWriterWriteBytes(writer, ": ", 2);
+    } else {
+        PGCJSONWriterWriteByte(writer, ':');
+    }
+}
+
+
+void PGCJSONWriterWriteUnsignedInteger(PGCJSONWriter *writer, uint64_t value, bool isNegative)
+{
+    char digits[21];
+    char *end = digits + sizeof(digits);
+    char *start = PGCJSONWriterFormatUnsignedInteger(value, end);
+    if (isNegative) *--start = '-';
+    PGCJSONWriterWriteBytes(writer, start, end - start);
+}
+
+
+void PGCJSONWriterWriteSignedInteger(PGCJSONWriter *writer, int64_t value)
+{
+    // Negate in unsigned arithmetic so that INT64_MIN doesn’t overflow
+    if (value < 0) {
+        PGCJSONWriterWriteUnsignedInteger(writer, 0 - (uint64_t)value, true);
+    } else {
+        PGCJSONWriterWriteUnsignedInteger(writer, value, false);
+    }
+}
+
+
+void PGCJSONWriterWriteDecimal(PGCJSONWriter *writer, double value)
+{
+    // JSON has no representation for infinities or NaN
+    if (!isfinite(value)) {
+        writer->hasFailed = true;
+        return;
+    }
+    
+    // Whole numbers that fit in a double’s mantissa are formatted as integers. A trailing .0 keeps them decimals when read back.
+    double magnitude = fabs(value);
+    if (value == trunc(value) && magnitude < PGCJSONWriterMaximumExactInteger) {
+        PGCJSONWriterWriteUnsignedInteger(writer, (uint64_t)magnitude, signbit(value));
+        PGCJSONWriterWriteBytes(writer, ".0", 2);
+        return;
+    }
+    
+    // Look for the fewest fractional digits k such that value is the double nearest to m / 10^k for some integer m. While m and 
+    // 10^k are both exactly representable, that division is correctly rounded, so checking it is the same as checking whether
+    // the digits of m read back as value. This covers most values that were decimal numbers to begin with.
+    for (uint64_t k = 1; k < sizeof(PGCJSONWriterPowersOf10) / sizeof(double); k++) {
+        double scaledMagnitude = magnitude * PGCJSONWriterPowersOf10[k];
+        if (scaledMagnitude >= PGCJSONWriterMaximumExactInteger) break;
+        
+        uint64_t mantissa = (uint64_t)nearbyint(scaledMagnitude);
+        if (mantissa / PGCJSONWriterPowersOf10[k] != magnitude) continue;
+        
+        // Format the mantissa, then make room for the decimal point and any leading zeros
+        char digits[48];
+        char *end = digits + sizeof(digits);
+        char *start = PGCJSONWriterFormatUnsignedInteger(mantissa, end);
+        while ((uint64_t)(end - start) <= k) *--start = '0';
+        memmove(start - 1, start, end - start - k);
+        *(end - k - 1) = '.';
+        start--;
+        if (signbit(value)) *--start = '-';
+        
+        PGCJSONWriterWriteBytes(writer, start, end - start);
+        return;
+    }
+    
+    // Otherwise use the shortest precision that reads back as the same value
+    char digits[32];
+    int length = 0;
+    for (int precision = 15; precision <= 17; precision++) {
+        length = snprintf(digits, sizeof(digits), "%.*g", precision, value);
+        if (precision == 17 || strtod(digits, NULL) == value) break;
+    }
+    
+    PGCJSONWriterWriteBytes(writer, digits, length);
+    if (!strpbrk(digits, ".eE")) PGCJSONWriterWriteBytes(writer, ".0", 2);
+}
+
+
+char *PGCJSONWriterFormatUnsignedInteger(uint64_t value, char *end)
+{
+    // Fill the buffer backward from end, two digits at a time
+    char *start = end;
+    while (value >= 100) {
+        uint64_t pairIndex = (value % 100) * 2;
+        value /= 100;
+        *--start = PGCJSONWriterDigitPairs[pairIndex + 1];
+        *--start = PGCJSONWriterDigitPairs[pairIndex];
+    }
+    
+    if (value >= 10) {
+        *--start = PGCJSONWriterDigitPairs[value * 2 + 1];
+        *--start = PGCJSONWriterDigitPairs[value * 2];
+    } else {
+        *--start = (char)('0' + value);
+    }
+    
+    return start;
+}
+
+
+bool PGCJSONWriterReserveEntries(PGCJSONWriter *writer, uint64_t count)
+{
+    if (writer->entryCapacity - writer->entryCount >= count) return true;
+    
+    uint64_t capacity = writer->entryCapacity ? writer->entryCapacity : 256;
+    while (capacity - writer->entryCount < count) capacity *= 2;
+    
+    PGCType *entries = realloc(writer->entries, capacity * sizeof(PGCType));
+    if (!entries) {
+        writer->hasFailed = true;
+        return false;
+    }
+    
+    writer->entries = entries;
+    writer->entryCapacity = capacity;
+    return true;
+}
+
+
+bool PGCJSONWriterBeginContainer(PGCJSONWriter *writer, char character)
+{
+    // Also keeps cyclic object graphs from recursing forever
+    if (writer->depth == PGCJSONWriterMaximumDepth) {
+        writer->hasFailed = true;
+        return false;
+    }
+    
+    PGCJSONWriterWriteByte(writer, character);
+    writer->depth++;
+    return true;
+}
+
+
+void PGCJSONWriterWriteSeparator(PGCJSONWriter *writer, uint64_t index)
+{
+    if (index > 0) PGCJSONWriterWriteByte(writer, ',');
+    if (writer->options & PGCJSONWriterPrettyPrinted) PGCJSONWriterWriteNewline(writer);
+}
+
+
+void PGCJSONWriterEndContainer(PGCJSONWriter *writer, char character, uint64_t count)
+{
+    writer->depth--;
+    if (count > 0 && (writer->options & PGCJSONWriterPrettyPrinted)) PGCJSONWriterWriteNewline(writer);
+    PGCJSONWriterWriteByte(writer, character);
+}
+
+
+uint64_t PGCJSONWriterScanString(const char *bytes, uint64_t length)
+{
+    // Returns the number of bytes before the first character that must be escaped: a quote, a backslash, or a control character
+    uint64_t i = 0;
+#if defined(__x86_64__)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i lastControlCharacter = _mm_set1_epi8(0x1F);
+    for (; i + 16 <= length; i += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)(bytes + i));
+        __m128i isControlCharacter = _mm_cmpeq_epi8(_mm_max_epu8(chunk, lastControlCharacter), lastControlCharacter);
+        __m128i mustEscape = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)), isControlCharacter);
+        int mask = _mm_movemask_epi8(mustEscape);
+        if (mask) return i + __builtin_ctz(mask);
+    }
+#endif
+    
+    while (i < length && bytes[i] != '"' && bytes[i] != '\\' && (uint8_t)bytes[i] >= 0x20) i++;
+    return i;
+}
@@ -0,0 +1,69 @@
+//
+//  PGCJSONWriter.h
+//  PGCFoundation
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef PGCJSONWRITER_H
+#define PGCJSONWRITER_H
+
+#include <PGCFoundation/PGCObject.h>
+#include <PGCFoundation/PGCString.h>
+
+#include <stdio.h>
+
+typedef struct _PGCJSONWriter PGCJSONWriter;
+
+enum {
+    PGCJSONWriterPrettyPrinted = 1UL << 0
+};
+
+typedef uint64_t PGCJSONWriterOptions;
+
+extern PGCClass *PGCJSONWriterClass(void);
+extern PGCJSONWriter *PGCJSONWriterInstanceWithString(PGCString *string, PGCJSONWriterOptions options);
+extern PGCJSONWriter *PGCJSONWriterInstanceWithFile(FILE *file, PGCJSONWriterOptions options);
+extern PGCJSONWriter *PGCJSONWriterInstanceWithFileDescriptor(int fileDescriptor, PGCJSONWriterOptions options);
+
+extern PGCString *PGCJSONWriterStringWithObject(PGCType object, PGCJSONWriterOptions options);
+
+#pragma mark Basic Functions
+
+extern PGCJSONWriter *PGCJSONWriterInitWithString(PGCJSONWriter *writer, PGCString *string, PGCJSONWriterOptions options);
+extern PGCJSONWriter *PGCJSONWriterInitWithFile(PGCJSONWriter *writer, FILE *file, PGCJSONWriterOptions options);
+extern PGCJSONWriter *PGCJSONWriterInitWithFileDescriptor(PGCJSONWriter *writer, int fileDescriptor, PGCJSONWriterOptions options);
+
+#pragma mark Writing
+
+extern bool PGCJSONWriterWriteObject(PGCJSONWriter *writer, PGCType object);
+
+// Output is buffered. A writer flushes its buffer when it is deallocated, but can only log a failure to stderr at that point,
+// so call this after writing the last object to find out whether everything was written.
+extern bool PGCJSONWriterFlush(PGCJSONWriter *writer);
+
+#pragma mark Accessors
+
+extern bool PGCJSONWriterHasFailed(PGCJSONWriter *writer);
+extern uint64_t PGCJSONWriterGetLength(PGCJSONWriter *writer);
+
+#endif
@@ -0,0 +1,913 @@
+//
+//  PGCMappedFile.c
+//  PGCFoundation
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#include <PGCFoundation/PGCMappedFile.h>
+
+#include <PGCFoundation/PGCBoolean.h>
+#include <PGCFoundation/PGCCharacter.h>
+#include <PGCFoundation/PGCDecimal.h>
+#include <PGCFoundation/PGCInteger.h>
+#include <PGCFoundation/PGCNull.h>
+#include <PGCFoundation/PGCStaticDictionary.h>
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Mapped files contain no pointers. Every value is a 16-byte type and payload pair. Scalars are stored in the payload itself,
+// while strings, arrays, and dictionaries are stored in records, and their payloads hold their records’ offsets from the start
+// of the file. Records are 8-byte aligned and begin with a count:
+//
+//   - Strings: the length, followed by the string’s characters and a NUL terminator
+//   - Arrays: the count, followed by the array’s values
+//   - Dictionaries: the count, followed by the keys’ hashes in ascending order, the keys’ values, and the objects’ values
+//
+// Integers are stored in the byte order of the machine that wrote the file. Files with a different byte order are rejected.
+enum {
+    PGCMappedFileValueTypeNull = 1,
+    PGCMappedFileValueTypeBoolean,
+    PGCMappedFileValueTypeCharacter,
+    PGCMappedFileValueTypeSignedInteger,
+    PGCMappedFileValueTypeUnsignedInteger,
+    PGCMappedFileValueTypeDecimal,
+    PGCMappedFileValueTypeString,
+    PGCMappedFileValueTypeArray,
+    PGCMappedFileValueTypeDictionary
+};
+
+
+typedef struct _PGCMappedFileValue {
+    uint64_t type;
+    uint64_t payload;
+} PGCMappedFileValue;
+
+
+typedef struct _PGCMappedFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint64_t size;
+    PGCMappedFileValue root;
+} PGCMappedFileHeader;
+
+
+struct _PGCMappedFile {
+    PGCObject super;
+    const uint8_t *bytes;
+    uint64_t size;
+};
+
+
+struct _PGCMappedArray {
+    PGCObject super;
+    PGCMappedFile *mappedFile;
+    uint64_t offset;
+    uint64_t depth;
+    const PGCMappedFileValue *values;
+    uint64_t count;
+    uint64_t hash;
+    bool hashIsValid;
+};
+
+
+struct _PGCMappedDictionary {
+    PGCObject super;
+    PGCMappedFile *mappedFile;
+    uint64_t offset;
+    uint64_t depth;
+    uint64_t count;
+    const uint64_t *keyHashes;
+    const PGCMappedFileValue *keys;
+    const PGCMappedFileValue *objects;
+    uint64_t hash;
+    bool hashIsValid;
+};
+
+
+typedef struct _PGCMappedFileWriter {
+    uint8_t *bytes;
+    uint64_t length;
+    uint64_t capacity;
+} PGCMappedFileWriter;
+
+
+typedef struct _PGCMappedFileWriterEntry {
+    uint64_t keyHash;
+    PGCType key;
+    PGCType object;
+} PGCMappedFileWriterEntry;
+
+
+#pragma mark Private Global Constants
+
+static const char PGCMappedFileMagic[8] = { 'P', 'G', 'C', 'M', 'A', 'P', '\0', '\0' };
+static const uint32_t PGCMappedFileVersion = 1;
+static const uint32_t PGCMappedFileByteOrderMark = 0x01020304;
+static const uint64_t PGCMappedFileWriterInitialCapacity = 4096;
+static const uint64_t PGCMappedFileMaximumDepth = 1024;
+
+
+#pragma mark Private Function Interfaces
+
+void PGCMappedFileDealloc(PGCType instance);
+const uint8_t *PGCMappedFileGetRecordContents(PGCMappedFile *mappedFile, uint64_t offset, uint64_t elementSize, uint64_t *count);
+const char *PGCMappedFileGetCString(PGCMappedFile *mappedFile, uint64_t offset, uint64_t *length);
+PGCType PGCMappedFileGetObjectForValue(PGCMappedFile *mappedFile, const PGCMappedFileValue *value, uint64_t parentOffset, uint64_t parentDepth);
+PGCType PGCMappedFileGetUnmappedObjectForValue(PGCMappedFile *mappedFile, const PGCMappedFileValue *value, uint64_t parentOffset,
+                                               uint64_t parentDepth);
+bool PGCMappedFileValueEqualsObject(PGCMappedFile *mappedFile, const PGCMappedFileValue *value, uint64_t parentOffset, uint64_t parentDepth,
+                                    PGCType object);
+
+PGCMappedArray *PGCMappedArrayInitWithRecord(PGCMappedArray *mappedArray, PGCMappedFile *mappedFile, uint64_t offset, uint64_t depth);
+void PGCMappedArrayDealloc(PGCType instance);
+
+PGCMappedDictionary *PGCMappedDictionaryInitWithRecord(PGCMappedDictionary *mappedDictionary, PGCMappedFile *mappedFile, uint64_t offset,
+                                                       uint64_t depth);
+void PGCMappedDictionaryDealloc(PGCType instance);
+uint64_t PGCMappedDictionaryGetIndexOfKey(PGCMappedDictionary *mappedDictionary, PGCType key);
+
+bool PGCMappedFileWriterReserve(PGCMappedFileWriter *writer, uint64_t length, uint64_t *offset);
+bool PGCMappedFileWriterEncodeObject(PGCMappedFileWriter *writer, PGCType object, PGCMappedFileValue *value);
+bool PGCMappedFileWriterAppendString(PGCMappedFileWriter *writer, PGCString *string, uint64_t *offset);
+bool PGCMappedFileWriterAppendArray(PGCMappedFileWriter *writer, PGCArray *array, uint64_t *offset);
+bool PGCMappedFileWriterAppendDictionary(PGCMappedFileWriter *writer, PGCArray *keys, PGCArray *objects, uint64_t *offset);
+int PGCMappedFileWriterCompareEntries(const void *entry1, const void *entry2);
+
+
+#pragma mark - PGCMappedFile
+
+PGCClass *PGCMappedFileClass(void)
+{
+    static PGCClass *mappedFileClass = NULL;
+    if (!mappedFileClass) {
+        PGCClassFunctions functions = { PGCMappedFileCopy, PGCMappedFileDealloc, PGCMappedFileDescription, NULL, NULL, NULL, NULL };
+        mappedFileClass = PGCClassCreate("PGCMappedFile", PGCObjectClass(), functions, sizeof(PGCMappedFile));
+    }
+    return mappedFileClass;
+}
+
+
+PGCMappedFile *PGCMappedFileInstanceWithPath(const char *path)
+{
+    return PGCAutorelease(PGCMappedFileInitWithPath(NULL, path));
+}
+
+
+#pragma mark Basic Functions
+
+PGCMappedFile *PGCMappedFileInitWithPath(PGCMappedFile *mappedFile, const char *path)
+{
+    if (!path) return NULL;
+    if (!mappedFile && (mappedFile = PGCAlloc(PGCMappedFileClass())) == NULL) return NULL;
+    PGCObjectInit(&mappedFile->super);
+    
+    mappedFile->bytes = NULL;
+    mappedFile->size = 0;
+
+    int fileDescriptor = open(path, O_RDONLY);
+    struct stat fileStatus;
+    if (fileDescriptor < 0 || fstat(fileDescriptor, &fileStatus) != 0 || (uint64_t)fileStatus.st_size < sizeof(PGCMappedFileHeader)) {
+        if (fileDescriptor >= 0) close(fileDescriptor);
+        PGCRelease(mappedFile);
+        return NULL;
+    }
+    
+    // The mapping is read-only and shared, so every process that maps the same file shares the same physical pages. The mapping
+    // outlives the file descriptor.
+    void *bytes = mmap(NULL, fileStatus.st_size, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+    close(fileDescriptor);
+    if (bytes == MAP_FAILED) {
+        PGCRelease(mappedFile);
+        return NULL;
+    }
+    
+    mappedFile->bytes = bytes;
+    mappedFile->size = fileStatus.st_size;
+    
+    const PGCMappedFileHeader *header = bytes;
+    if (memcmp(header->magic, PGCMappedFileMagic, sizeof(PGCMappedFileMagic)) != 0 || header->version != PGCMappedFileVersion ||
+        header->byteOrderMark != PGCMappedFileByteOrderMark || header->size != mappedFile->size) {
+        PGCRelease(mappedFile);
+        return NULL;
+    }
+    
+    return mappedFile;
+}
+
+
+void PGCMappedFileDealloc(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCMappedFileClass())) return;
+    PGCMappedFile *mappedFile = instance;
+    if (mappedFile->bytes) munmap((void *)mappedFile->bytes, mappedFile->size);
+    PGCSuperclassDealloc(mappedFile);
+}
+
+
+PGCType PGCMappedFileCopy(PGCType instance)
+{
+    // Mapped files are read-only, so they are their own copies
+    return PGCObjectIsKindOfClass(instance, PGCMappedFileClass()) ? PGCRetain(instance) : NULL;
+}
+
+
+PGCString *PGCMappedFileDescription(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCMappedFileClass())) return NULL;
+    return PGCStringInstanceWithFormat("<PGCMappedFile %p: %llu bytes>", instance, ((PGCMappedFile *)instance)->size);
+}
+
+
+#pragma mark Accessors
+
+uint64_t PGCMappedFileGetSize(PGCMappedFile *mappedFile)
+{
+    return mappedFile ? mappedFile->size : 0;
+}
+
+
+PGCType PGCMappedFileGetRootObject(PGCMappedFile *mappedFile)
+{
+    return mappedFile ? PGCMappedFileGetObjectForValue(mappedFile, &((const PGCMappedFileHeader *)mappedFile->bytes)->root, 0, 0) : NULL;
+}
+
+
+const uint8_t *PGCMappedFileGetRecordContents(PGCMappedFile *mappedFile, uint64_t offset, uint64_t elementSize, uint64_t *count)
+{
+    // Records are checked when they’re first read, so a corrupt file produces missing objects rather than invalid memory accesses
+    if (offset % sizeof(uint64_t) != 0 || offset > mappedFile->size || mappedFile->size - offset < sizeof(uint64_t)) return NULL;
+    
+    uint64_t elementCount = *(const uint64_t *)&mappedFile->bytes[offset];
+    uint64_t availableLength = mappedFile->size - offset - sizeof(uint64_t);
+    if (elementCount > availableLength / elementSize) return NULL;
+    
+    *count = elementCount;
+    return &mappedFile->bytes[offset + sizeof(uint64_t)];
+}
+
+
+const char *PGCMappedFileGetCString(PGCMappedFile *mappedFile, uint64_t offset, uint64_t *length)
+{
+    uint64_t characterCount = 0;
+    const uint8_t *characters = PGCMappedFileGetRecordContents(mappedFile, offset, 1, &characterCount);
+    if (!characters || (uint64_t)(characters - mappedFile->bytes) + characterCount >= mappedFile->size) return NULL;
+    if (characters[characterCount] != '\0') return NULL;
+    
+    *length = characterCount;
+    return (const char *)characters;
+}
+
+
+PGCType PGCMappedFileGetObjectForValue(PGCMappedFile *mappedFile, const PGCMappedFileValue *value, uint64_t parentOffset, uint64_t parentDepth)
+{
+    // The writer appends a container’s record before those of its elements, so a nested record must come after its parent’s. This
+    // keeps a corrupt file from describing a container that contains itself, and the depth limit keeps deep nesting from
+    // exhausting the stack when views are unmapped, compared, hashed, or described.
+    if ((value->type == PGCMappedFileValueTypeArray || value->type == PGCMappedFileValueTypeDictionary) &&
+        (value->payload <= parentOffset || parentDepth >= PGCMappedFileMaximumDepth)) {
+        return NULL;
+    }
+    
+    switch (value->type) {
+        case PGCMappedFileValueTypeNull:
+            return PGCNullInstance();
+        case PGCMappedFileValueTypeBoolean:
+            return value->payload ? PGCBooleanTrue() : PGCBooleanFalse();
+        case PGCMappedFileValueTypeCharacter:
+            return PGCCharacterInstanceWithValue((char)value->payload);
+        case PGCMappedFileValueTypeSignedInteger:
+            return PGCIntegerInstanceWithSignedValue((int64_t)value->payload);
+        case PGCMappedFileValueTypeUnsignedInteger:
+            return PGCIntegerInstanceWithUnsignedValue(value->payload);
+        case PGCMappedFileValueTypeDecimal: {
+            double decimalValue;
+            memcpy(&decimalValue, &value->payload, sizeof(double));
+            return PGCDecimalInstanceWithValue(decimalValue);
+        }
+        case PGCMappedFileValueTypeString: {
+            uint64_t length = 0;
+            const char *cString = PGCMappedFileGetCString(mappedFile, value->payload, &length);
+            return cString ? PGCStringInstanceWithCString(cString) : NULL;
+        }
+        case PGCMappedFileValueTypeArray:
+            return PGCAutorelease(PGCMappedArrayInitWithRecord(NULL, mappedFile, value->payload, parentDepth + 1));
+        case PGCMappedFileValueTypeDictionary:
+            return PGCAutorelease(PGCMappedDictionaryInitWithRecord(NULL, mappedFile, value->payload, parentDepth + 1));
+        default:
+            return NULL;
+    }
+}
+
+
+PGCType PGCMappedFileGetUnmappedObjectForValue(PGCMappedFile *mappedFile, const PGCMappedFileValue *value, uint64_t parentOffset,
+                                               uint64_t parentDepth)
+{
+    PGCType object = PGCMappedFileGetObjectForValue(mappedFile, value, parentOffset, parentDepth);
+    if (PGCObjectIsKindOfClass(object, PGCMappedArrayClass())) return PGCMappedArrayGetArray(object);
+    if (PGCObjectIsKindOfClass(object, PGCMappedDictionaryClass())) return PGCMappedDictionaryGetDictionary(object);
+    return object;
+}
+
+
+bool PGCMappedFileValueEqualsObject(PGCMappedFile *mappedFile, const PGCMappedFileValue *value, uint64_t parentOffset, uint64_t parentDepth,
+                                    PGCType object)
+{
+    // String keys are by far the most common, so compare them in place rather than creating a string for each comparison
+    if (value->type == PGCMappedFileValueTypeString && PGCObjectIsKindOfClass(object, PGCStringClass())) {
+        uint64_t length = 0;
+        const char *cString = PGCMappedFileGetCString(mappedFile, value->payload, &length);
+        return cString && length == PGCStringGetLength(object) && memcmp(cString, PGCStringGetCString(object), length) == 0;
+    }
+    
+    // Mapped views only equal other views, so compare them with the value’s view rather than its unmapped object
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+    bool objectIsMapped = PGCObjectIsKindOfClass(object, PGCMappedArrayClass()) || PGCObjectIsKindOfClass(object, PGCMappedDictionaryClass());
+    PGCType valueObject = objectIsMapped ? PGCMappedFileGetObjectForValue(mappedFile, value, parentOffset, parentDepth)
+                                         : PGCMappedFileGetUnmappedObjectForValue(mappedFile, value, parentOffset, parentDepth);
+    bool equals = PGCEquals(valueObject, object);
+    PGCAutoreleasePoolDestroy(pool);
+    return equals;
+}
+
+
+#pragma mark Writing
+
+bool PGCMappedFileWriteObjectToPath(PGCType object, const char *path)
+{
+    if (!object || !path) return false;
+
+    PGCMappedFileHeader header;
+    memset(&header, 0, sizeof(PGCMappedFileHeader));
+    memcpy(header.magic, PGCMappedFileMagic, sizeof(PGCMappedFileMagic));
+    header.version = PGCMappedFileVersion;
+    header.byteOrderMark = PGCMappedFileByteOrderMark;
+    
+    // Build the whole file in memory, reserving space for the header until we know the root value and size
+    PGCMappedFileWriter writer = { NULL, 0, 0 };
+    uint64_t headerOffset = 0;
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+    bool encoded = PGCMappedFileWriterReserve(&writer, sizeof(PGCMappedFileHeader), &headerOffset) && 
+                   PGCMappedFileWriterEncodeObject(&writer, object, &header.root);
+    PGCAutoreleasePoolDestroy(pool);
+    
+    if (!encoded) {
+        free(writer.bytes);
+        return false;
+    }
+    
+    header.size = writer.length;
+    memcpy(&writer.bytes[headerOffset], &header, sizeof(PGCMappedFileHeader));
+    
+    // Other processes may have the file at path mapped, and truncating it would crash them when they next touched a page. So
+    // write a temporary file next to it and rename it into place, which leaves existing mappings of the old file intact.
+    size_t pathLength = strlen(path);
+    char *temporaryPath = malloc(pathLength + 8);
+    if (!temporaryPath) {
+        free(writer.bytes);
+        return false;
+    }
+    
+    memcpy(temporaryPath, path, pathLength);
+    memcpy(&temporaryPath[pathLength], ".XXXXXX", 8);
+    
+    int fileDescriptor = mkstemp(temporaryPath);
+    bool written = fileDescriptor >= 0;
+    for (uint64_t offset = 0; written && offset < writer.length; ) {
+        ssize_t writtenLength = write(fileDescriptor, &writer.bytes[offset], writer.length - offset);
+        written = writtenLength > 0;
+        offset += written ? writtenLength : 0;
+    }
+    
+    // mkstemp creates files that only their owner can read, but mapped files are meant to be shared
+    written = written && fchmod(fileDescriptor, 0644) == 0;
+    if (fileDescriptor >= 0) written = close(fileDescriptor) == 0 && written;
+    written = written && rename(temporaryPath, path) == 0;
+    if (!written && fileDescriptor >= 0) unlink(temporaryPath);
+    
+    free(temporaryPath);
+    free(writer.bytes);
+    return written;
+}
+
+
+bool PGCMappedFileWriterReserve(PGCMappedFileWriter *writer, uint64_t length, uint64_t *offset)
+{
+    // Keep every record 8-byte aligned so that counts, hashes, and values can be read in place
+    uint64_t alignedLength = (length + sizeof(uint64_t) - 1) & ~(uint64_t)(sizeof(uint64_t) - 1);
+    if (alignedLength < length || writer->length + alignedLength < writer->length) return false;
+    
+    if (writer->length + alignedLength > writer->capacity) {
+        uint64_t capacity = writer->capacity > 0 ? writer->capacity : PGCMappedFileWriterInitialCapacity;
+        while (capacity < writer->length + alignedLength) capacity *= 2;
+        
+        uint8_t *reallocedBytes = realloc(writer->bytes, capacity);
+        if (!reallocedBytes) return false;
+        writer->bytes = reallocedBytes;
+        writer->capacity = capacity;
+    }
+    
+    memset(&writer->bytes[writer->length], 0, alignedLength);
+    *offset = writer->length;
+    writer->length += alignedLength;
+    return true;
+}
+
+
+bool PGCMappedFileWriterEncodeObject(PGCMappedFileWriter *writer, PGCType object, PGCMappedFileValue *value)
+{
+    value->payload = 0;
+    if (PGCObjectIsKindOfClass(object, PGCNullClass())) {
+        value->type = PGCMappedFileValueTypeNull;
+    } else if (PGCObjectIsKindOfClass(object, PGCBooleanClass())) {
+        value->type = PGCMappedFileValueTypeBoolean;
+        value->payload = PGCBooleanGetValue(object);
+    } else if (PGCObjectIsKindOfClass(object, PGCCharacterClass())) {
+        value->type = PGCMappedFileValueTypeCharacter;
+        value->payload = (uint8_t)PGCCharacterGetValue(object);
+    } else if (PGCObjectIsKindOfClass(object, PGCIntegerClass())) {
+        value->type = PGCIntegerIsSigned(object) ? PGCMappedFileValueTypeSignedInteger : PGCMappedFileValueTypeUnsignedInteger;
+        value->payload = PGCIntegerGetUnsignedValue(object);
+    } else if (PGCObjectIsKindOfClass(object, PGCDecimalClass())) {
+        double decimalValue = PGCDecimalGetValue(object);
+        value->type = PGCMappedFileValueTypeDecimal;
+        memcpy(&value->payload, &decimalValue, sizeof(double));
+    } else if (PGCObjectIsKindOfClass(object, PGCStringClass())) {
+        value->type = PGCMappedFileValueTypeString;
+        return PGCMappedFileWriterAppendString(writer, object, &value->payload);
+    } else if (PGCObjectIsKindOfClass(object, PGCArrayClass())) {
+        value->type = PGCMappedFileValueTypeArray;
+        return PGCMappedFileWriterAppendArray(writer, object, &value->payload);
+    } else if (PGCObjectIsKindOfClass(object, PGCDictionaryClass())) {
+        value->type = PGCMappedFileValueTypeDictionary;
+        return PGCMappedFileWriterAppendDictionary(writer, PGCDictionaryGetAllKeys(object), PGCDictionaryGetAllObjects(object), &value->payload);
+    } else if (PGCObjectIsKindOfClass(object, PGCStaticDictionaryClass())) {
+        value->type = PGCMappedFileValueTypeDictionary;
+        return PGCMappedFileWriterAppendDictionary(writer, PGCStaticDictionaryGetAllKeys(object), PGCStaticDictionaryGetAllObjects(object),
+                                                   &value->payload);
+    } else {
+        return false;
+    }
+    
+    return true;
+}
+
+
+bool PGCMappedFileWriterAppendString(PGCMappedFileWriter *writer, PGCString *string, uint64_t *offset)
+{
+    uint64_t length = PGCStringGetLength(string);
+    if (!PGCMappedFileWriterReserve(writer, sizeof(uint64_t) + length + 1, offset)) return false;
+    
+    memcpy(&writer->bytes[*offset], &length, sizeof(uint64_t));
+    memcpy(&writer->bytes[*offset + sizeof(uint64_t)], PGCStringGetCString(string), length);
+    return true;
+}
+
+
+bool PGCMappedFileWriterAppendArray(PGCMappedFileWriter *writer, PGCArray *array, uint64_t *offset)
+{
+    uint64_t count = PGCArrayGetCount(array);
+    uint64_t recordOffset = 0;
+    if (!PGCMappedFileWriterReserve(writer, sizeof(uint64_t) + count * sizeof(PGCMappedFileValue), &recordOffset)) return false;
+    memcpy(&writer->bytes[recordOffset], &count, sizeof(uint64_t));
+    
+    // Encoding an element may append records and move the writer’s bytes, so values are copied in by offset once encoded
+    for (uint64_t i = 0; i < count; i++) {
+        PGCMappedFileValue value;
+        if (!PGCMappedFileWriterEncodeObject(writer, PGCArrayGetObjectAtIndex(array, i), &value)) return false;
+        memcpy(&writer->bytes[recordOffset + sizeof(uint64_t) + i * sizeof(PGCMappedFileValue)], &value, sizeof(PGCMappedFileValue));
+    }
+    
+    *offset = recordOffset;
+    return true;
+}
+
+
+bool PGCMappedFileWriterAppendDictionary(PGCMappedFileWriter *writer, PGCArray *keys, PGCArray *objects, uint64_t *offset)
+{
+    uint64_t count = PGCArrayGetCount(keys);
+    if (!keys || !objects || PGCArrayGetCount(objects) != count) return false;
+    
+    PGCMappedFileWriterEntry *entries = count > 0 ? malloc(count * sizeof(PGCMappedFileWriterEntry)) : NULL;
+    if (count > 0 && !entries) return false;
+    
+    // Entries are sorted by their keys’ hashes so that readers can binary search them
+    for (uint64_t i = 0; i < count; i++) {
+        entries[i].key = PGCArrayGetObjectAtIndex(keys, i);
+        entries[i].object = PGCArrayGetObjectAtIndex(objects, i);
+        entries[i].keyHash = PGCHash(entries[i].key);
+    }
+    
+    if (count > 0) qsort(entries, count, sizeof(PGCMappedFileWriterEntry), PGCMappedFileWriterCompareEntries);
+    
+    uint64_t recordOffset = 0;
+    uint64_t entryLength = sizeof(uint64_t) + 2 * sizeof(PGCMappedFileValue);
+    bool encoded = PGCMappedFileWriterReserve(writer, sizeof(uint64_t) + count * entryLength, &recordOffset);
+    if (encoded) memcpy(&writer->bytes[recordOffset], &count, sizeof(uint64_t));
+    
+    uint64_t keyHashesOffset = recordOffset + sizeof(uint64_t);
+    uint64_t keysOffset = keyHashesOffset + count * sizeof(uint64_t);
+    uint64_t objectsOffset = keysOffset + count * sizeof(PGCMappedFileValue);
+    for (uint64_t i = 0; encoded && i < count; i++) {
+        PGCMappedFileValue keyValue;
+        PGCMappedFileValue objectValue;
+        encoded = PGCMappedFileWriterEncodeObject(writer, entries[i].key, &keyValue) && 
+                  PGCMappedFileWriterEncodeObject(writer, entries[i].object, &objectValue);
+        if (!encoded) break;
+        
+        memcpy(&writer->bytes[keyHashesOffset + i * sizeof(uint64_t)], &entries[i].keyHash, sizeof(uint64_t));
+        memcpy(&writer->bytes[keysOffset + i * sizeof(PGCMappedFileValue)], &keyValue, sizeof(PGCMappedFileValue));
+        memcpy(&writer->bytes[objectsOffset + i * sizeof(PGCMappedFileValue)], &objectValue, sizeof(PGCMappedFileValue));
+    }
+    
+    free(entries);
+    *offset = recordOffset;
+    return encoded;
+}
+
+
+int PGCMappedFileWriterCompareEntries(const void *entry1, const void *entry2)
+{
+    uint64_t keyHash1 = ((const PGCMappedFileWriterEntry *)entry1)->keyHash;
+    uint64_t keyHash2 = ((const PGCMappedFileWriterEntry *)entry2)->keyHash;
+    return keyHash1 < keyHash2 ? -1 : keyHash1 > keyHash2;
+}
+
+
+#pragma mark - PGCMappedArray
+
+PGCClass *PGCMappedArrayClass(void)
+{
+    static PGCClass *mappedArrayClass = NULL;
+    if (!mappedArrayClass) {
+        PGCClassFunctions functions = { PGCMappedArrayCopy, PGCMappedArrayDealloc, PGCMappedArrayDescription, PGCMappedArrayEquals,
+                                        PGCMappedArrayHash, NULL, NULL };
+        mappedArrayClass = PGCClassCreate("PGCMappedArray", PGCObjectClass(), functions, sizeof(PGCMappedArray));
+    }
+    return mappedArrayClass;
+}
+
+
+#pragma mark Basic Functions
+
+PGCMappedArray *PGCMappedArrayInitWithRecord(PGCMappedArray *mappedArray, PGCMappedFile *mappedFile, uint64_t offset, uint64_t depth)
+{
+    uint64_t count = 0;
+    const uint8_t *values = PGCMappedFileGetRecordContents(mappedFile, offset, sizeof(PGCMappedFileValue), &count);
+    if (!values) return NULL;
+    
+    if (!mappedArray && (mappedArray = PGCAlloc(PGCMappedArrayClass())) == NULL) return NULL;
+    PGCObjectInit(&mappedArray->super);
+    
+    // Views retain their file so that its pages stay mapped for as long as the view exists
+    mappedArray->mappedFile = PGCRetain(mappedFile);
+    mappedArray->offset = offset;
+    mappedArray->depth = depth;
+    mappedArray->values = (const PGCMappedFileValue *)values;
+    mappedArray->count = count;
+    mappedArray->hash = 0;
+    mappedArray->hashIsValid = false;
+    return mappedArray;
+}
+
+
+void PGCMappedArrayDealloc(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCMappedArrayClass())) return;
+    PGCMappedArray *mappedArray = instance;
+    PGCRelease(mappedArray->mappedFile);
+    PGCSuperclassDealloc(mappedArray);
+}
+
+
+PGCType PGCMappedArrayCopy(PGCType instance)
+{
+    return PGCObjectIsKindOfClass(instance, PGCMappedArrayClass()) ? PGCRetain(instance) : NULL;
+}
+
+
+PGCString *PGCMappedArrayDescription(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCMappedArrayClass())) return NULL;
+    return PGCArrayDescription(PGCMappedArrayGetArray(instance));
+}
+
+
+bool PGCMappedArrayEquals(PGCType instance1, PGCType instance2)
+{
+    if (!PGCObjectIsKindOfClass(instance1, PGCMappedArrayClass()) || !PGCObjectIsKindOfClass(instance2, PGCMappedArrayClass())) return false;
+    
+    PGCMappedArray *mappedArray1 = instance1;
+    PGCMappedArray *mappedArray2 = instance2;
+    if (mappedArray1->values == mappedArray2->values) return true;
+    if (mappedArray1->count != mappedArray2->count) return false;
+    
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+    bool equals = true;
+    for (uint64_t i = 0; equals && i < mappedArray1->count; i++) {
+        equals = PGCEquals(PGCMappedFileGetObjectForValue(mappedArray1->mappedFile, &mappedArray1->values[i], mappedArray1->offset, mappedArray1->depth),
+                           PGCMappedFileGetObjectForValue(mappedArray2->mappedFile, &mappedArray2->values[i], mappedArray2->offset, mappedArray2->depth));
+    }
+    
+    PGCAutoreleasePoolDestroy(pool);
+    return equals;
+}
+
+
+uint64_t PGCMappedArrayHash(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCMappedArrayClass())) return 0;
+    PGCMappedArray *mappedArray = instance;
+    
+    // Mapped arrays hash the same way as the arrays they were written from. They can’t be mutated, so the cached hash never goes stale.
+    if (!mappedArray->hashIsValid) {
+        PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+        uint64_t hash = 0;
+        for (uint64_t i = 0; i < mappedArray->count; i++) {
+            PGCType object = PGCMappedFileGetObjectForValue(mappedArray->mappedFile, &mappedArray->values[i], mappedArray->offset, mappedArray->depth);
+            hash = PGCHashCombine(hash, PGCHash(object));
+        }
+        
+        PGCAutoreleasePoolDestroy(pool);
+        mappedArray->hash = hash;
+        mappedArray->hashIsValid = true;
+    }
+    
+    return mappedArray->hash;
+}
+
+
+#pragma mark Accessors
+
+uint64_t PGCMappedArrayGetCount(PGCMappedArray *mappedArray)
+{
+    return mappedArray ? mappedArray->count : 0;
+}
+
+
+PGCType PGCMappedArrayGetObjectAtIndex(PGCMappedArray *mappedArray, uint64_t index)
+{
+    if (!mappedArray || index >= mappedArray->count) return NULL;
+    return PGCMappedFileGetObjectForValue(mappedArray->mappedFile, &mappedArray->values[index], mappedArray->offset, mappedArray->depth);
+}
+
+
+PGCArray *PGCMappedArrayGetArray(PGCMappedArray *mappedArray)
+{
+    if (!mappedArray) return NULL;
+    // Nested arrays and dictionaries are copied out of the file too, so the result doesn’t depend on the file at all
+    PGCArray *array = PGCArrayInitWithInitialCapacity(NULL, mappedArray->count);
+    for (uint64_t i = 0; array && i < mappedArray->count; i++) {
+        PGCArrayAddObject(array, PGCMappedFileGetUnmappedObjectForValue(mappedArray->mappedFile, &mappedArray->values[i], mappedArray->offset,
+                                                                        mappedArray->depth));
+    }
+    
+    return PGCAutorelease(array);
+}
+
+
+#pragma mark - PGCMappedDictionary
+
+PGCClass *PGCMappedDictionaryClass(void)
+{
+    static PGCClass *mappedDictionaryClass = NULL;
+    if (!mappedDictionaryClass) {
+        PGCClassFunctions functions = { PGCMappedDictionaryCopy, PGCMappedDictionaryDealloc, PGCMappedDictionaryDescription, 
+                                        PGCMappedDictionaryEquals, PGCMappedDictionaryHash, NULL, NULL };
+        mappedDictionaryClass = PGCClassCreate("PGCMappedDictionary", PGCObjectClass(), functions, sizeof(PGCMappedDictionary));
+    }
+    return mappedDictionaryClass;
+}
+
+
+#pragma mark Basic Functions
+
+PGCMappedDictionary *PGCMappedDictionaryInitWithRecord(PGCMappedDictionary *mappedDictionary, PGCMappedFile *mappedFile, uint64_t offset,
+                                                       uint64_t depth)
+{
+    uint64_t count = 0;
+    uint64_t entryLength = sizeof(uint64_t) + 2 * sizeof(PGCMappedFileValue);
+    const uint8_t *contents = PGCMappedFileGetRecordContents(mappedFile, offset, entryLength, &count);
+    if (!contents) return NULL;
+    
+    if (!mappedDictionary && (mappedDictionary = PGCAlloc(PGCMappedDictionaryClass())) == NULL) return NULL;
+    PGCObjectInit(&mappedDictionary->super);
+    
+    mappedDictionary->mappedFile = PGCRetain(mappedFile);
+    mappedDictionary->offset = offset;
+    mappedDictionary->depth = depth;
+    mappedDictionary->count = count;
+    mappedDictionary->keyHashes = (const uint64_t *)contents;
+    mappedDictionary->keys = (const PGCMappedFileValue *)&mappedDictionary->keyHashes[count];
+    mappedDictionary->objects = &mappedDictionary->keys[count];
+    mappedDictionary->hash = 0;
+    mappedDictionary->hashIsValid = false;
+    return mappedDictionary;
+}
+
+
+void PGCMappedDictionaryDealloc(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCMappedDictionaryClass())) return;
+    PGCMappedDictionary *mappedDictionary = instance;
+    PGCRelease(mappedDictionary->mappedFile);
+    PGCSuperclassDealloc(mappedDictionary);
+}
+
+
+PGCType PGCMappedDictionaryCopy(PGCType instance)
+{
+    return PGCObjectIsKindOfClass(instance, PGCMappedDictionaryClass()) ? PGCRetain(instance) : NULL;
+}
+
+
+PGCString *PGCMappedDictionaryDescription(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCMappedDictionaryClass())) return NULL;
+    PGCMappedDictionary *mappedDictionary = instance;
+    
+    PGCString *description = PGCStringInstanceWithCString("{");
+    for (uint64_t i = 0; i < mappedDictionary->count; i++) {
+        PGCType key = PGCMappedFileGetObjectForValue(mappedDictionary->mappedFile, &mappedDictionary->keys[i], mappedDictionary->offset,
+                                                     mappedDictionary->depth);
+        PGCType object = PGCMappedFileGetObjectForValue(mappedDictionary->mappedFile, &mappedDictionary->objects[i], mappedDictionary->offset,
+                                                        mappedDictionary->depth);
+        PGCStringAppendFormat(description, i == 0 ? "%s = %s" : ", %s = %s", PGCDescriptionCString(key), PGCDescriptionCString(object));
+    }
+    
+    PGCStringAppendFormat(description, "}");
+    return description;
+}
+
+
+bool PGCMappedDictionaryEquals(PGCType instance1, PGCType instance2)
+{
+    if (!PGCObjectIsKindOfClass(instance1, PGCMappedDictionaryClass()) || !PGCObjectIsKindOfClass(instance2, PGCMappedDictionaryClass())) {
+        return false;
+    }
+    
+    PGCMappedDictionary *mappedDictionary1 = instance1;
+    PGCMappedDictionary *mappedDictionary2 = instance2;
+    if (mappedDictionary1->keyHashes == mappedDictionary2->keyHashes) return true;
+    if (mappedDictionary1->count != mappedDictionary2->count) return false;
+    
+    // Look up each of the first dictionary’s keys in the second and compare the objects they map to
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+    bool equals = true;
+    for (uint64_t i = 0; equals && i < mappedDictionary1->count; i++) {
+        PGCType key = PGCMappedFileGetObjectForValue(mappedDictionary1->mappedFile, &mappedDictionary1->keys[i], mappedDictionary1->offset,
+                                                     mappedDictionary1->depth);
+        uint64_t index = PGCMappedDictionaryGetIndexOfKey(mappedDictionary2, key);
+        equals = index != PGCNotFound &&
+                 PGCEquals(PGCMappedFileGetObjectForValue(mappedDictionary1->mappedFile, &mappedDictionary1->objects[i], mappedDictionary1->offset,
+                                                          mappedDictionary1->depth),
+                           PGCMappedFileGetObjectForValue(mappedDictionary2->mappedFile, &mappedDictionary2->objects[index],
+                                                          mappedDictionary2->offset, mappedDictionary2->depth));
+    }
+    
+    PGCAutoreleasePoolDestroy(pool);
+    return equals;
+}
+
+
+uint64_t PGCMappedDictionaryHash(PGCType instance)
+{
+    if (!PGCObjectIsKindOfClass(instance, PGCMappedDictionaryClass())) return 0;
+    PGCMappedDictionary *mappedDictionary = instance;
+    
+    // Like PGCDictionaryHash, sum the mixed hashes of the entries. Keys’ hashes were stored when the file was written.
+    if (!mappedDictionary->hashIsValid) {
+        PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+        uint64_t hash = 0;
+        for (uint64_t i = 0; i < mappedDictionary->count; i++) {
+            PGCType object = PGCMappedFileGetObjectForValue(mappedDictionary->mappedFile, &mappedDictionary->objects[i], mappedDictionary->offset,
+                                                            mappedDictionary->depth);
+            hash += PGCHashMix(PGCHashCombine(mappedDictionary->keyHashes[i], PGCHash(object)));
+        }
+        
+        PGCAutoreleasePoolDestroy(pool);
+        mappedDictionary->hash = hash;
+        mappedDictionary->hashIsValid = true;
+    }
+    
+    return mappedDictionary->hash;
+}
+
+
+#pragma mark Accessors
+
+uint64_t PGCMappedDictionaryGetCount(PGCMappedDictionary *mappedDictionary)
+{
+    return mappedDictionary ? mappedDictionary->count : 0;
+}
+
+
+PGCType PGCMappedDictionaryGetObjectForKey(PGCMappedDictionary *mappedDictionary, PGCType key)
+{
+    uint64_t index = PGCMappedDictionaryGetIndexOfKey(mappedDictionary, key);
+    if (index == PGCNotFound) return NULL;
+    return PGCMappedFileGetObjectForValue(mappedDictionary->mappedFile, &mappedDictionary->objects[index], mappedDictionary->offset,
+                                          mappedDictionary->depth);
+}
+
+
+bool PGCMappedDictionaryContainsKey(PGCMappedDictionary *mappedDictionary, PGCType key)
+{
+    return PGCMappedDictionaryGetIndexOfKey(mappedDictionary, key) != PGCNotFound;
+}
+
+
+PGCArray *PGCMappedDictionaryGetAllKeys(PGCMappedDictionary *mappedDictionary)
+{
+    if (!mappedDictionary) return NULL;
+    PGCArray *allKeys = PGCArrayInitWithInitialCapacity(NULL, mappedDictionary->count);
+    for (uint64_t i = 0; allKeys && i < mappedDictionary->count; i++) {
+        PGCArrayAddObject(allKeys, PGCMappedFileGetObjectForValue(mappedDictionary->mappedFile, &mappedDictionary->keys[i], mappedDictionary->offset,
+                                                                  mappedDictionary->depth));
+    }
+    
+    return PGCAutorelease(allKeys);
+}
+
+
+PGCArray *PGCMappedDictionaryGetAllObjects(PGCMappedDictionary *mappedDictionary)
+{
+    if (!mappedDictionary) return NULL;
+    PGCArray *allObjects = PGCArrayInitWithInitialCapacity(NULL, mappedDictionary->count);
+    for (uint64_t i = 0; allObjects && i < mappedDictionary->count; i++) {
+        PGCArrayAddObject(allObjects, PGCMappedFileGetObjectForValue(mappedDictionary->mappedFile, &mappedDictionary->objects[i],
+                                                                     mappedDictionary->offset, mappedDictionary->depth));
+    }
+    
+    return PGCAutorelease(allObjects);
+}
+
+
+PGCDictionary *PGCMappedDictionaryGetDictionary(PGCMappedDictionary *mappedDictionary)
+{
+    if (!mappedDictionary) return NULL;
+    PGCDictionary *dictionary = PGCDictionaryInit(NULL);
+    for (uint64_t i = 0; dictionary && i < mappedDictionary->count; i++) {
+        PGCDictionarySetObjectForKey(dictionary, PGCMappedFileGetUnmappedObjectForValue(mappedDictionary->mappedFile, &mappedDictionary->objects[i],
+                                                                                        mappedDictionary->offset, mappedDictionary->depth),
+                                     PGCMappedFileGetUnmappedObjectForValue(mappedDictionary->mappedFile, &mappedDictionary->keys[i],
+                                                                            mappedDictionary->offset, mappedDictionary->depth));
+    }
+    
+    return PGCAutorelease(dictionary);
+}
+
+
+uint64_t PGCMappedDictionaryGetIndexOfKey(PGCMappedDictionary *mappedDictionary, PGCType key)
+{
+    if (!mappedDictionary || !key) return PGCNotFound;
+    
+    // Binary search the hashes in place, then compare key with each key that has its hash
+    uint64_t keyHash = PGCHash(key);
+    uint64_t base = 0;
+    uint64_t length = mappedDictionary->count;
+    while (length > 0) {
+        uint64_t half = length / 2;
+        if (mappedDictionary->keyHashes[base + half] < keyHash) {
+            base += half + 1;
+            length -= half + 1;
+        } else {
+            length = half;
+        }
+    }
+    
+    for (uint64_t i = base; i < mappedDictionary->count && mappedDictionary->keyHashes[i] == keyHash; i++) {
+        if (PGCMappedFileValueEqualsObject(mappedDictionary->mappedFile, &mappedDictionary->keys[i], mappedDictionary->offset,
+                                           mappedDictionary->depth, key)) {
+            return i;
+        }
+    }
+    
+    return PGCNotFound;
+}
@@ -0,0 +1,100 @@
+//
+//  PGCMappedFile.h
+//  PGCFoundation
+//
+//  Created by Prachi Gauriar on 10/19/2026.
+//  Copyright (c) 2026 Prachi Gauriar.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#ifndef PGCMAPPEDFILE_H
+#define PGCMAPPEDFILE_H
+
+#include <PGCFoundation/PGCObject.h>
+#include <PGCFoundation/PGCArray.h>
+#include <PGCFoundation/PGCDictionary.h>
+#include <PGCFoundation/PGCString.h>
+
+#pragma mark - PGCMappedFile
+
+typedef struct _PGCMappedFile PGCMappedFile;
+
+extern PGCClass *PGCMappedFileClass(void);
+extern PGCMappedFile *PGCMappedFileInstanceWithPath(const char *path);
+
+#pragma mark Basic Functions
+
+extern PGCMappedFile *PGCMappedFileInitWithPath(PGCMappedFile *mappedFile, const char *path);
+
+extern PGCType PGCMappedFileCopy(PGCType instance);
+extern PGCString *PGCMappedFileDescription(PGCType instance);
+
+#pragma mark Accessors
+
+extern uint64_t PGCMappedFileGetSize(PGCMappedFile *mappedFile);
+extern PGCType PGCMappedFileGetRootObject(PGCMappedFile *mappedFile);
+
+#pragma mark Writing
+
+extern bool PGCMappedFileWriteObjectToPath(PGCType object, const char *path);
+
+#pragma mark - PGCMappedArray
+
+typedef struct _PGCMappedArray PGCMappedArray;
+
+extern PGCClass *PGCMappedArrayClass(void);
+
+#pragma mark Basic Functions
+
+extern PGCType PGCMappedArrayCopy(PGCType instance);
+extern PGCString *PGCMappedArrayDescription(PGCType instance);
+extern bool PGCMappedArrayEquals(PGCType instance1, PGCType instance2);
+extern uint64_t PGCMappedArrayHash(PGCType instance);
+
+#pragma mark Accessors
+
+extern uint64_t PGCMappedArrayGetCount(PGCMappedArray *mappedArray);
+extern PGCType PGCMappedArrayGetObjectAtIndex(PGCMappedArray *mappedArray, uint64_t index);
+extern PGCArray *PGCMappedArrayGetArray(PGCMappedArray *mappedArray);
+
+#pragma mark - PGCMappedDictionary
+
+typedef struct _PGCMappedDictionary PGCMappedDictionary;
+
+extern PGCClass *PGCMappedDictionaryClass(void);
+
+#pragma mark Basic Functions
+
+extern PGCType PGCMappedDictionaryCopy(PGCType instance);
+extern PGCString *PGCMappedDictionaryDescription(PGCType instance);
+extern bool PGCMappedDictionaryEquals(PGCType instance1, PGCType instance2);
+extern uint64_t PGCMappedDictionaryHash(PGCType instance);
+
+#pragma mark Accessors
+
+extern uint64_t PGCMappedDictionaryGetCount(PGCMappedDictionary *mappedDictionary);
+extern PGCType PGCMappedDictionaryGetObjectForKey(PGCMappedDictionary *mappedDictionary, PGCType key);
+extern bool PGCMappedDictionaryContainsKey(PGCMappedDictionary *mappedDictionary, PGCType key);
+
+extern PGCArray *PGCMappedDictionaryGetAllKeys(PGCMappedDictionary *mappedDictionary);
+extern PGCArray *PGCMappedDictionaryGetAllObjects(PGCMappedDictionary *mappedDictionary);
+extern PGCDictionary *PGCMappedDictionaryGetDictionary(PGCMappedDictionary *mappedDictionary);
+
+#endif
@@ -25,16 +25,48 @@
 //
 
 #include <PGCFoundation/PGCFoundation.h>
+#include <math.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/resource.h>
 #include <time.h>
 #include <unistd.h>
 
 void TestArrays(void);
 void TestArrayEnumeration(void);
+void TestArrayGrowth(void);
+void TestArrayAsDeque(uint64_t operationCount);
+void TestArrayRangeOperations(uint64_t operationCount);
+void TestArrayCopyIsolation(uint64_t operationCount);
+void TestArraySorting(uint64_t count);
+void TestArraySortedSearch(uint64_t count);
+void TestCachedObjectHashes(uint64_t operationCount);
+void TestIdenticalObjectSearch(void);
+void TestNumericArrays(uint64_t maximumCount);
 void TestDictionaries(void);
+void TestStaticDictionaries(void);
+void TestFrozenCollections(uint64_t count);
+void TestLists(void);
+void TestContentHashing(void);
 void TestStrings(void);
+void TestJSONWriting(void);
+void TestMappedFiles(uint64_t corruptionCount);
+void TestAutoreleasePoolTeardown(void);
+void TestConcurrentQueue(uint64_t threadCount, uint64_t objectCount);
+void TestListNodeRecycling(uint64_t listCount, uint64_t objectCount);
+void BenchmarkArchiving(uint64_t recordCount);
+void BenchmarkJSONReading(uint64_t recordCount);
+void BenchmarkJSONWriting(uint64_t recordCount);
+void BenchmarkListQueue(uint64_t operationCount, uint64_t nodeCapacity);
+void BenchmarkListTraversal(uint64_t objectCount);
+void BenchmarkListSplicing(uint64_t objectCount, uint64_t operationCount);
+void BenchmarkListRandomEditing(uint64_t objectCount, uint64_t operationCount, bool indexed);
+void BenchmarkConcurrentQueue(uint64_t threadCount, uint64_t objectCount);
+void BenchmarkAutorelease(uint64_t threadCount, uint64_t objectCount);
+void BenchmarkAutoreleasePoolDraining(uint64_t iterationCount, uint64_t objectCount);
+void BenchmarkDeallocation(uint64_t depth, uint64_t timeSlice);
 
 void GenerateGroups(const char *filename, uint64_t groupCount);
 char *GetLineFromFile(FILE *file);
@@ -51,13 +83,104 @@ int main(int argc, const char * argv[])
     
     printf("Testing arrays...");
     TestArrays();
+
+    printf("\nTesting array growth...\n");
+    TestArrayGrowth();
+
+    printf("\nTesting arrays as deques...\n");
+    TestArrayAsDeque(100000);
+
+    printf("\nTesting array range operations...\n");
+    TestArrayRangeOperations(2000);
+
+    printf("\nTesting array copy isolation...\n");
+    TestArrayCopyIsolation(2000);
+
+    printf("\nTesting array sorting...\n");
+    TestArraySorting(200000);
+
+    printf("\nTesting sorted array searches...\n");
+    TestArraySortedSearch(2000);
+
+    printf("\nTesting cached object hashes...\n");
+    TestCachedObjectHashes(20000);
+
+    printf("\nTesting identical object searches...\n");
+    TestIdenticalObjectSearch();
+
+    printf("\nTesting integer and decimal arrays...\n");
+    TestNumericArrays(40);
     
     printf("\nTesting dictionaries...\n");
     TestDictionaries();
 
+    printf("\nTesting static dictionaries...\n");
+    TestStaticDictionaries();
+
+    printf("\nTesting frozen collections...\n");
+    TestFrozenCollections(1000);
+
+    printf("\nTesting lists...\n");
+    TestLists();
+
+    printf("\nTesting content hashing...\n");
+    TestContentHashing();
+
     printf("\nTesting strings...\n");
     TestStrings();
 
+    printf("\nTesting JSON writing...\n");
+    TestJSONWriting();
+
+    printf("\nTesting mapped files...\n");
+    TestMappedFiles(2000);
+
+    printf("\nTesting autorelease pool teardown...\n");
+    TestAutoreleasePoolTeardown();
+
+    printf("\nTesting concurrent queues...\n");
+    TestConcurrentQueue(4, 100000);
+
+    printf("\nTesting list node recycling across threads...\n");
+    TestListNodeRecycling(4000, 1000);
+
+    printf("\nBenchmarking archiving...\n");
+    BenchmarkArchiving(100000);
+
+    printf("\nBenchmarking JSON reading...\n");
+    BenchmarkJSONReading(100000);
+
+    printf("\nBenchmarking JSON writing...\n");
+    BenchmarkJSONWriting(100000);
+
+    printf("\nBenchmarking lists as queues...\n");
+    BenchmarkListQueue(10000000, 1);
+    BenchmarkListQueue(10000000, 32);
+
+    printf("\nBenchmarking list traversal...\n");
+    BenchmarkListTraversal(20000);
+
+    printf("\nBenchmarking list splicing...\n");
+    BenchmarkListSplicing(1000000, 1000);
+
+    printf("\nBenchmarking random list edits...\n");
+    BenchmarkListRandomEditing(100000, 100000, false);
+    BenchmarkListRandomEditing(100000, 100000, true);
+
+    printf("\nBenchmarking concurrent queues...\n");
+    BenchmarkConcurrentQueue(1, 1000000);
+    BenchmarkConcurrentQueue(2, 1000000);
+    BenchmarkConcurrentQueue(4, 1000000);
+
+    printf("\nBenchmarking autorelease...\n");
+    BenchmarkAutorelease(1, 10000000);
+    BenchmarkAutorelease(4, 10000000);
+    BenchmarkAutoreleasePoolDraining(1000000, 4);
+
+    printf("\nBenchmarking deallocation...\n");
+    BenchmarkDeallocation(1000000, 0);
+    BenchmarkDeallocation(1000000, 1000000);
+
     printf("\nGenerating groups...\n");
     GenerateGroups("/Users/prachi/Developer/Ruby/GroupCreator/FullClass.txt", 7);
 
@@ -144,6 +267,655 @@ void TestArrayEnumeration(void)
 }
 
 
+void TestArrayGrowth(void)
+{
+    // Growing geometrically means the capacity changes a logarithmic number of times as objects are appended
+    PGCArray *array = PGCArrayInitWithInitialCapacity(NULL, 1);
+    PGCArraySetGrowthFactor(array, 2.0);
+    uint64_t growthCount = 0;
+    uint64_t capacity = PGCArrayGetCapacity(array);
+    for (uint64_t i = 0; i < 100000; i++) {
+        PGCArrayAddObject(array, PGCNullInstance());
+        if (PGCArrayGetCapacity(array) != capacity) growthCount++;
+        capacity = PGCArrayGetCapacity(array);
+    }
+    
+    printf("Appending 100000 objects grew an array %llu times to a capacity of %llu%s\n", growthCount, capacity,
+           growthCount <= 20 && capacity >= 100000 && capacity < 200000 ? "" : " (FAILED)");
+    
+    PGCArraySetGrowthFactor(array, 0.5);
+    printf("Setting a growth factor below 1 %s\n", PGCArrayGetGrowthFactor(array) == 2.0 ? "was ignored" : "was accepted (FAILED)");
+    
+    PGCArrayCondense(array);
+    printf("Condensing an array left it with a capacity of %llu%s\n", PGCArrayGetCapacity(array),
+           PGCArrayGetCapacity(array) == PGCArrayGetCount(array) ? "" : " (FAILED)");
+    
+    PGCArrayReserveCapacity(array, 300000);
+    printf("Reserving capacity left an array with a capacity of %llu and %llu objects%s\n", PGCArrayGetCapacity(array),
+           PGCArrayGetCount(array), PGCArrayGetCapacity(array) == 300000 && PGCArrayGetCount(array) == 100000 ? "" : " (FAILED)");
+    PGCRelease(array);
+}
+
+
+void TestArrayAsDeque(uint64_t operationCount)
+{
+    // Push and pop random objects at both ends of an array and of a plain C array big enough that it never runs out of room
+    // at either end, and make sure they always agree
+    PGCArray *array = PGCArrayInstance();
+    PGCType *expectedObjects = calloc(2 * operationCount, sizeof(PGCType));
+    if (!expectedObjects) return;
+    uint64_t expectedStart = operationCount;
+    uint64_t expectedEnd = operationCount;
+    
+    PGCType integers[16];
+    for (uint64_t i = 0; i < 16; i++) integers[i] = PGCIntegerInstanceWithUnsignedValue(i);
+    
+    uint64_t mismatchCount = 0;
+    for (uint64_t i = 0; i < operationCount; i++) {
+        PGCType object = integers[random() % 16];
+        switch (random() % 4) {
+            case 0:
+                PGCArrayPushObject(array, object);
+                expectedObjects[--expectedStart] = object;
+                break;
+            case 1:
+                PGCArrayAddObject(array, object);
+                expectedObjects[expectedEnd++] = object;
+                break;
+            case 2:
+                if (PGCArrayPopObject(array) != (expectedStart < expectedEnd ? expectedObjects[expectedStart++] : NULL)) mismatchCount++;
+                break;
+            case 3:
+                if (PGCArrayPopLastObject(array) != (expectedStart < expectedEnd ? expectedObjects[--expectedEnd] : NULL)) mismatchCount++;
+                break;
+        }
+    }
+    
+    if (PGCArrayGetCount(array) != expectedEnd - expectedStart) mismatchCount++;
+    for (uint64_t i = 0; i < PGCArrayGetCount(array) && i < expectedEnd - expectedStart; i++) {
+        if (PGCArrayGetObjectAtIndex(array, i) != expectedObjects[expectedStart + i]) mismatchCount++;
+    }
+    
+    printf("After %llu pushes and pops at both ends, an array had %llu mismatches%s\n", operationCount, mismatchCount,
+           mismatchCount == 0 ? "" : " (FAILED)");
+    free(expectedObjects);
+}
+
+
+void TestArrayRangeOperations(uint64_t operationCount)
+{
+    // Apply random range insertions, removals, and replacements to an array and to a plain C array and make sure they agree.
+    // The replacement objects sometimes come from the array itself.
+    PGCArray *array = PGCArrayInstance();
+    uint64_t expectedCapacity = 4096;
+    PGCType *expectedObjects = calloc(expectedCapacity, sizeof(PGCType));
+    PGCType *replacementObjects = calloc(expectedCapacity, sizeof(PGCType));
+    if (!expectedObjects || !replacementObjects) {
+        free(expectedObjects);
+        free(replacementObjects);
+        return;
+    }
+    
+    uint64_t expectedCount = 0;
+    uint64_t mismatchCount = 0;
+    for (uint64_t i = 0; i < operationCount; i++) {
+        uint64_t location = random() % (expectedCount + 1);
+        uint64_t length = random() % (expectedCount - location + 1);
+        
+        PGCArray *replacementArray = NULL;
+        uint64_t replacementCount = 0;
+        if (random() % 4 == 0) {
+            replacementArray = array;
+            replacementCount = expectedCount;
+            memcpy(replacementObjects, expectedObjects, expectedCount * sizeof(PGCType));
+        } else {
+            replacementArray = PGCArrayInstance();
+            replacementCount = random() % 8;
+            for (uint64_t j = 0; j < replacementCount; j++) {
+                replacementObjects[j] = PGCIntegerInstanceWithUnsignedValue(i * 8 + j);
+                PGCArrayAddObject(replacementArray, replacementObjects[j]);
+            }
+        }
+        
+        if (expectedCount - length + replacementCount > expectedCapacity) {
+            replacementArray = NULL;
+            replacementCount = 0;
+        }
+        
+        switch (random() % 3) {
+            case 0:
+                PGCArrayInsertObjectsFromArrayAtIndex(array, replacementArray, location);
+                length = 0;
+                break;
+            case 1:
+                PGCArrayRemoveObjectsInRange(array, PGCMakeRange(location, length));
+                replacementCount = 0;
+                break;
+            case 2:
+                PGCArrayReplaceObjectsInRange(array, PGCMakeRange(location, length), replacementArray);
+                break;
+        }
+        
+        memmove(&expectedObjects[location + replacementCount], &expectedObjects[location + length],
+                (expectedCount - location - length) * sizeof(PGCType));
+        memcpy(&expectedObjects[location], replacementObjects, replacementCount * sizeof(PGCType));
+        expectedCount = expectedCount - length + replacementCount;
+        
+        if (PGCArrayGetCount(array) != expectedCount) {
+            mismatchCount++;
+            break;
+        }
+        
+        for (uint64_t j = 0; j < expectedCount; j++) {
+            if (PGCArrayGetObjectAtIndex(array, j) != expectedObjects[j]) mismatchCount++;
+        }
+    }
+    
+    printf("After %llu range operations, an array had %llu mismatches%s\n", operationCount, mismatchCount, mismatchCount == 0 ? "" : " (FAILED)");
+    
+    // Ranges that extend past the end of the array are ignored
+    PGCArray *nullArray = PGCArrayInstance();
+    PGCArrayAddObject(nullArray, PGCNullInstance());
+    uint64_t count = PGCArrayGetCount(array);
+    PGCArrayRemoveObjectsInRange(array, PGCMakeRange(count, 1));
+    PGCArrayReplaceObjectsInRange(array, PGCMakeRange(1, count), nullArray);
+    PGCArrayInsertObjectsFromArrayAtIndex(array, nullArray, count + 1);
+    printf("Out-of-bounds range operations %s\n", PGCArrayGetCount(array) == count && !PGCArrayContainsObject(array, PGCNullInstance()) ?
+           "were ignored" : "changed the array (FAILED)");
+    
+    free(expectedObjects);
+    free(replacementObjects);
+}
+
+
+void TestArrayCopyIsolation(uint64_t operationCount)
+{
+    // Each operation copies an array, or takes a large subarray of it, and mutates either the original or the copy. The other
+    // side must be unchanged, and the mutated side must match an unshared array that had the same mutation applied.
+    enum { objectCount = 64 };
+    PGCType objects[objectCount];
+    PGCArray *array = PGCArrayInit(NULL);
+    for (uint64_t i = 0; i < objectCount; i++) {
+        objects[i] = PGCStringInitWithFormat(NULL, "%llu", i);
+        PGCArrayAddObject(array, objects[i]);
+        PGCRelease(objects[i]);
+    }
+    
+    PGCType newObject = PGCStringInitWithCString(NULL, "new");
+    uint64_t mismatchCount = 0;
+    for (uint64_t i = 0; i < operationCount; i++) {
+        PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+        PGCRange range = i % 2 ? PGCMakeRange(random() % (objectCount / 2), objectCount / 2) : PGCMakeRange(0, objectCount);
+        PGCArray *copy = i % 2 ? PGCArraySubarrayWithRange(array, range) : PGCAutorelease(PGCArrayCopy(array));
+        
+        PGCArray *unsharedArray = PGCArrayInstance();
+        for (uint64_t j = range.location; j < range.location + range.length; j++) PGCArrayAddObject(unsharedArray, objects[j]);
+        
+        // Mutate the copy on even operations and the original on odd ones, restoring the original afterwards
+        bool mutatesCopy = (i / 2) % 2 == 0;
+        PGCArray *mutatedArray = mutatesCopy ? copy : array;
+        if (!mutatesCopy) {
+            PGCArrayRemoveAllObjects(unsharedArray);
+            for (uint64_t j = 0; j < objectCount; j++) PGCArrayAddObject(unsharedArray, objects[j]);
+        }
+        
+        uint64_t index = random() % range.length;
+        uint64_t otherIndex = random() % range.length;
+        uint64_t removalLength = 1 + random() % (range.length - index);
+        PGCArray *targets[2] = { mutatedArray, unsharedArray };
+        for (uint64_t j = 0; j < 2; j++) {
+            switch ((i / 4) % 8) {
+                case 0:
+                    PGCArrayAddObject(targets[j], newObject);
+                    break;
+                case 1:
+                    PGCArrayPushObject(targets[j], newObject);
+                    break;
+                case 2:
+                    PGCArrayReplaceObjectAtIndex(targets[j], newObject, index);
+                    break;
+                case 3:
+                    PGCArrayRemoveObjectAtIndex(targets[j], index);
+                    break;
+                case 4:
+                    PGCArrayExchangeValuesAtIndices(targets[j], index, otherIndex);
+                    break;
+                case 5:
+                    PGCArrayRemoveObjectsInRange(targets[j], PGCMakeRange(index, removalLength));
+                    break;
+                case 6:
+                    PGCArrayPopLastObject(targets[j]);
+                    break;
+                case 7:
+                    PGCArrayRemoveAllObjects(targets[j]);
+                    break;
+            }
+        }
+        
+        bool mutatedArrayMatches = PGCArrayGetCount(mutatedArray) == PGCArrayGetCount(unsharedArray);
+        for (uint64_t j = 0; mutatedArrayMatches && j < PGCArrayGetCount(mutatedArray); j++) {
+            mutatedArrayMatches = PGCArrayGetObjectAtIndex(mutatedArray, j) == PGCArrayGetObjectAtIndex(unsharedArray, j);
+        }
+        
+        bool otherArrayUnchanged = true;
+        if (mutatesCopy) {
+            otherArrayUnchanged = PGCArrayGetCount(array) == objectCount;
+            for (uint64_t j = 0; otherArrayUnchanged && j < objectCount; j++) {
+                otherArrayUnchanged = PGCArrayGetObjectAtIndex(array, j) == objects[j];
+            }
+        } else {
+            otherArrayUnchanged = PGCArrayGetCount(copy) == range.length;
+            for (uint64_t j = 0; otherArrayUnchanged && j < range.length; j++) {
+                otherArrayUnchanged = PGCArrayGetObjectAtIndex(copy, j) == objects[range.location + j];
+            }
+            
+            PGCArrayRemoveAllObjects(array);
+            for (uint64_t j = 0; j < objectCount; j++) PGCArrayAddObject(array, objects[j]);
+        }
+        
+        if (!mutatedArrayMatches || !otherArrayUnchanged) mismatchCount++;
+        PGCAutoreleasePoolDestroy(pool);
+    }
+    
+    printf("After %llu mutations of shared arrays, %llu mutations were visible through the other array%s\n", operationCount,
+           mismatchCount, mismatchCount == 0 ? "" : " (FAILED)");
+    
+    // Once every copy is gone, the original must be the objects’ only owner again
+    uint64_t overRetainedCount = 0;
+    for (uint64_t i = 0; i < objectCount; i++) {
+        if (((PGCObject *)objects[i])->retainCount != 1) overRetainedCount++;
+    }
+    
+    printf("After its copies were released, %llu of the array’s objects had extra retains%s\n", overRetainedCount,
+           overRetainedCount == 0 ? "" : " (FAILED)");
+    
+    // A subarray that outlives its array takes over the shared storage when it’s mutated, releasing the objects outside it
+    PGCRetain(objects[0]);
+    PGCRetain(objects[objectCount - 1]);
+    PGCArray *subarray = PGCRetain(PGCArraySubarrayWithRange(array, PGCMakeRange(0, objectCount / 2)));
+    PGCRelease(array);
+    PGCArrayAddObject(subarray, newObject);
+    printf("Mutating a subarray after releasing its array %s\n",
+           ((PGCObject *)objects[0])->retainCount == 2 && ((PGCObject *)objects[objectCount - 1])->retainCount == 1 ?
+           "released the objects outside the subarray" : "did not release the objects outside the subarray (FAILED)");
+    
+    PGCRelease(subarray);
+    PGCRelease(objects[0]);
+    PGCRelease(objects[objectCount - 1]);
+    PGCRelease(newObject);
+}
+
+
+void TestArraySorting(uint64_t count)
+{
+    PGCComparator compareIntegers = ^PGCComparisonResult(PGCType object1, PGCType object2) {
+        int64_t value1 = PGCIntegerGetSignedValue(object1);
+        int64_t value2 = PGCIntegerGetSignedValue(object2);
+        return value1 < value2 ? PGCOrderedAscending : (value1 > value2 ? PGCOrderedDescending : PGCOrderedSame);
+    };
+    
+    // Each object is a distinct instance with one of only a few values, so that stability can be checked by identity
+    PGCArray *unsortedArray = PGCArrayInitWithInitialCapacity(NULL, count);
+    int64_t valueSum = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        int64_t value = random() % 8;
+        PGCArrayAddObject(unsortedArray, PGCIntegerInstanceWithSignedValue(value));
+        valueSum += value;
+    }
+    
+    PGCSortOptions optionSets[] = { 0, PGCSortStable, PGCSortConcurrent, PGCSortConcurrent | PGCSortStable };
+    const char *optionSetNames[] = { "Unstable", "Stable", "Concurrent", "Concurrent stable" };
+    for (uint64_t i = 0; i < sizeof(optionSets) / sizeof(optionSets[0]); i++) {
+        PGCArray *array = PGCArrayCopy(unsortedArray);
+        PGCArraySortWithOptionsUsingComparator(array, optionSets[i], compareIntegers);
+        
+        bool isSorted = PGCArrayGetCount(array) == count;
+        int64_t sortedValueSum = 0;
+        for (uint64_t j = 0; isSorted && j < count; j++) {
+            sortedValueSum += PGCIntegerGetSignedValue(PGCArrayGetObjectAtIndex(array, j));
+            isSorted = j == 0 || compareIntegers(PGCArrayGetObjectAtIndex(array, j - 1), PGCArrayGetObjectAtIndex(array, j)) != PGCOrderedDescending;
+        }
+        
+        // In a stable sort, the objects with each value appear in the same order as they did before sorting
+        bool isStable = true;
+        if (optionSets[i] & PGCSortStable) {
+            uint64_t sortedIndex = 0;
+            for (int64_t value = 0; isStable && value < 8; value++) {
+                for (uint64_t j = 0; isStable && j < count; j++) {
+                    PGCType object = PGCArrayGetObjectAtIndex(unsortedArray, j);
+                    if (PGCIntegerGetSignedValue(object) == value) isStable = PGCArrayGetObjectAtIndex(array, sortedIndex++) == object;
+                }
+            }
+        }
+        
+        printf("%s sort of %llu objects %s\n", optionSetNames[i], count, isSorted && sortedValueSum == valueSum && isStable ?
+               "succeeded" : "failed (FAILED)");
+        PGCRelease(array);
+    }
+    
+    // Sorting with a descriptor is always stable
+    PGCArray *array = PGCArrayCopy(unsortedArray);
+    PGCArraySortUsingDescriptor(array, PGCSortDescriptorNumericDescending);
+    bool isSorted = true;
+    uint64_t sortedIndex = 0;
+    for (int64_t value = 7; isSorted && value >= 0; value--) {
+        for (uint64_t j = 0; isSorted && j < count; j++) {
+            PGCType object = PGCArrayGetObjectAtIndex(unsortedArray, j);
+            if (PGCIntegerGetSignedValue(object) == value) isSorted = PGCArrayGetObjectAtIndex(array, sortedIndex++) == object;
+        }
+    }
+    
+    printf("Descending sort with a descriptor %s\n", isSorted ? "succeeded" : "failed (FAILED)");
+    PGCRelease(array);
+    PGCRelease(unsortedArray);
+}
+
+
+void TestArraySortedSearch(uint64_t count)
+{
+    PGCComparator compareIntegers = ^PGCComparisonResult(PGCType object1, PGCType object2) {
+        int64_t value1 = PGCIntegerGetSignedValue(object1);
+        int64_t value2 = PGCIntegerGetSignedValue(object2);
+        return value1 < value2 ? PGCOrderedAscending : (value1 > value2 ? PGCOrderedDescending : PGCOrderedSame);
+    };
+    
+    // Inserting after equal objects keeps equal objects in insertion order
+    PGCArray *array = PGCArrayInstance();
+    bool insertionsSucceeded = true;
+    for (uint64_t i = 0; i < count; i++) {
+        PGCInteger *integer = PGCIntegerInstanceWithSignedValue(random() % (count / 4 + 1));
+        uint64_t index = PGCArrayInsertObjectSorted(array, integer, compareIntegers);
+        insertionsSucceeded = insertionsSucceeded && index != PGCNotFound && PGCArrayGetObjectAtIndex(array, index) == integer &&
+                              (index + 1 == PGCArrayGetCount(array) ||
+                               compareIntegers(integer, PGCArrayGetObjectAtIndex(array, index + 1)) == PGCOrderedAscending);
+    }
+    
+    for (uint64_t i = 1; insertionsSucceeded && i < count; i++) {
+        insertionsSucceeded = compareIntegers(PGCArrayGetObjectAtIndex(array, i - 1), PGCArrayGetObjectAtIndex(array, i)) != PGCOrderedDescending;
+    }
+    
+    printf("Inserting %llu objects in sorted order %s\n", count, insertionsSucceeded ? "succeeded" : "failed (FAILED)");
+    
+    // Check the binary searches against linear scans, over the whole array and over a range in the middle of it, for values
+    // that are below, in, between, and above the objects in the array
+    PGCRange ranges[] = { PGCMakeRange(0, count), PGCMakeRange(count / 3, count / 3), PGCMakeRange(count, 0) };
+    uint64_t mismatchCount = 0;
+    for (uint64_t i = 0; i < sizeof(ranges) / sizeof(ranges[0]); i++) {
+        PGCRange range = ranges[i];
+        for (int64_t value = -1; value <= (int64_t)(count / 4) + 1; value++) {
+            PGCInteger *integer = PGCIntegerInstanceWithSignedValue(value);
+            uint64_t end = range.location + range.length;
+            uint64_t lowerBound = range.location;
+            while (lowerBound < end && compareIntegers(PGCArrayGetObjectAtIndex(array, lowerBound), integer) == PGCOrderedAscending) lowerBound++;
+            
+            uint64_t upperBound = lowerBound;
+            while (upperBound < end && compareIntegers(PGCArrayGetObjectAtIndex(array, upperBound), integer) == PGCOrderedSame) upperBound++;
+            
+            uint64_t index = PGCArrayGetIndexOfObjectInSortedRange(array, integer, range, compareIntegers);
+            if (PGCArrayGetLowerBoundOfObjectInSortedRange(array, integer, range, compareIntegers) != lowerBound ||
+                PGCArrayGetUpperBoundOfObjectInSortedRange(array, integer, range, compareIntegers) != upperBound ||
+                (lowerBound == upperBound ? index != PGCNotFound : index < lowerBound || index >= upperBound)) {
+                mismatchCount++;
+            }
+        }
+    }
+    
+    printf("Binary searches had %llu mismatches with linear searches%s\n", mismatchCount, mismatchCount == 0 ? "" : " (FAILED)");
+    
+    PGCInteger *integer = PGCIntegerInstanceWithSignedValue(0);
+    printf("Binary searches of invalid ranges %s\n",
+           PGCArrayGetLowerBoundOfObjectInSortedRange(array, integer, PGCMakeRange(count, 1), compareIntegers) == PGCNotFound &&
+           PGCArrayGetIndexOfObjectInSortedRange(PGCArrayInstance(), integer, PGCMakeRange(0, 0), compareIntegers) == PGCNotFound ?
+           "found nothing" : "found something (FAILED)");
+}
+
+
+void TestCachedObjectHashes(uint64_t operationCount)
+{
+    // Apply the same random edits to collections that cache object hashes and ones that don’t, and make sure searches for
+    // equal but distinct objects always agree
+    PGCArray *cachingArray = PGCArrayInstance();
+    PGCArray *array = PGCArrayInstance();
+    PGCList *cachingList = PGCListInstance();
+    PGCList *list = PGCListInstance();
+    PGCArraySetCachesObjectHashes(cachingArray, true);
+    PGCListSetCachesObjectHashes(cachingList, true);
+    
+    uint64_t mismatchCount = 0;
+    for (uint64_t i = 0; i < operationCount; i++) {
+        uint64_t count = PGCArrayGetCount(array);
+        uint64_t index = random() % (count + 1);
+        PGCString *string = PGCStringInstanceWithFormat("%ld", random() % 64);
+        switch (random() % 5) {
+            case 0:
+            case 1:
+                PGCArrayInsertObjectAtIndex(cachingArray, string, index);
+                PGCArrayInsertObjectAtIndex(array, string, index);
+                PGCListInsertObjectAtIndex(cachingList, string, index);
+                PGCListInsertObjectAtIndex(list, string, index);
+                break;
+            case 2:
+                PGCArrayReplaceObjectAtIndex(cachingArray, string, index);
+                PGCArrayReplaceObjectAtIndex(array, string, index);
+                PGCListReplaceObjectAtIndex(cachingList, string, index);
+                PGCListReplaceObjectAtIndex(list, string, index);
+                break;
+            case 3:
+                PGCArrayRemoveObjectAtIndex(cachingArray, index);
+                PGCArrayRemoveObjectAtIndex(array, index);
+                PGCListRemoveObjectAtIndex(cachingList, index);
+                PGCListRemoveObjectAtIndex(list, index);
+                break;
+            case 4:
+                if (count > 0) {
+                    uint64_t otherIndex = random() % count;
+                    PGCArrayExchangeValuesAtIndices(cachingArray, index % count, otherIndex);
+                    PGCArrayExchangeValuesAtIndices(array, index % count, otherIndex);
+                    PGCListExchangeValuesAtIndices(cachingList, index % count, otherIndex);
+                    PGCListExchangeValuesAtIndices(list, index % count, otherIndex);
+                }
+                
+                break;
+        }
+        
+        PGCString *probe = PGCStringInstanceWithFormat("%ld", random() % 64);
+        uint64_t expectedIndex = PGCArrayGetIndexOfObject(array, probe);
+        if (PGCArrayGetIndexOfObject(cachingArray, probe) != expectedIndex || PGCListGetIndexOfObject(cachingList, probe) != expectedIndex ||
+            PGCListGetIndexOfObject(list, probe) != expectedIndex) {
+            mismatchCount++;
+        }
+        
+        // Turning caching off and on again recomputes every hash
+        if (i % 1000 == 999) {
+            PGCArraySetCachesObjectHashes(cachingArray, false);
+            PGCArraySetCachesObjectHashes(cachingArray, true);
+            PGCListSetCachesObjectHashes(cachingList, false);
+            PGCListSetCachesObjectHashes(cachingList, true);
+        }
+    }
+    
+    printf("After %llu edits, searches with cached hashes had %llu mismatches%s\n", operationCount, mismatchCount,
+           mismatchCount == 0 ? "" : " (FAILED)");
+    
+    // Removing by equality has to find every equal object
+    PGCString *string = PGCStringInstanceWithCString("0");
+    PGCArrayRemoveObject(cachingArray, string);
+    PGCListRemoveObject(cachingList, string);
+    printf("Removing an object from collections with cached hashes %s\n",
+           !PGCArrayContainsObject(cachingArray, string) && !PGCListContainsObject(cachingList, string) ?
+           "removed every equal object" : "left equal objects behind (FAILED)");
+}
+
+
+void TestIdenticalObjectSearch(void)
+{
+    // Compare the vectorized identity searches with simple loops over every alignment and length that a vector loop and its
+    // remainder handling could get wrong
+    PGCType integers[4];
+    for (uint64_t i = 0; i < 4; i++) integers[i] = PGCIntegerInstanceWithUnsignedValue(i);
+    
+    PGCArray *array = PGCArrayInstance();
+    for (uint64_t i = 0; i < 100; i++) PGCArrayAddObject(array, integers[random() % 4]);
+    
+    uint64_t mismatchCount = 0;
+    for (uint64_t location = 0; location <= 16; location++) {
+        for (uint64_t length = 0; location + length <= 100; length++) {
+            for (uint64_t i = 0; i < 4; i++) {
+                uint64_t expectedIndex = PGCNotFound;
+                uint64_t expectedCount = 0;
+                for (uint64_t j = location; j < location + length; j++) {
+                    if (PGCArrayGetObjectAtIndex(array, j) != integers[i]) continue;
+                    if (expectedIndex == PGCNotFound) expectedIndex = j;
+                    expectedCount++;
+                }
+                
+                PGCRange range = PGCMakeRange(location, length);
+                if (PGCArrayGetIndexOfIdenticalObjectInRange(array, integers[i], range) != expectedIndex ||
+                    PGCArrayCountIdenticalObjectsInRange(array, integers[i], range) != expectedCount) {
+                    mismatchCount++;
+                }
+            }
+        }
+    }
+    
+    printf("Identity searches had %llu mismatches with simple loops%s\n", mismatchCount, mismatchCount == 0 ? "" : " (FAILED)");
+    
+    // Equal objects that aren’t identical are never matched
+    PGCType equalInteger = PGCIntegerInstanceWithUnsignedValue(0);
+    printf("Searching for an equal but distinct object %s\n",
+           PGCArrayGetIndexOfIdenticalObject(array, equalInteger) == PGCNotFound && PGCArrayCountIdenticalObjects(array, equalInteger) == 0 ?
+           "found nothing" : "found something (FAILED)");
+}
+
+
+void TestNumericArrays(uint64_t maximumCount)
+{
+    // Compare the lane-based arithmetic and searches with simple loops for every count up to the maximum, so that each remainder
+    // length is covered. Values include the extremes so that wrapped sums and products are checked too.
+    uint64_t mismatchCount = 0;
+    for (uint64_t count = 0; count <= maximumCount; count++) {
+        PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+        PGCIntegerArray *integerArray1 = PGCIntegerArrayInstance();
+        PGCIntegerArray *integerArray2 = PGCIntegerArrayInstance();
+        PGCDecimalArray *decimalArray1 = PGCDecimalArrayInstance();
+        PGCDecimalArray *decimalArray2 = PGCDecimalArrayInstance();
+        for (uint64_t i = 0; i < count; i++) {
+            int64_t value = random() % 7 == 0 ? (random() % 2 ? INT64_MAX : INT64_MIN) : random() % 2001 - 1000;
+            PGCIntegerArrayAddValue(integerArray1, value);
+            PGCIntegerArrayAddValue(integerArray2, random() % 2001 - 1000);
+            PGCDecimalArrayAddValue(decimalArray1, random() % 2001 - 1000);
+            PGCDecimalArrayAddValue(decimalArray2, random() % 2001 - 1000);
+        }
+        
+        uint64_t integerSum = 0, integerDotProduct = 0;
+        int64_t integerMinimum = count > 0 ? INT64_MAX : 0, integerMaximum = count > 0 ? INT64_MIN : 0;
+        double decimalSum = 0, decimalDotProduct = 0;
+        double decimalMinimum = count > 0 ? INFINITY : 0, decimalMaximum = count > 0 ? -INFINITY : 0;
+        for (uint64_t i = 0; i < count; i++) {
+            int64_t integer = PGCIntegerArrayGetValueAtIndex(integerArray1, i);
+            integerSum += (uint64_t)integer;
+            integerDotProduct += (uint64_t)integer * (uint64_t)PGCIntegerArrayGetValueAtIndex(integerArray2, i);
+            if (integer < integerMinimum) integerMinimum = integer;
+            if (integer > integerMaximum) integerMaximum = integer;
+            
+            // The decimal values are small integers, so every sum is exact regardless of the order it’s computed in
+            double decimal = PGCDecimalArrayGetValueAtIndex(decimalArray1, i);
+            decimalSum += decimal;
+            decimalDotProduct += decimal * PGCDecimalArrayGetValueAtIndex(decimalArray2, i);
+            if (decimal < decimalMinimum) decimalMinimum = decimal;
+            if (decimal > decimalMaximum) decimalMaximum = decimal;
+        }
+        
+        if (PGCIntegerArrayGetSum(integerArray1) != (int64_t)integerSum ||
+            PGCIntegerArrayGetDotProduct(integerArray1, integerArray2) != (int64_t)integerDotProduct ||
+            PGCIntegerArrayGetMinimum(integerArray1) != integerMinimum || PGCIntegerArrayGetMaximum(integerArray1) != integerMaximum ||
+            PGCDecimalArrayGetSum(decimalArray1) != decimalSum || PGCDecimalArrayGetDotProduct(decimalArray1, decimalArray2) != decimalDotProduct ||
+            PGCDecimalArrayGetMinimum(decimalArray1) != decimalMinimum || PGCDecimalArrayGetMaximum(decimalArray1) != decimalMaximum) {
+            mismatchCount++;
+        }
+        
+        // Searches must find the first occurrence, even when it’s in the last partial set of lanes
+        for (uint64_t i = 0; i < count; i++) {
+            int64_t integer = PGCIntegerArrayGetValueAtIndex(integerArray1, i);
+            double decimal = PGCDecimalArrayGetValueAtIndex(decimalArray1, i);
+            uint64_t expectedIntegerIndex = 0, expectedDecimalIndex = 0;
+            while (PGCIntegerArrayGetValueAtIndex(integerArray1, expectedIntegerIndex) != integer) expectedIntegerIndex++;
+            while (PGCDecimalArrayGetValueAtIndex(decimalArray1, expectedDecimalIndex) != decimal) expectedDecimalIndex++;
+            if (PGCIntegerArrayGetIndexOfValue(integerArray1, integer) != expectedIntegerIndex ||
+                PGCDecimalArrayGetIndexOfValue(decimalArray1, decimal) != expectedDecimalIndex) {
+                mismatchCount++;
+            }
+        }
+        
+        if (PGCIntegerArrayGetIndexOfValue(integerArray1, 5000) != PGCNotFound || PGCDecimalArrayGetIndexOfValue(decimalArray1, 0.5) != PGCNotFound) {
+            mismatchCount++;
+        }
+        
+        // Scanning replaces each value with the sum of the values up to and including it
+        PGCIntegerArray *scannedArray = PGCIntegerArrayInstanceWithValues(PGCIntegerArrayGetValues(integerArray1), count);
+        PGCIntegerArrayScan(scannedArray);
+        uint64_t runningSum = 0;
+        for (uint64_t i = 0; i < count; i++) {
+            runningSum += (uint64_t)PGCIntegerArrayGetValueAtIndex(integerArray1, i);
+            if (PGCIntegerArrayGetValueAtIndex(scannedArray, i) != (int64_t)runningSum) mismatchCount++;
+        }
+        
+        PGCAutoreleasePoolDestroy(pool);
+    }
+    
+    printf("Numeric array arithmetic and searches had %llu mismatches with simple loops%s\n", mismatchCount,
+           mismatchCount == 0 ? "" : " (FAILED)");
+    
+    // Boxing and unboxing round-trips every value, including those outside the range of the other type’s exact values
+    int64_t integerValues[] = { INT64_MIN, -1, 0, 1, INT64_MAX };
+    PGCIntegerArray *integerArray = PGCIntegerArrayInstanceWithValues(integerValues, 5);
+    PGCIntegerArray *unboxedIntegerArray = PGCIntegerArrayInstanceWithArray(PGCIntegerArrayGetArray(integerArray));
+    printf("Boxing and unboxing an integer array %s\n", PGCEquals(integerArray, unboxedIntegerArray) ? "preserved its values" :
+           "changed its values (FAILED)");
+    
+    double decimalValues[] = { -1.5, 0.0, 1e-300, 1e300, INFINITY };
+    PGCDecimalArray *decimalArray = PGCDecimalArrayInstanceWithValues(decimalValues, 5);
+    PGCDecimalArray *unboxedDecimalArray = PGCDecimalArrayInstanceWithArray(PGCDecimalArrayGetArray(decimalArray));
+    printf("Boxing and unboxing a decimal array %s\n", PGCEquals(decimalArray, unboxedDecimalArray) ? "preserved its values" :
+           "changed its values (FAILED)");
+    
+    // Unboxing fails if any object is of the wrong class, but decimal arrays accept integers
+    PGCArray *mixedArray = PGCIntegerArrayGetArray(integerArray);
+    PGCArrayAddObject(mixedArray, PGCDecimalInstanceWithValue(2.5));
+    printf("Unboxing an integer array from an array containing a decimal %s\n",
+           PGCIntegerArrayInstanceWithArray(mixedArray) == NULL ? "failed" : "succeeded (FAILED)");
+    
+    PGCDecimalArray *convertedArray = PGCDecimalArrayInstanceWithArray(mixedArray);
+    printf("Unboxing a decimal array from an array containing integers %s\n",
+           convertedArray && PGCDecimalArrayGetCount(convertedArray) == 6 && PGCDecimalArrayGetValueAtIndex(convertedArray, 1) == -1 &&
+           PGCDecimalArrayGetValueAtIndex(convertedArray, 5) == 2.5 ? "converted the integers" : "didn’t convert the integers (FAILED)");
+    
+    // Decimal arrays compare values, so 0.0 and -0.0 are equal and hash the same, and NaN is never found
+    double zero = 0.0, negativeZero = -0.0;
+    PGCDecimalArray *zeroArray = PGCDecimalArrayInstanceWithValues(&zero, 1);
+    PGCDecimalArray *negativeZeroArray = PGCDecimalArrayInstanceWithValues(&negativeZero, 1);
+    printf("Decimal arrays containing 0.0 and -0.0 are %s\n",
+           PGCEquals(zeroArray, negativeZeroArray) && PGCHash(zeroArray) == PGCHash(negativeZeroArray) ?
+           "equal with equal hashes" : "unequal or have unequal hashes (FAILED)");
+    
+    PGCDecimalArrayAddValue(zeroArray, NAN);
+    printf("Searching a decimal array for NaN %s\n", PGCDecimalArrayGetIndexOfValue(zeroArray, NAN) == PGCNotFound ? "found nothing" :
+           "found something (FAILED)");
+    
+    // Out-of-range edits are ignored and empty arrays have zero extrema
+    PGCIntegerArrayInsertValueAtIndex(integerArray, 7, 6);
+    PGCIntegerArrayRemoveValuesInRange(integerArray, PGCMakeRange(3, 3));
+    PGCIntegerArrayReplaceValueAtIndex(integerArray, 7, 5);
+    printf("Out-of-range integer array edits %s\n", PGCIntegerArrayGetCount(integerArray) == 5 &&
+           PGCIntegerArrayGetValueAtIndex(integerArray, 4) == INT64_MAX ? "were ignored" : "changed the array (FAILED)");
+    
+    PGCIntegerArrayRemoveAllValues(integerArray);
+    printf("An empty integer array has minimum %lld and maximum %lld%s\n", PGCIntegerArrayGetMinimum(integerArray),
+           PGCIntegerArrayGetMaximum(integerArray),
+           PGCIntegerArrayGetMinimum(integerArray) == 0 && PGCIntegerArrayGetMaximum(integerArray) == 0 ? "" : " (FAILED)");
+}
+
+
 void TestDictionaries(void)
 {
     PGCDictionary *dictionary = PGCDictionaryInstance();
@@ -204,33 +976,1077 @@ void TestDictionaries(void)
 }
 
 
-void TestStrings(void)
-{    
-    PGCString *string = PGCStringInitWithCString(NULL, "aBcdEf");
-    PGCString *cString = PGCStringInstanceWithCString("123456");
-
-    printf("Originally, string = \"%s\"\n", PGCDescriptionCString(string));
+void TestStaticDictionaries(void)
+{
+    // Decimals that differ only in their ninth decimal place all have the same hash
+    PGCDictionary *dictionary = PGCDictionaryInstance();
+    for (uint64_t i = 0; i < 100; i++) {
+        PGCDictionarySetObjectForKey(dictionary, PGCIntegerInstanceWithUnsignedValue(i), PGCStringInstanceWithFormat("Key %llu", i));
+    }
     
-    PGCStringPrependString(string, cString);
-    printf("After prepend, string = \"%s\"\n", PGCDescriptionCString(string));
+    for (uint64_t i = 0; i < 3; i++) {
+        PGCDictionarySetObjectForKey(dictionary, PGCIntegerInstanceWithUnsignedValue(100 + i), PGCDecimalInstanceWithValue(1.0 + i * 1e-9));
+    }
     
-    PGCStringAppendString(string, cString);
-    printf("After append, string = \"%s\"\n", PGCDescriptionCString(string));
+    PGCStaticDictionary *staticDictionary = PGCStaticDictionaryInstanceWithDictionary(dictionary);
+    printf("Building a static dictionary with colliding hashes %s\n", staticDictionary ? "succeeded" : "failed (FAILED)");
+    if (!staticDictionary) return;
     
-    PGCStringInsertStringAtIndex(string, cString, 6);
-    printf("After insert, string = \"%s\"\n", PGCDescriptionCString(string));
+    printf("Static dictionary count is %llu%s\n", PGCStaticDictionaryGetCount(staticDictionary),
+           PGCStaticDictionaryGetCount(staticDictionary) == PGCDictionaryGetCount(dictionary) ? "" : " (FAILED)");
+    printf("Static dictionary %s its source dictionary\n", PGCStaticDictionaryHash(staticDictionary) == PGCDictionaryHash(dictionary) ?
+           "hashes like" : "doesn’t hash like (FAILED)");
+    
+    uint64_t mismatchCount = 0;
+    PGCArray *keys = PGCDictionaryGetAllKeys(dictionary);
+    for (uint64_t i = 0; i < PGCArrayGetCount(keys); i++) {
+        PGCType key = PGCArrayGetObjectAtIndex(keys, i);
+        if (!PGCEquals(PGCStaticDictionaryGetObjectForKey(staticDictionary, key), PGCDictionaryGetObjectForKey(dictionary, key))) mismatchCount++;
+    }
+    
+    printf("%llu keys mapped to the wrong object%s\n", mismatchCount, mismatchCount == 0 ? "" : " (FAILED)");
+    
+    PGCType missingKeys[] = { PGCStringInstanceWithCString("Key 100"), PGCDecimalInstanceWithValue(1.0 + 3e-9), PGCNullInstance() };
+    uint64_t foundCount = 0;
+    for (uint64_t i = 0; i < sizeof(missingKeys) / sizeof(missingKeys[0]); i++) {
+        if (PGCStaticDictionaryContainsKey(staticDictionary, missingKeys[i]) ||
+            PGCStaticDictionaryGetObjectForKey(staticDictionary, missingKeys[i])) {
+            foundCount++;
+        }
+    }
+    
+    printf("%llu missing keys were found%s\n", foundCount, foundCount == 0 ? "" : " (FAILED)");
+    
+    // When a key is repeated, the last object for it wins
+    PGCArray *repeatedKeys = PGCArrayInstance();
+    PGCArray *objects = PGCArrayInstance();
+    for (uint64_t i = 0; i < 4; i++) {
+        PGCArrayAddObject(repeatedKeys, PGCDecimalInstanceWithValue(2.0 + (i % 2) * 1e-9));
+        PGCArrayAddObject(objects, PGCIntegerInstanceWithUnsignedValue(i));
+    }
+    
+    staticDictionary = PGCStaticDictionaryInstanceWithObjectsAndKeys(objects, repeatedKeys);
+    bool lastObjectsWon = staticDictionary && PGCStaticDictionaryGetCount(staticDictionary) == 2 &&
+                          PGCEquals(PGCStaticDictionaryGetObjectForKey(staticDictionary, PGCArrayGetObjectAtIndex(repeatedKeys, 0)),
+                                    PGCArrayGetObjectAtIndex(objects, 2)) &&
+                          PGCEquals(PGCStaticDictionaryGetObjectForKey(staticDictionary, PGCArrayGetObjectAtIndex(repeatedKeys, 1)),
+                                    PGCArrayGetObjectAtIndex(objects, 3));
+    printf("Repeated colliding keys %s\n", lastObjectsWon ? "kept their last objects" : "didn’t keep their last objects (FAILED)");
+}
 
-    PGCStringReplaceCharactersInRangeWithString(string, PGCMakeRange(3, 12), PGCStringInstance());
-    printf("After replace, string = \"%s\"\n", PGCDescriptionCString(string));
 
-    printf("Substring to 9: \"%s\"\n", PGCDescriptionCString(PGCStringGetSubstringToIndex(string, 9)));
-    printf("Substring in { 3, 6 }: \"%s\"\n", PGCDescriptionCString(PGCStringGetSubstringWithRange(string, PGCMakeRange(3, 6))));
-    printf("Substring from 9: \"%s\"\n", PGCDescriptionCString(PGCStringGetSubstringFromIndex(string, 9)));
+typedef struct _TestFrozenCollectionsContext {
+    PGCDictionary *dictionary;
+    PGCArray *keys;
+    PGCArray *objects;
+    uint64_t mismatchCount;
+} TestFrozenCollectionsContext;
+
+
+void *TestFrozenCollectionsRead(void *argument)
+{
+    // Readers share the collections without any locks, so reading must never write to them
+    TestFrozenCollectionsContext *context = argument;
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+    uint64_t count = PGCArrayGetCount(context->keys);
+    for (uint64_t i = 0; i < count; i++) {
+        PGCType key = PGCArrayGetObjectAtIndex(context->keys, i);
+        PGCType copy = PGCCopy(context->keys);
+        if (PGCDictionaryGetObjectForKey(context->dictionary, key) != PGCArrayGetObjectAtIndex(context->objects, i) ||
+            PGCArrayGetIndexOfObject(context->keys, key) != i || PGCHash(copy) != PGCHash(context->keys)) {
+            context->mismatchCount++;
+        }
+        
+        PGCRelease(copy);
+    }
     
-    printf("Uppercase string: \"%s\"\n", PGCDescriptionCString(PGCStringGetUppercaseString(string)));
-    printf("Lowercase string: \"%s\"\n", PGCDescriptionCString(PGCStringGetLowercaseString(string)));
+    PGCAutoreleasePoolDestroy(pool);
+    return NULL;
+}
 
-    PGCRelease(string);
+
+void TestFrozenCollections(uint64_t count)
+{
+    // Decimal keys this close together all have the same hash, so lookups must check every entry with a matching hash
+    PGCDictionary *dictionary = PGCDictionaryInstance();
+    PGCArray *keys = PGCArrayInstance();
+    for (uint64_t i = 0; i < count; i++) {
+        PGCType key = i % 4 == 0 ? (PGCType)PGCDecimalInstanceWithValue(1.0 + i * 1e-9) : PGCStringInstanceWithFormat("Key %llu", i);
+        PGCArrayAddObject(keys, key);
+        PGCDictionarySetObjectForKey(dictionary, PGCIntegerInstanceWithUnsignedValue(i), key);
+    }
+    
+    PGCArraySetCachesObjectHashes(keys, true);
+    PGCDictionary *frozenDictionary = PGCDictionaryFreeze(dictionary);
+    PGCArray *frozenArray = PGCArrayFreeze(keys);
+    
+    uint64_t mismatchCount = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        PGCType key = PGCArrayGetObjectAtIndex(keys, i);
+        if (!PGCEquals(PGCDictionaryGetObjectForKey(frozenDictionary, key), PGCDictionaryGetObjectForKey(dictionary, key))) mismatchCount++;
+    }
+    
+    if (PGCDictionaryGetObjectForKey(frozenDictionary, PGCDecimalInstanceWithValue(1.0 + 0.5e-9)) ||
+        PGCDictionaryGetObjectForKey(frozenDictionary, PGCStringInstanceWithCString("Missing key"))) {
+        mismatchCount++;
+    }
+    
+    printf("Frozen dictionary lookups had %llu mismatches with the original dictionary%s\n", mismatchCount,
+           mismatchCount == 0 ? "" : " (FAILED)");
+    
+    printf("Frozen collections are %s to their originals\n",
+           PGCEquals(frozenDictionary, dictionary) && PGCEquals(dictionary, frozenDictionary) && PGCEquals(frozenArray, keys) &&
+           PGCHash(frozenDictionary) == PGCHash(dictionary) && PGCHash(frozenArray) == PGCHash(keys) ? "equal" : "NOT equal (FAILED)");
+    
+    // Freezing makes a new instance rather than changing the original, and copying or freezing a frozen collection just retains it
+    PGCType dictionaryCopy = PGCCopy(frozenDictionary);
+    PGCType arrayCopy = PGCCopy(frozenArray);
+    printf("Copying and freezing frozen collections %s\n",
+           PGCDictionaryIsFrozen(frozenDictionary) && PGCArrayIsFrozen(frozenArray) && !PGCDictionaryIsFrozen(dictionary) &&
+           !PGCArrayIsFrozen(keys) && dictionaryCopy == frozenDictionary && arrayCopy == frozenArray &&
+           PGCDictionaryFreeze(frozenDictionary) == frozenDictionary && PGCArrayFreeze(frozenArray) == frozenArray ?
+           "returned the same instances" : "made new instances (FAILED)");
+    
+    PGCRelease(dictionaryCopy);
+    PGCRelease(arrayCopy);
+    
+    // Every mutation is ignored
+    PGCType key = PGCArrayGetObjectAtIndex(keys, 1);
+    PGCDictionarySetObjectForKey(frozenDictionary, PGCNullInstance(), key);
+    PGCDictionarySetObjectForKey(frozenDictionary, PGCNullInstance(), PGCStringInstanceWithCString("New key"));
+    PGCDictionaryRemoveObjectForKey(frozenDictionary, PGCArrayGetObjectAtIndex(keys, 2));
+    PGCArrayAddObject(frozenArray, key);
+    PGCArrayReplaceObjectAtIndex(frozenArray, key, 0);
+    PGCArrayRemoveObjectAtIndex(frozenArray, 1);
+    PGCArrayExchangeValuesAtIndices(frozenArray, 0, 1);
+    bool poppedObject = PGCArrayPopObject(frozenArray) || PGCArrayPopLastObject(frozenArray);
+    PGCArrayRemoveAllObjects(frozenArray);
+    PGCDictionaryRemoveAllObjects(frozenDictionary);
+    printf("Mutating frozen collections %s\n",
+           !poppedObject && PGCEquals(frozenDictionary, dictionary) && PGCEquals(frozenArray, keys) ? "did nothing" :
+           "changed them (FAILED)");
+    
+    // Several threads can read the same frozen collections at once
+    PGCArray *objects = PGCArrayInstance();
+    for (uint64_t i = 0; i < count; i++) PGCArrayAddObject(objects, PGCDictionaryGetObjectForKey(dictionary, PGCArrayGetObjectAtIndex(keys, i)));
+    
+    TestFrozenCollectionsContext contexts[4];
+    pthread_t threads[4];
+    for (uint64_t i = 0; i < 4; i++) {
+        contexts[i] = (TestFrozenCollectionsContext){ frozenDictionary, frozenArray, PGCArrayFreeze(objects), 0 };
+        pthread_create(&threads[i], NULL, TestFrozenCollectionsRead, &contexts[i]);
+    }
+    
+    mismatchCount = 0;
+    for (uint64_t i = 0; i < 4; i++) {
+        pthread_join(threads[i], NULL);
+        mismatchCount += contexts[i].mismatchCount;
+    }
+    
+    printf("Concurrent reads of frozen collections had %llu mismatches%s\n", mismatchCount, mismatchCount == 0 ? "" : " (FAILED)");
+}
+
+
+void TestLists(void)
+{
+    PGCList *list = PGCListInstance();
+    for (uint64_t i = 0; i < 10; i++) PGCListAddObject(list, PGCIntegerInstanceWithUnsignedValue(i));
+    
+    // Indexing a list replaces its nodes, so cursors into it must be invalidated
+    PGCListCursor cursor = PGCListGetCursorAtIndex(list, 3);
+    PGCListSetIndexed(list, true);
+    printf("After indexing a list, cursors into it %s\n", !PGCListCursorHasNext(&cursor) && !PGCListCursorNext(&cursor) ?
+           "were invalid" : "were still valid (FAILED)");
+    
+    cursor = PGCListGetCursorAtIndex(list, 3);
+    PGCListSetIndexed(list, false);
+    printf("After unindexing a list, cursors into it %s\n", !PGCListCursorNext(&cursor) ? "were invalid" : "were still valid (FAILED)");
+}
+
+
+void TestContentHashing(void)
+{
+    PGCArray *array1 = PGCArrayInstance();
+    PGCArray *array2 = PGCArrayInstance();
+    PGCList *list1 = PGCListInstance();
+    PGCList *list2 = PGCListInstance();
+    PGCDictionary *dictionary1 = PGCDictionaryInstance();
+    PGCDictionary *dictionary2 = PGCDictionaryInstance();
+    printf("Empty collections %s\n", PGCHash(array1) == PGCHash(array2) && PGCHash(list1) == PGCHash(list2) &&
+           PGCHash(dictionary1) == PGCHash(dictionary2) ? "hashed equally" : "hashed differently (FAILED)");
+    
+    // The first collections are filled front to back after being hashed, so their cached hashes are updated as objects are
+    // added. The second collections are filled back to front with different but equal objects.
+    for (uint64_t i = 0; i < 100; i++) {
+        PGCArrayAddObject(array1, PGCStringInstanceWithFormat("%llu", i));
+        PGCListAddObject(list1, PGCStringInstanceWithFormat("%llu", i));
+        PGCDictionarySetObjectForKey(dictionary1, PGCIntegerInstanceWithUnsignedValue(i), PGCStringInstanceWithFormat("%llu", i));
+    }
+    
+    for (uint64_t i = 100; i > 0; i--) {
+        PGCArrayInsertObjectAtIndex(array2, PGCStringInstanceWithFormat("%llu", i - 1), 0);
+        PGCListInsertObjectAtIndex(list2, PGCStringInstanceWithFormat("%llu", i - 1), 0);
+        PGCDictionarySetObjectForKey(dictionary2, PGCIntegerInstanceWithUnsignedValue(i - 1), PGCStringInstanceWithFormat("%llu", i - 1));
+    }
+    
+    printf("Equal arrays %s\n", PGCEquals(array1, array2) && PGCHash(array1) == PGCHash(array2) ? "hashed equally" : "hashed differently (FAILED)");
+    printf("Equal lists %s\n", PGCEquals(list1, list2) && PGCHash(list1) == PGCHash(list2) ? "hashed equally" : "hashed differently (FAILED)");
+    printf("Equal dictionaries %s\n", PGCEquals(dictionary1, dictionary2) && PGCHash(dictionary1) == PGCHash(dictionary2) ?
+           "hashed equally" : "hashed differently (FAILED)");
+    
+    // Changing the contents has to invalidate the cached hashes
+    PGCArrayExchangeValuesAtIndices(array2, 0, 1);
+    PGCListExchangeValuesAtIndices(list2, 0, 1);
+    PGCDictionarySetObjectForKey(dictionary2, PGCNullInstance(), PGCStringInstanceWithCString("0"));
+    printf("Reordering an array %s\n", PGCHash(array1) != PGCHash(array2) ? "changed its hash" : "didn’t change its hash (FAILED)");
+    printf("Reordering a list %s\n", PGCHash(list1) != PGCHash(list2) ? "changed its hash" : "didn’t change its hash (FAILED)");
+    printf("Replacing an object in a dictionary %s\n", PGCHash(dictionary1) != PGCHash(dictionary2) ?
+           "changed its hash" : "didn’t change its hash (FAILED)");
+    
+    PGCArrayExchangeValuesAtIndices(array2, 0, 1);
+    PGCListExchangeValuesAtIndices(list2, 0, 1);
+    PGCDictionarySetObjectForKey(dictionary2, PGCIntegerInstanceWithUnsignedValue(0), PGCStringInstanceWithCString("0"));
+    printf("Undoing the changes %s\n", PGCHash(array1) == PGCHash(array2) && PGCHash(list1) == PGCHash(list2) &&
+           PGCHash(dictionary1) == PGCHash(dictionary2) ? "restored the hashes" : "didn’t restore the hashes (FAILED)");
+}
+
+
+void TestStrings(void)
+{    
+    PGCString *string = PGCStringInitWithCString(NULL, "aBcdEf");
+    PGCString *cString = PGCStringInstanceWithCString("123456");
+
+    printf("Originally, string = \"%s\"\n", PGCDescriptionCString(string));
+    
+    PGCStringPrependString(string, cString);
+    printf("After prepend, string = \"%s\"\n", PGCDescriptionCString(string));
+    
+    PGCStringAppendString(string, cString);
+    printf("After append, string = \"%s\"\n", PGCDescriptionCString(string));
+    
+    PGCStringInsertStringAtIndex(string, cString, 6);
+    printf("After insert, string = \"%s\"\n", PGCDescriptionCString(string));
+
+    PGCStringReplaceCharactersInRangeWithString(string, PGCMakeRange(3, 12), PGCStringInstance());
+    printf("After replace, string = \"%s\"\n", PGCDescriptionCString(string));
+
+    printf("Substring to 9: \"%s\"\n", PGCDescriptionCString(PGCStringGetSubstringToIndex(string, 9)));
+    printf("Substring in { 3, 6 }: \"%s\"\n", PGCDescriptionCString(PGCStringGetSubstringWithRange(string, PGCMakeRange(3, 6))));
+    printf("Substring from 9: \"%s\"\n", PGCDescriptionCString(PGCStringGetSubstringFromIndex(string, 9)));
+    
+    printf("Uppercase string: \"%s\"\n", PGCDescriptionCString(PGCStringGetUppercaseString(string)));
+    printf("Lowercase string: \"%s\"\n", PGCDescriptionCString(PGCStringGetLowercaseString(string)));
+
+    PGCRelease(string);
+}
+
+
+void TestJSONWriting(void)
+{
+    // Releasing a writer flushes whatever it still has buffered
+    PGCString *string = PGCStringInstance();
+    PGCJSONWriter *writer = PGCJSONWriterInitWithString(NULL, string, 0);
+    PGCArray *array = PGCArrayInstance();
+    for (uint64_t i = 0; i < 3; i++) PGCArrayAddObject(array, PGCIntegerInstanceWithUnsignedValue(i));
+    
+    PGCJSONWriterWriteObject(writer, array);
+    PGCRelease(writer);
+    printf("After releasing an unflushed writer, its string was %s%s\n", PGCStringGetCString(string),
+           strcmp(PGCStringGetCString(string), "[0,1,2]") == 0 ? "" : " (FAILED)");
+}
+
+
+bool TestMappedFileWriteBytes(const char *path, const uint8_t *bytes, uint64_t length)
+{
+    FILE *file = fopen(path, "wb");
+    if (!file) return false;
+    bool written = fwrite(bytes, 1, length, file) == length;
+    return fclose(file) == 0 && written;
+}
+
+
+void TestMappedFiles(uint64_t corruptionCount)
+{
+    PGCDictionary *dictionary = PGCDictionaryInstance();
+    PGCArray *numbers = PGCArrayInstance();
+    for (uint64_t i = 0; i < 32; i++) {
+        PGCArrayAddObject(numbers, i % 2 ? (PGCType)PGCIntegerInstanceWithSignedValue(-(int64_t)i) : PGCDecimalInstanceWithValue(i / 4.0));
+    }
+    
+    PGCDictionarySetObjectForKey(dictionary, numbers, PGCStringInstanceWithCString("numbers"));
+    PGCDictionarySetObjectForKey(dictionary, PGCStringInstanceWithCString("value"), PGCStringInstanceWithCString("name"));
+    PGCDictionary *nestedDictionary = PGCDictionaryInstanceWithObjectsAndKeys(PGCBooleanTrue(), PGCStringInstanceWithCString("flag"),
+                                                                              PGCNullInstance(), PGCCharacterInstanceWithValue('c'), NULL);
+    PGCDictionarySetObjectForKey(dictionary, nestedDictionary, PGCStringInstanceWithCString("nested"));
+    
+    char path[] = "/tmp/PGCFoundationTest.XXXXXX";
+    int fileDescriptor = mkstemp(path);
+    if (fileDescriptor < 0 || !PGCMappedFileWriteObjectToPath(dictionary, path)) {
+        if (fileDescriptor >= 0) close(fileDescriptor);
+        printf("Writing a mapped file FAILED\n");
+        return;
+    }
+    
+    // The file is unmapped before it is rewritten below, since touching a mapping of a truncated file crashes
+    close(fileDescriptor);
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+    PGCMappedFile *mappedFile = PGCMappedFileInstanceWithPath(path);
+    PGCType root = PGCMappedFileGetRootObject(mappedFile);
+    printf("Reading a mapped file %s\n", PGCObjectIsKindOfClass(root, PGCMappedDictionaryClass()) &&
+           PGCEquals(PGCMappedDictionaryGetDictionary(root), dictionary) ? "returned the written dictionary" :
+           "did NOT return the written dictionary (FAILED)");
+    
+    uint64_t size = PGCMappedFileGetSize(mappedFile);
+    PGCAutoreleasePoolDestroy(pool);
+    
+    // Keep a copy of the file’s bytes to truncate and corrupt
+    uint8_t *bytes = malloc(size);
+    uint8_t *corruptBytes = malloc(size);
+    FILE *file = fopen(path, "rb");
+    bool read = file && fread(bytes, 1, size, file) == size;
+    if (file) fclose(file);
+    if (!read) {
+        printf("Reading a mapped file’s bytes FAILED\n");
+        free(bytes);
+        free(corruptBytes);
+        unlink(path);
+        return;
+    }
+    
+    // Every truncated file is rejected, since its size doesn’t match the size in its header
+    uint64_t loadedCount = 0;
+    for (uint64_t length = 0; length < size; length++) {
+        pool = PGCAutoreleasePoolCreate();
+        if (TestMappedFileWriteBytes(path, bytes, length) && PGCMappedFileInstanceWithPath(path)) loadedCount++;
+        PGCAutoreleasePoolDestroy(pool);
+    }
+    
+    printf("%llu of %llu truncated files were loaded%s\n", loadedCount, size, loadedCount == 0 ? "" : " (FAILED)");
+    
+    // So are files whose magic number, version, or byte order mark have been changed
+    loadedCount = 0;
+    for (uint64_t offset = 0; offset < 16; offset += 4) {
+        pool = PGCAutoreleasePoolCreate();
+        memcpy(corruptBytes, bytes, size);
+        corruptBytes[offset] ^= 0xFF;
+        if (TestMappedFileWriteBytes(path, corruptBytes, size) && PGCMappedFileInstanceWithPath(path)) loadedCount++;
+        PGCAutoreleasePoolDestroy(pool);
+    }
+    
+    printf("%llu of 4 files with corrupt headers were loaded%s\n", loadedCount, loadedCount == 0 ? "" : " (FAILED)");
+    
+    // Files with corrupt contents load, but reading them must stay within the file. Overwrite a random word after the header
+    // with a value that is likely to be an out-of-range offset or count, and then read everything in the file. Any invalid
+    // memory access here is a failure, so this is most useful when run with the address sanitizer.
+    uint64_t equalCount = 0;
+    uint64_t wordCount = size / sizeof(uint64_t);
+    for (uint64_t i = 0; i < corruptionCount; i++) {
+        pool = PGCAutoreleasePoolCreate();
+        memcpy(corruptBytes, bytes, size);
+        uint64_t word = 0;
+        switch (i % 4) {
+            case 0:
+                word = random() % size;
+                break;
+            case 1:
+                word = UINT64_MAX - random() % size;
+                break;
+            case 2:
+                word = (uint64_t)random() << 32 | random();
+                break;
+            case 3:
+                word = random() % 16;
+                break;
+        }
+        
+        memcpy(&corruptBytes[(3 + random() % (wordCount - 3)) * sizeof(uint64_t)], &word, sizeof(uint64_t));
+        
+        PGCType corruptRoot = TestMappedFileWriteBytes(path, corruptBytes, size) ?
+                              PGCMappedFileGetRootObject(PGCMappedFileInstanceWithPath(path)) : NULL;
+        PGCDescription(corruptRoot);
+        PGCHash(corruptRoot);
+        if (PGCObjectIsKindOfClass(corruptRoot, PGCMappedDictionaryClass())) {
+            PGCMappedDictionaryGetAllObjects(corruptRoot);
+            if (PGCEquals(PGCMappedDictionaryGetDictionary(corruptRoot), dictionary)) equalCount++;
+        }
+        
+        PGCAutoreleasePoolDestroy(pool);
+    }
+    
+    printf("Read %llu files with corrupt contents, %llu of which were unaffected by the corruption\n", corruptionCount, equalCount);
+    
+    free(bytes);
+    free(corruptBytes);
+    unlink(path);
+}
+
+
+// Objects of this class autorelease TestAutoreleasingObjectPayload when they are deallocated
+PGCInteger *TestAutoreleasingObjectPayload = NULL;
+
+void TestAutoreleasingObjectDealloc(PGCType instance)
+{
+    PGCAutorelease(PGCRetain(TestAutoreleasingObjectPayload));
+    PGCSuperclassDealloc(instance);
+}
+
+
+PGCClass *TestAutoreleasingObjectClass(void)
+{
+    static PGCClass *autoreleasingObjectClass = NULL;
+    if (!autoreleasingObjectClass) {
+        PGCClassFunctions functions = { NULL, TestAutoreleasingObjectDealloc, NULL, NULL, NULL, NULL, NULL };
+        autoreleasingObjectClass = PGCClassCreate("TestAutoreleasingObject", PGCObjectClass(), functions, sizeof(PGCObject));
+    }
+    return autoreleasingObjectClass;
+}
+
+
+void TestAutoreleasePoolTeardown(void)
+{
+    TestAutoreleasingObjectPayload = PGCIntegerInitWithSignedValue(NULL, 1);
+
+    // The object's deallocation is deferred until after the pool has released its entries, so the payload it autoreleases
+    // must still be released by the pool being destroyed rather than leaking or landing in an outer pool
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+    PGCAutorelease(PGCAlloc(TestAutoreleasingObjectClass()));
+    PGCAutoreleasePoolDestroy(pool);
+    uint64_t destroyRetainCount = ((PGCObject *)TestAutoreleasingObjectPayload)->retainCount;
+
+    // Draining must do the same
+    pool = PGCAutoreleasePoolCreate();
+    PGCArray *array = PGCArrayInstance();
+    for (uint64_t i = 0; i < 10; i++) PGCArrayAddObject(array, PGCAutorelease(PGCAlloc(TestAutoreleasingObjectClass())));
+    PGCAutoreleasePoolDrain(pool);
+    uint64_t drainRetainCount = ((PGCObject *)TestAutoreleasingObjectPayload)->retainCount;
+    PGCAutoreleasePoolDestroy(pool);
+
+    printf("Objects autoreleased during deferred deallocation %s\n",
+           destroyRetainCount == 1 && drainRetainCount == 1 ? "were released" : "were NOT released (FAILED)");
+
+    PGCRelease(TestAutoreleasingObjectPayload);
+    TestAutoreleasingObjectPayload = NULL;
+}
+
+
+typedef struct _TestConcurrentQueueContext {
+    PGCConcurrentQueue *queue;
+    uint64_t producerCount;
+    uint64_t objectCount;
+    uint64_t producerIndex;
+    uint64_t dequeueCount;
+    uint8_t *dequeuedFlags;
+    uint64_t outOfOrderCount;
+} TestConcurrentQueueContext;
+
+
+void *TestConcurrentQueueProduce(void *argument)
+{
+    // Each object records which producer enqueued it and its position in that producer’s sequence
+    TestConcurrentQueueContext *context = argument;
+    for (uint64_t i = 0; i < context->objectCount; i++) {
+        uint64_t value = context->producerIndex * context->objectCount + i;
+        PGCConcurrentQueueEnqueueRetainedObject(context->queue, PGCIntegerInitWithUnsignedValue(NULL, value));
+    }
+    
+    return NULL;
+}
+
+
+void *TestConcurrentQueueConsume(void *argument)
+{
+    // A single consumer must see each producer’s objects in the order they were enqueued, though other consumers may take some
+    TestConcurrentQueueContext *context = argument;
+    uint64_t *lastIndexes = malloc(context->producerCount * sizeof(uint64_t));
+    for (uint64_t i = 0; i < context->producerCount; i++) lastIndexes[i] = UINT64_MAX;
+    
+    for (uint64_t i = 0; i < context->dequeueCount; i++) {
+        PGCInteger *integer = PGCConcurrentQueueDequeueObject(context->queue);
+        uint64_t value = PGCIntegerGetUnsignedValue(integer);
+        PGCRelease(integer);
+        
+        uint64_t producerIndex = value / context->objectCount;
+        uint64_t index = value % context->objectCount;
+        if (lastIndexes[producerIndex] != UINT64_MAX && index <= lastIndexes[producerIndex]) context->outOfOrderCount++;
+        lastIndexes[producerIndex] = index;
+        __atomic_add_fetch(&context->dequeuedFlags[value], 1, __ATOMIC_RELAXED);
+    }
+    
+    free(lastIndexes);
+    return NULL;
+}
+
+
+void TestConcurrentQueue(uint64_t threadCount, uint64_t objectCount)
+{
+    // Try variants fail rather than wait when the queue is full or empty, and objects come out in the order they went in
+    PGCConcurrentQueue *queue = PGCConcurrentQueueInitWithCapacity(NULL, 10);
+    uint64_t capacity = PGCConcurrentQueueGetCapacity(queue);
+    uint64_t enqueuedCount = 0;
+    while (enqueuedCount <= capacity && PGCConcurrentQueueTryEnqueueObject(queue, PGCIntegerInstanceWithUnsignedValue(enqueuedCount))) {
+        enqueuedCount++;
+    }
+    
+    bool dequeuedInOrder = PGCConcurrentQueueGetCount(queue) == capacity;
+    for (uint64_t i = 0; i < enqueuedCount; i++) {
+        PGCInteger *integer = PGCConcurrentQueueTryDequeueObject(queue);
+        dequeuedInOrder = dequeuedInOrder && integer && PGCIntegerGetUnsignedValue(integer) == i;
+        PGCRelease(integer);
+    }
+    
+    printf("A queue with capacity %llu accepted %llu objects and %s\n", capacity, enqueuedCount,
+           enqueuedCount == capacity && dequeuedInOrder && !PGCConcurrentQueueTryDequeueObject(queue) ?
+           "returned them in order" : "did NOT return them in order (FAILED)");
+    PGCRelease(queue);
+    
+    // Now do the same with several producers and consumers sharing a small queue, so that both sides have to wait
+    queue = PGCConcurrentQueueInitWithCapacity(NULL, 16);
+    uint8_t *dequeuedFlags = calloc(threadCount * objectCount, 1);
+    TestConcurrentQueueContext *contexts = malloc(2 * threadCount * sizeof(TestConcurrentQueueContext));
+    pthread_t *threads = malloc(2 * threadCount * sizeof(pthread_t));
+    for (uint64_t i = 0; i < 2 * threadCount; i++) {
+        contexts[i] = (TestConcurrentQueueContext){ queue, threadCount, objectCount, i % threadCount, objectCount, dequeuedFlags, 0 };
+        pthread_create(&threads[i], NULL, i < threadCount ? TestConcurrentQueueProduce : TestConcurrentQueueConsume, &contexts[i]);
+    }
+    
+    uint64_t outOfOrderCount = 0;
+    for (uint64_t i = 0; i < 2 * threadCount; i++) {
+        pthread_join(threads[i], NULL);
+        outOfOrderCount += contexts[i].outOfOrderCount;
+    }
+    
+    uint64_t missingCount = 0;
+    for (uint64_t i = 0; i < threadCount * objectCount; i++) {
+        if (dequeuedFlags[i] != 1) missingCount++;
+    }
+    
+    printf("%llu producers and consumers passed %llu objects; %llu were dequeued out of order and %llu weren’t dequeued exactly once%s\n",
+           threadCount, threadCount * objectCount, outOfOrderCount, missingCount,
+           outOfOrderCount == 0 && missingCount == 0 && PGCConcurrentQueueGetCount(queue) == 0 ? "" : " (FAILED)");
+    
+    free(threads);
+    free(contexts);
+    free(dequeuedFlags);
+    PGCRelease(queue);
+}
+
+
+typedef struct _TestListNodeRecyclingContext {
+    PGCConcurrentQueue *queue;
+    uint64_t listCount;
+    uint64_t objectCount;
+} TestListNodeRecyclingContext;
+
+
+void *TestListNodeRecyclingProduce(void *argument)
+{
+    TestListNodeRecyclingContext *context = argument;
+    for (uint64_t i = 0; i < context->listCount; i++) {
+        PGCList *list = PGCListInit(NULL);
+        for (uint64_t j = 0; j < context->objectCount; j++) PGCListAddObject(list, PGCNullInstance());
+        PGCConcurrentQueueEnqueueRetainedObject(context->queue, list);
+    }
+    
+    return NULL;
+}
+
+
+void *TestListNodeRecyclingConsume(void *argument)
+{
+    // Every node is allocated on the producing thread and freed on this one
+    TestListNodeRecyclingContext *context = argument;
+    for (uint64_t i = 0; i < context->listCount; i++) PGCRelease(PGCConcurrentQueueDequeueObject(context->queue));
+    return NULL;
+}
+
+
+long TestMaximumResidentSetSize(void)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+
+void TestListNodeRecycling(uint64_t listCount, uint64_t objectCount)
+{
+    TestListNodeRecyclingContext context = { PGCConcurrentQueueInitWithCapacity(NULL, 16), listCount / 4, objectCount };
+    
+    // Warm up, then check that memory stays flat while one thread keeps allocating nodes that another thread keeps freeing
+    long residentSetSizes[4];
+    for (uint64_t round = 0; round < 4; round++) {
+        pthread_t producer, consumer;
+        pthread_create(&consumer, NULL, TestListNodeRecyclingConsume, &context);
+        pthread_create(&producer, NULL, TestListNodeRecyclingProduce, &context);
+        pthread_join(producer, NULL);
+        pthread_join(consumer, NULL);
+        residentSetSizes[round] = TestMaximumResidentSetSize();
+    }
+    
+    PGCRelease(context.queue);
+    
+    // ru_maxrss is in kilobytes on some systems and bytes on others, so compare growth relative to the warmed-up size
+    double growth = (double)(residentSetSizes[3] - residentSetSizes[0]) / residentSetSizes[0];
+    printf("Maximum resident set size grew by %.1f%% after warming up, so node memory %s\n", growth * 100,
+           growth < 0.25 ? "stayed flat" : "kept growing (FAILED)");
+}
+
+
+void BenchmarkArchiving(uint64_t recordCount)
+{
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+
+    PGCArray *records = PGCArrayInitWithInitialCapacity(NULL, recordCount);
+    for (uint64_t i = 0; i < recordCount; i++) {
+        PGCArray *record = PGCArrayInstance();
+        PGCArrayAddObject(record, PGCIntegerInstanceWithSignedValue(random() % 2000 - 1000));
+        PGCArrayAddObject(record, PGCDecimalInstanceWithValue(random() / 1024.0));
+        PGCArrayAddObject(record, PGCStringInstanceWithFormat("Category %llu", i % 64));
+        PGCArrayAddObject(record, i % 2 ? PGCBooleanTrue() : PGCBooleanFalse());
+        PGCArrayAddObject(records, record);
+    }
+
+    clock_t start = clock();
+    PGCString *description = PGCDescription(records);
+    double descriptionSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    PGCArchiver *archiver = PGCArchiverInstance();
+    PGCArchiverEncodeObject(archiver, records);
+    double encodeSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    // Decode in a separate pool so that the time to empty it is included
+    start = clock();
+    PGCAutoreleasePool *decodePool = PGCAutoreleasePoolCreate();
+    PGCUnarchiver *unarchiver = PGCUnarchiverInstanceWithBytes(PGCArchiverGetBytes(archiver), PGCArchiverGetLength(archiver));
+    PGCArray *decodedRecords = PGCRetainAutoreleasedReturnValue(PGCUnarchiverDecodeObject(unarchiver));
+    PGCAutoreleasePoolDestroy(decodePool);
+    double decodeSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    double megabytes = PGCArchiverGetLength(archiver) / (1024.0 * 1024.0);
+    printf("Description: %llu bytes in %.3fs\n", PGCStringGetLength(description), descriptionSeconds);
+    printf("Encoding: %llu bytes in %.3fs (%.1f MB/s)\n", PGCArchiverGetLength(archiver), encodeSeconds, megabytes / encodeSeconds);
+    printf("Decoding: %.3fs (%.1f MB/s), round trip %s\n", decodeSeconds, megabytes / decodeSeconds, 
+           PGCEquals(records, decodedRecords) ? "succeeded" : "FAILED");
+
+    PGCRelease(records);
+    PGCRelease(decodedRecords);
+    PGCAutoreleasePoolDestroy(pool);
+}
+
+
+void BenchmarkJSONReading(uint64_t recordCount)
+{
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+
+    PGCString *json = PGCStringInstanceWithCString("[");
+    for (uint64_t i = 0; i < recordCount; i++) {
+        PGCStringAppendString(json, PGCStringInstanceWithFormat("%s\n  {\"id\": %llu, \"score\": %.4f, \"category\": \"Category %llu\", "
+                                                                "\"tags\": [\"alpha\", \"beta\\t%ld\"], \"active\": %s, \"parent\": null}",
+                                                                i ? "," : "", i, random() / 1024.0, i % 64, random() % 100,
+                                                                i % 2 ? "true" : "false"));
+    }
+    PGCStringAppendString(json, PGCStringInstanceWithCString("\n]\n"));
+
+    const char *bytes = PGCStringGetCString(json);
+    uint64_t length = PGCStringGetLength(json);
+    double megabytes = length / (1024.0 * 1024.0);
+
+    clock_t start = clock();
+    PGCArray *records = PGCJSONReaderObjectWithBytes(bytes, length);
+    double readSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    // Feed the same document in small chunks to exercise tokens that straddle chunk boundaries
+    start = clock();
+    PGCJSONReader *reader = PGCJSONReaderInstance();
+    for (uint64_t offset = 0; offset < length; offset += 4096) {
+        PGCJSONReaderReadBytes(reader, bytes + offset, length - offset < 4096 ? length - offset : 4096);
+    }
+    PGCJSONReaderFinish(reader);
+    double chunkedReadSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("Reading: %llu records, %llu bytes in %.3fs (%.1f MB/s)\n", records ? PGCArrayGetCount(records) : 0, length, readSeconds,
+           megabytes / readSeconds);
+    printf("Chunked reading: %.3fs (%.1f MB/s), results %s\n", chunkedReadSeconds, megabytes / chunkedReadSeconds,
+           PGCEquals(records, PGCJSONReaderGetRootObject(reader)) ? "match" : "DIFFER");
+
+    PGCAutoreleasePoolDestroy(pool);
+}
+
+
+void BenchmarkJSONWriting(uint64_t recordCount)
+{
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+
+    PGCString *idKey = PGCStringInstanceWithCString("id");
+    PGCString *scoreKey = PGCStringInstanceWithCString("score");
+    PGCString *categoryKey = PGCStringInstanceWithCString("category");
+    PGCString *activeKey = PGCStringInstanceWithCString("active");
+
+    PGCArray *records = PGCArrayInitWithInitialCapacity(NULL, recordCount);
+    for (uint64_t i = 0; i < recordCount; i++) {
+        PGCDictionary *record = PGCDictionaryInstance();
+        PGCDictionarySetObjectForKey(record, PGCIntegerInstanceWithSignedValue(i), idKey);
+        PGCDictionarySetObjectForKey(record, PGCDecimalInstanceWithValue((random() % 1000000) / 100.0), scoreKey);
+        PGCDictionarySetObjectForKey(record, PGCStringInstanceWithFormat("Category \"%llu\"", i % 64), categoryKey);
+        PGCDictionarySetObjectForKey(record, i % 2 ? PGCBooleanTrue() : PGCBooleanFalse(), activeKey);
+        PGCArrayAddObject(records, record);
+    }
+
+    clock_t start = clock();
+    PGCString *json = PGCJSONWriterStringWithObject(records, 0);
+    double writeSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    PGCString *prettyJSON = PGCJSONWriterStringWithObject(records, PGCJSONWriterPrettyPrinted);
+    double prettyWriteSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    double megabytes = PGCStringGetLength(json) / (1024.0 * 1024.0);
+    double prettyMegabytes = PGCStringGetLength(prettyJSON) / (1024.0 * 1024.0);
+    printf("Writing: %llu bytes in %.3fs (%.1f MB/s)\n", PGCStringGetLength(json), writeSeconds, megabytes / writeSeconds);
+    printf("Pretty writing: %llu bytes in %.3fs (%.1f MB/s), round trip %s\n", PGCStringGetLength(prettyJSON), prettyWriteSeconds,
+           prettyMegabytes / prettyWriteSeconds, 
+           PGCEquals(records, PGCJSONReaderObjectWithBytes(PGCStringGetCString(prettyJSON), PGCStringGetLength(prettyJSON))) ? "succeeded" : "FAILED");
+
+    PGCRelease(records);
+    PGCAutoreleasePoolDestroy(pool);
+}
+
+
+void BenchmarkListQueue(uint64_t operationCount, uint64_t nodeCapacity)
+{
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+
+    // Keep a backlog of about a thousand objects while pushing onto the back and popping off the front
+    PGCList *queue = PGCListInitWithNodeCapacity(NULL, nodeCapacity);
+    PGCInteger *object = PGCIntegerInstanceWithSignedValue(1);
+    for (uint64_t i = 0; i < 1000; i++) PGCListAddObject(queue, object);
+
+    clock_t start = clock();
+    for (uint64_t i = 0; i < operationCount; i++) {
+        PGCListAddObject(queue, object);
+        PGCListRemoveObjectAtIndex(queue, 0);
+    }
+    double queueSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    // Search for an object that isn’t in the list. With cached hashes, this is just a walk over every node.
+    PGCListSetCachesObjectHashes(queue, true);
+    PGCInteger *missingObject = PGCIntegerInstanceWithSignedValue(2);
+    uint64_t failureCount = 0;
+    start = clock();
+    for (uint64_t i = 0; i < operationCount / 1000; i++) {
+        if (PGCListGetIndexOfObject(queue, missingObject) != PGCNotFound) failureCount++;
+    }
+    double traversalSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("Node capacity %llu: %.1f ns per push and pop, %.1f ns per object traversed%s\n", nodeCapacity, 
+           queueSeconds * 1e9 / operationCount, traversalSeconds * 1e9 / operationCount, failureCount == 0 ? "" : " (FAILED)");
+
+    PGCRelease(queue);
+    PGCAutoreleasePoolDestroy(pool);
+}
+
+
+void BenchmarkListTraversal(uint64_t objectCount)
+{
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+
+    // Build a list whose second half repeats its first half
+    PGCList *list = PGCListInit(NULL);
+    uint64_t halfCount = objectCount / 2;
+    for (uint64_t i = 0; i < halfCount; i++) PGCListAddObject(list, PGCIntegerInstanceWithSignedValue(random()));
+    for (uint64_t i = 0; i < halfCount; i++) PGCListAddObject(list, PGCListGetObjectAtIndex(list, i));
+
+    // Alternating between two distant indices defeats the list’s cached node, so each access walks half the list
+    uint64_t failureCount = 0;
+    clock_t start = clock();
+    for (uint64_t i = 0; i < halfCount; i++) {
+        if (!PGCEquals(PGCListGetObjectAtIndex(list, i), PGCListGetObjectAtIndex(list, halfCount + i))) failureCount++;
+    }
+    double indexSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    PGCListCursor cursor1 = PGCListGetCursorAtIndex(list, 0);
+    PGCListCursor cursor2 = PGCListGetCursorAtIndex(list, halfCount);
+    for (uint64_t i = 0; i < halfCount; i++) {
+        if (!PGCEquals(PGCListCursorNext(&cursor1), PGCListCursorNext(&cursor2))) failureCount++;
+    }
+    double cursorSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("%llu objects: compared halves by index in %.2f ms, with cursors in %.2f ms%s\n", objectCount, indexSeconds * 1e3,
+           cursorSeconds * 1e3, failureCount == 0 ? "" : " (FAILED)");
+
+    PGCRelease(list);
+    PGCAutoreleasePoolDestroy(pool);
+}
+
+
+void BenchmarkListSplicing(uint64_t objectCount, uint64_t operationCount)
+{
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+
+    PGCList *list = PGCListInitWithNodeCapacity(NULL, 32);
+    PGCInteger *object = PGCIntegerInstanceWithSignedValue(1);
+    for (uint64_t i = 0; i < objectCount; i++) PGCListAddObject(list, object);
+
+    // Partition the list at a random index and merge the pieces back together in the opposite order
+    clock_t start = clock();
+    for (uint64_t i = 0; i < operationCount; i++) {
+        PGCList *tailList = PGCListSplitAtIndex(list, random() % objectCount);
+        PGCListSpliceListAtIndex(list, tailList, 0);
+    }
+    double spliceSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("%llu objects: %.1f us per split and splice%s\n", objectCount, spliceSeconds * 1e6 / operationCount,
+           PGCListGetCount(list) == objectCount ? "" : " (FAILED)");
+
+    PGCRelease(list);
+    PGCAutoreleasePoolDestroy(pool);
+}
+
+
+void BenchmarkListRandomEditing(uint64_t objectCount, uint64_t operationCount, bool indexed)
+{
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+
+    PGCList *list = PGCListInit(NULL);
+    PGCListSetIndexed(list, indexed);
+    PGCInteger *object = PGCIntegerInstanceWithSignedValue(1);
+    for (uint64_t i = 0; i < objectCount; i++) PGCListAddObject(list, object);
+
+    // Each operation reads, removes, and inserts an object at random positions
+    clock_t start = clock();
+    for (uint64_t i = 0; i < operationCount; i++) {
+        PGCListReplaceObjectAtIndex(list, PGCListGetObjectAtIndex(list, random() % objectCount), random() % objectCount);
+        PGCListRemoveObjectAtIndex(list, random() % objectCount);
+        PGCListInsertObjectAtIndex(list, object, random() % objectCount);
+    }
+    double editSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("%s, %llu objects: %.2f us per random read, remove, and insert%s\n", indexed ? "Indexed" : "Unindexed", objectCount,
+           editSeconds * 1e6 / operationCount, PGCListGetCount(list) == objectCount ? "" : " (FAILED)");
+
+    PGCRelease(list);
+    PGCAutoreleasePoolDestroy(pool);
+}
+
+
+typedef struct _BenchmarkQueueContext {
+    PGCConcurrentQueue *queue;
+    PGCList *list;
+    pthread_mutex_t *listMutex;
+    PGCType object;
+    uint64_t objectCount;
+} BenchmarkQueueContext;
+
+
+void *BenchmarkConcurrentQueueProduce(void *argument)
+{
+    BenchmarkQueueContext *context = argument;
+    for (uint64_t i = 0; i < context->objectCount; i++) PGCConcurrentQueueEnqueueObject(context->queue, context->object);
+    return NULL;
+}
+
+
+void *BenchmarkConcurrentQueueConsume(void *argument)
+{
+    BenchmarkQueueContext *context = argument;
+    for (uint64_t i = 0; i < context->objectCount; i++) PGCRelease(PGCConcurrentQueueDequeueObject(context->queue));
+    return NULL;
+}
+
+
+void *BenchmarkLockedListProduce(void *argument)
+{
+    BenchmarkQueueContext *context = argument;
+    for (uint64_t i = 0; i < context->objectCount; i++) {
+        pthread_mutex_lock(context->listMutex);
+        PGCListAddObject(context->list, context->object);
+        pthread_mutex_unlock(context->listMutex);
+    }
+    return NULL;
+}
+
+
+void *BenchmarkLockedListConsume(void *argument)
+{
+    // Consumers poll the list, since it has no way to wait for an object
+    BenchmarkQueueContext *context = argument;
+    uint64_t dequeuedCount = 0;
+    while (dequeuedCount < context->objectCount) {
+        pthread_mutex_lock(context->listMutex);
+        if (PGCListGetCount(context->list) > 0) {
+            PGCListRemoveObjectAtIndex(context->list, 0);
+            dequeuedCount++;
+        }
+        pthread_mutex_unlock(context->listMutex);
+    }
+    return NULL;
+}
+
+
+double BenchmarkQueueThreads(void *(*produce)(void *), void *(*consume)(void *), BenchmarkQueueContext *context, uint64_t threadCount)
+{
+    pthread_t producers[threadCount];
+    pthread_t consumers[threadCount];
+    
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint64_t i = 0; i < threadCount; i++) {
+        pthread_create(&consumers[i], NULL, consume, context);
+        pthread_create(&producers[i], NULL, produce, context);
+    }
+    
+    for (uint64_t i = 0; i < threadCount; i++) {
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+
+void BenchmarkConcurrentQueue(uint64_t threadCount, uint64_t objectCount)
+{
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+
+    // Each of threadCount producers hands objectCount / threadCount objects to as many consumers
+    pthread_mutex_t listMutex = PTHREAD_MUTEX_INITIALIZER;
+    BenchmarkQueueContext context = { PGCConcurrentQueueInit(NULL), PGCListInit(NULL), &listMutex,
+                                      PGCIntegerInstanceWithSignedValue(1), objectCount / threadCount };
+    
+    double queueSeconds = BenchmarkQueueThreads(BenchmarkConcurrentQueueProduce, BenchmarkConcurrentQueueConsume, &context, threadCount);
+    double listSeconds = BenchmarkQueueThreads(BenchmarkLockedListProduce, BenchmarkLockedListConsume, &context, threadCount);
+
+    printf("%llu producers and consumers: %.1f ns per object with a concurrent queue, %.1f ns with a locked list%s\n", threadCount,
+           queueSeconds * 1e9 / objectCount, listSeconds * 1e9 / objectCount,
+           PGCConcurrentQueueGetCount(context.queue) == 0 && PGCListGetCount(context.list) == 0 ? "" : " (FAILED)");
+
+    PGCRelease(context.queue);
+    PGCRelease(context.list);
+    PGCAutoreleasePoolDestroy(pool);
+}
+
+
+void *BenchmarkAutoreleaseThread(void *argument)
+{
+    // Every thread creates its first pool at about the same time, then autoreleases in batches of 1000
+    uint64_t objectCount = *(uint64_t *)argument;
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+    PGCInteger *integer = PGCIntegerInitWithSignedValue(NULL, 1);
+    for (uint64_t i = 0; i < objectCount; i += 1000) {
+        PGCAutoreleasePool *innerPool = PGCAutoreleasePoolCreate();
+        for (uint64_t j = 0; j < 1000; j++) PGCAutorelease(PGCRetain(integer));
+        PGCAutoreleasePoolDestroy(innerPool);
+    }
+
+    PGCRelease(integer);
+    PGCAutoreleasePoolDestroy(pool);
+    return NULL;
+}
+
+
+void BenchmarkAutorelease(uint64_t threadCount, uint64_t objectCount)
+{
+    pthread_t threads[threadCount];
+    uint64_t threadObjectCount = objectCount / threadCount;
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint64_t i = 0; i < threadCount; i++) pthread_create(&threads[i], NULL, BenchmarkAutoreleaseThread, &threadObjectCount);
+    for (uint64_t i = 0; i < threadCount; i++) pthread_join(threads[i], NULL);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    printf("%llu threads: %.1f ns per autorelease\n", threadCount, seconds * 1e9 / objectCount);
+}
+
+
+void BenchmarkAutoreleasePoolDraining(uint64_t iterationCount, uint64_t objectCount)
+{
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+    PGCInteger *integer = PGCIntegerInitWithSignedValue(NULL, 1);
+
+    // Each iteration autoreleases objectCount objects into either a new pool or a drained one
+    clock_t start = clock();
+    for (uint64_t i = 0; i < iterationCount; i++) {
+        PGCAutoreleasePool *iterationPool = PGCAutoreleasePoolCreate();
+        for (uint64_t j = 0; j < objectCount; j++) PGCAutorelease(PGCRetain(integer));
+        PGCAutoreleasePoolDestroy(iterationPool);
+    }
+    double destroySeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    PGCAutoreleasePoolSetTimesDrains(true);
+    PGCAutoreleasePool *iterationPool = PGCAutoreleasePoolCreate();
+    for (uint64_t i = 0; i < iterationCount; i++) {
+        for (uint64_t j = 0; j < objectCount; j++) PGCAutorelease(PGCRetain(integer));
+        PGCAutoreleasePoolDrain(iterationPool);
+    }
+    double drainSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    PGCAutoreleasePoolStatistics statistics = PGCAutoreleasePoolGetStatistics(iterationPool);
+    PGCAutoreleasePoolDestroy(iterationPool);
+    PGCAutoreleasePoolSetTimesDrains(false);
+
+    printf("%llu objects per iteration: %.1f ns per iteration creating and destroying pools, %.1f ns draining one pool\n", 
+           objectCount, destroySeconds * 1e9 / iterationCount, drainSeconds * 1e9 / iterationCount);
+    printf("Drained pool: %llu objects autoreleased, peak of %llu, %llu drains averaging %.1f ns\n",
+           statistics.autoreleasedObjectCount, statistics.peakObjectCount, statistics.drainCount,
+           statistics.drainCount ? (double)statistics.drainNanoseconds / statistics.drainCount : 0.0);
+
+    PGCRelease(integer);
+    PGCAutoreleasePoolDestroy(pool);
+}
+
+
+double BenchmarkElapsedSeconds(struct timespec *start)
+{
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start->tv_sec) + (end.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+
+void BenchmarkDeallocation(uint64_t depth, uint64_t timeSlice)
+{
+    PGCAutoreleasePool *pool = PGCAutoreleasePoolCreate();
+
+    // Build a list of lists nested depth deep, which used to overflow the stack when released
+    PGCList *list = NULL;
+    for (uint64_t i = 0; i < depth; i++) {
+        PGCList *outerList = PGCListInit(NULL);
+        PGCListAddObject(outerList, PGCIntegerInstanceWithSignedValue(i));
+        if (list) PGCListAddObject(outerList, list);
+        PGCRelease(list);
+        list = outerList;
+        if (i % 1000 == 0) PGCAutoreleasePoolDrain(pool);
+    }
+
+    // Release the list, then finish any deallocations the time slice deferred, keeping track of the longest pause
+    PGCObjectSetDeallocationTimeSlice(timeSlice);
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    PGCRelease(list);
+    double totalSeconds = BenchmarkElapsedSeconds(&start);
+    double longestSeconds = totalSeconds;
+    uint64_t callCount = 1;
+    while (PGCObjectGetDeferredObjectCount() > 0) {
+        struct timespec callStart;
+        clock_gettime(CLOCK_MONOTONIC, &callStart);
+        PGCObjectDeallocDeferredObjects(timeSlice);
+        double callSeconds = BenchmarkElapsedSeconds(&callStart);
+        totalSeconds += callSeconds;
+        if (callSeconds > longestSeconds) longestSeconds = callSeconds;
+        callCount++;
+    }
+    PGCObjectSetDeallocationTimeSlice(0);
+
+    printf("%llu nested lists with a %.1f ms time slice: %.1f ms in %llu calls, longest %.2f ms\n", depth, timeSlice / 1e6,
+           totalSeconds * 1e3, callCount, longestSeconds * 1e3);
+
+    PGCAutoreleasePoolDestroy(pool);
 }
 
 
@@ -257,10 +2073,11 @@ void GenerateGroups(const char *filename, uint64_t groupCount)
     
     uint64_t assignedNameCount = 0;
     while (assignedNameCount < nameCount) {
+        // Move the randomly chosen name to the end of the array before popping it so that we don’t shift every name after it
         uint64_t randomIndex = random() % PGCArrayGetCount(names);        
-        PGCString *name = PGCArrayGetObjectAtIndex(names, randomIndex);
+        PGCArrayExchangeValuesAtIndices(names, randomIndex, PGCArrayGetCount(names) - 1);
+        PGCString *name = PGCArrayPopLastObject(names);
         PGCArrayAddObject(PGCArrayGetObjectAtIndex(groups, assignedNameCount % groupCount), name);
-        PGCArrayRemoveObjectAtIndex(names, randomIndex);
         ++assignedNameCount;
     }
 